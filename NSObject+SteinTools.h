@@ -10,7 +10,7 @@
 #import <Stein/STEnumerable.h>
 
 @protocol STFunction;
-@class STClosure;
+@class STClosure, STOutput;
 
 ///This category adds several collections of methods to NSObject that are used extensively by Stein.
 ///These methods include decision making control flow constructs (ifTrue/match), class extension, and printing.
@@ -21,12 +21,18 @@
 ///Returns a string that represents the contents of the receiving object that is easily readable in the context of a command prompt.
 - (NSString *)prettyDescription;
 
-///Print the receiver, using it's pretty description.
+///Write the pretty description of the receiver to a specified output.
+///
+///The default implementation writes the result of `-[NSObject prettyDescription]`. Collections
+///override this method to write the pretty descriptions of their contents straight to the output.
+- (void)writePrettyDescriptionToOutput:(STOutput *)output;
+
+///Print the receiver to standard output, using it's pretty description.
 - (NSString *)prettyPrint;
 
 #pragma mark -
 
-///Print the receiver.
+///Print the receiver to standard output.
 - (NSString *)print;
 
 #pragma mark - Extension
@@ -86,6 +92,20 @@
 ///the receiver will be placed into the new array.
 - (NSArray *)where:(NSArray *)booleans;
 
+#pragma mark - Parallel Enumeration
+
+///Returns the results of applying a pure function to each object in the receiver, computed on multiple threads.
+///The results are in the same order as the receiver's objects. Raises an exception if the function is not pure.
+- (NSArray *)pmap:(id <STFunction>)function;
+
+///Returns the objects in the receiver that a pure function returns true for, computed on multiple threads.
+///The objects remain in the same order. Raises an exception if the function is not pure.
+- (NSArray *)pfilter:(id <STFunction>)function;
+
+///Combines the objects in the receiver into a single value using a pure, associative function on multiple threads.
+///Returns nil if the receiver is empty. Raises an exception if the function is not pure.
+- (id)preduce:(id <STFunction>)function;
+
 @end
 
 ///This category makes NSSet conform to the STEnumerable protocol.
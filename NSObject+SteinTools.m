@@ -16,6 +16,10 @@
 #import "STList.h"
 #import "STClosure.h"
 #import "STSymbol.h"
+#import "STLazySequence.h"
+#import "STAppendableCollections.h"
+#import "STRope.h"
+#import "STOutput.h"
 
 @implementation NSObject (SteinTools)
 
@@ -32,13 +36,22 @@
 	return [self className];
 }
 
+- (void)writePrettyDescriptionToOutput:(STOutput *)output
+{
+	[output writeString:[self prettyDescription]];
+}
+
 #pragma mark -
 
 - (NSString *)prettyPrint
 {
 	NSString *prettyDescription = [self prettyDescription];
 	
-	puts([prettyDescription UTF8String]);
+	STOutput *output = [STOutput standardOutput];
+	[output lock];
+	[output writeString:prettyDescription];
+	[output finishLine];
+	[output unlock];
 	
 	return prettyDescription;
 }
@@ -47,7 +60,11 @@
 {
 	NSString *prettyDescription = [self prettyDescription];
 	
-	puts([prettyDescription UTF8String]);
+	STOutput *output = [STOutput standardOutput];
+	[output lock];
+	[output writeString:prettyDescription];
+	[output finishLine];
+	[output unlock];
 	
 	return prettyDescription;
 }
@@ -58,7 +75,11 @@
 {
 	NSString *description = [self description];
 	
-	puts([description UTF8String]);
+	STOutput *output = [STOutput standardOutput];
+	[output lock];
+	[output writeString:description];
+	[output finishLine];
+	[output unlock];
 	
 	return description;
 }
@@ -67,7 +88,11 @@
 {
 	NSString *description = [self description];
 	
-	puts([description UTF8String]);
+	STOutput *output = [STOutput standardOutput];
+	[output lock];
+	[output writeString:description];
+	[output finishLine];
+	[output unlock];
 	
 	return description;
 }
@@ -162,15 +187,44 @@
 
 - (NSString *)prettyDescription
 {
-	return [NSString stringWithFormat:@"\"%@\"", [self stringByReplacingOccurrencesOfString:@"\"" 
-																				 withString:@"\\\""]];
+	return [STOutput prettyDescriptionOfObject:self];
+}
+
+- (void)writePrettyDescriptionToOutput:(STOutput *)output
+{
+	[output writeString:@"\""];
+	
+	//Write the runs of characters between quotes, escaping each quote.
+	NSRange remainingRange = NSMakeRange(0, [self length]);
+	for (;;)
+	{
+		NSRange quoteRange = [self rangeOfString:@"\"" options:NSLiteralSearch range:remainingRange];
+		if(quoteRange.location == NSNotFound)
+			break;
+		
+		[output writeString:self range:NSMakeRange(remainingRange.location, quoteRange.location - remainingRange.location)];
+		[output writeString:@"\\\""];
+		
+		remainingRange = NSMakeRange(NSMaxRange(quoteRange), NSMaxRange(remainingRange) - NSMaxRange(quoteRange));
+	}
+	
+	if(remainingRange.location == 0)
+		[output writeString:self];
+	else
+		[output writeString:self range:remainingRange];
+	
+	[output writeString:@"\""];
 }
 
 #pragma mark - Operators
 
 - (NSString *)operatorAdd:(NSString *)rightOperand
 {
-	return [self stringByAppendingString:[rightOperand string]];
+	//Ropes are kept as ropes so that their contents are not flattened.
+	if([rightOperand isKindOfClass:[STRope class]])
+		return [[STRope ropeWithString:self] ropeByAppendingString:rightOperand];
+	
+	return [STAppendableString stringWithString:self byAppendingString:[rightOperand string]];
 }
 
 - (NSString *)operatorSubtract:(NSString *)rightOperand
@@ -270,6 +324,49 @@
 	return [string copy];
 }
 
+#pragma mark - Aggregation
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	return STEnumerableReduce([STLazySequence sequenceWithSource:self], function, initial);
+}
+
+- (id)sum
+{
+	return STEnumerableSum([STLazySequence sequenceWithSource:self]);
+}
+
+- (id)min
+{
+	return STEnumerableMinimum([STLazySequence sequenceWithSource:self]);
+}
+
+- (id)max
+{
+	return STEnumerableMaximum([STLazySequence sequenceWithSource:self]);
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	return STEnumerableCount([STLazySequence sequenceWithSource:self], function);
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	NSMutableDictionary *groups = [NSMutableDictionary dictionary];
+	[STEnumerableGroup([STLazySequence sequenceWithSource:self], function) enumerateKeysAndObjectsUsingBlock:^(id key, NSArray *characters, BOOL *stop) {
+		NSMutableString *string = [NSMutableString stringWithCapacity:[characters count]];
+		for (NSNumber *character in characters)
+		{
+			[string appendFormat:@"%c", [character charValue]];
+		}
+		
+		[groups setObject:[string copy] forKey:key];
+	}];
+	
+	return groups;
+}
+
 @end
 
 #pragma mark -
@@ -291,7 +388,7 @@
 
 - (NSArray *)operatorAdd:(NSArray *)rightOperand
 {
-	return [self arrayByAddingObjectsFromArray:rightOperand];
+	return [STAppendableArray arrayWithArray:self byAppendingObjectsFromArray:rightOperand];
 }
 
 - (NSArray *)operatorSubtract:(NSArray *)rightOperand
@@ -375,20 +472,56 @@
 	return [filteredObjects copy];
 }
 
+#pragma mark - Aggregation
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	return STEnumerableReduce(self, function, initial);
+}
+
+- (id)sum
+{
+	return STEnumerableSum(self);
+}
+
+- (id)min
+{
+	return STEnumerableMinimum(self);
+}
+
+- (id)max
+{
+	return STEnumerableMaximum(self);
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	return STEnumerableCount(self, function);
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	return STEnumerableGroup(self, function);
+}
+
 #pragma mark - Pretty Printing
 
 - (NSString *)prettyDescription
 {
-	NSMutableString *description = [NSMutableString stringWithString:@"(array"];
+	return [STOutput prettyDescriptionOfObject:self];
+}
+
+- (void)writePrettyDescriptionToOutput:(STOutput *)output
+{
+	[output writeString:@"(array"];
 	
 	for (id object in self)
 	{
-		[description appendFormat:@" %@", [object prettyDescription]];
+		[output writeString:@" "];
+		[object writePrettyDescriptionToOutput:output];
 	}
 	
-	[description appendString:@")"];
-	
-	return description;
+	[output writeString:@")"];
 }
 
 #pragma mark - Array Programming Support
@@ -408,6 +541,23 @@
 	return result;
 }
 
+#pragma mark - Parallel Enumeration
+
+- (NSArray *)pmap:(id <STFunction>)function
+{
+	return STEnumerableParallelMap(self, function);
+}
+
+- (NSArray *)pfilter:(id <STFunction>)function
+{
+	return STEnumerableParallelFilter(self, function);
+}
+
+- (id)preduce:(id <STFunction>)function
+{
+	return STEnumerableParallelReduce(self, function);
+}
+
 #pragma mark -
 
 - (BOOL)canHandleMissingMethodWithSelector:(SEL)selector
@@ -519,20 +669,61 @@
 	return [filteredObjects copy];
 }
 
+#pragma mark - Aggregation
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	return STEnumerableReduce(self, function, initial);
+}
+
+- (id)sum
+{
+	return STEnumerableSum(self);
+}
+
+- (id)min
+{
+	return STEnumerableMinimum(self);
+}
+
+- (id)max
+{
+	return STEnumerableMaximum(self);
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	return STEnumerableCount(self, function);
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	NSMutableDictionary *groups = [NSMutableDictionary dictionary];
+	[STEnumerableGroup(self, function) enumerateKeysAndObjectsUsingBlock:^(id key, NSArray *objects, BOOL *stop) {
+		[groups setObject:[NSSet setWithArray:objects] forKey:key];
+	}];
+	
+	return groups;
+}
+
 #pragma mark - Pretty Printing
 
 - (NSString *)prettyDescription
 {
-	NSMutableString *description = [NSMutableString stringWithString:@"(set"];
+	return [STOutput prettyDescriptionOfObject:self];
+}
+
+- (void)writePrettyDescriptionToOutput:(STOutput *)output
+{
+	[output writeString:@"(set"];
 	
 	for (id object in self)
 	{
-		[description appendFormat:@" %@", [object prettyDescription]];
+		[output writeString:@" "];
+		[object writePrettyDescriptionToOutput:output];
 	}
 	
-	[description appendString:@")"];
-	
-	return description;
+	[output writeString:@")"];
 }
 
 @end
@@ -612,18 +803,74 @@
 	return [indexSet copy];
 }
 
+#pragma mark - Aggregation
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	return STEnumerableReduce([STLazySequence sequenceWithSource:self], function, initial);
+}
+
+- (id)sum
+{
+	__block double sum = 0.0;
+	[self enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+		sum += index;
+	}];
+	
+	return [NSNumber numberWithDouble:sum];
+}
+
+- (id)min
+{
+	NSUInteger firstIndex = [self firstIndex];
+	return (firstIndex != NSNotFound)? [NSNumber numberWithUnsignedInteger:firstIndex] : nil;
+}
+
+- (id)max
+{
+	NSUInteger lastIndex = [self lastIndex];
+	return (lastIndex != NSNotFound)? [NSNumber numberWithUnsignedInteger:lastIndex] : nil;
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	return STEnumerableCount([STLazySequence sequenceWithSource:self], function);
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	NSMutableDictionary *groups = [NSMutableDictionary dictionary];
+	[STEnumerableGroup([STLazySequence sequenceWithSource:self], function) enumerateKeysAndObjectsUsingBlock:^(id key, NSArray *indexes, BOOL *stop) {
+		NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
+		for (NSNumber *index in indexes)
+		{
+			[indexSet addIndex:[index unsignedIntegerValue]];
+		}
+		
+		[groups setObject:[indexSet copy] forKey:key];
+	}];
+	
+	return groups;
+}
+
 #pragma mark - Pretty Printing
 
 - (NSString *)prettyDescription
 {
-	NSMutableString *description = [NSMutableString stringWithString:@"(index-set"];
+	return [STOutput prettyDescriptionOfObject:self];
+}
+
+- (void)writePrettyDescriptionToOutput:(STOutput *)output
+{
+	[output writeString:@"(index-set"];
 	
 	[self enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
-		[description appendFormat:@" %ld", index];
+		char indexString[32];
+		int indexLength = snprintf(indexString, sizeof(indexString), " %lu", (unsigned long)index);
+		[output writeBytes:indexString length:indexLength];
 	}];
 	
-	[description appendString:@")"];
-	return description;
+	[output writeString:@")"];
 }
 
 @end
@@ -726,19 +973,127 @@
 	return [result copy];
 }
 
+#pragma mark - Aggregation
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	NSParameterAssert(function);
+	NSParameterAssert(initial);
+	
+	__block id result = initial;
+	[self enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+		@try
+		{
+			result = STFunctionApply(function, [[STList alloc] initWithArray:[NSArray arrayWithObjects:result, key, value, nil]]);
+		}
+		@catch (STBreakException *e)
+		{
+			*stop = YES;
+			return;
+		}
+		@catch (STContinueException *e)
+		{
+			return;
+		}
+	}];
+	
+	return result;
+}
+
+- (id)sum
+{
+	return STEnumerableSum([self objectEnumerator]);
+}
+
+- (id)min
+{
+	return STEnumerableMinimum([self objectEnumerator]);
+}
+
+- (id)max
+{
+	return STEnumerableMaximum([self objectEnumerator]);
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	NSParameterAssert(function);
+	
+	__block NSUInteger count = 0;
+	[self enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+		@try
+		{
+			if(STIsTrue(STFunctionApply(function, [[STList alloc] initWithArray:[NSArray arrayWithObjects:key, value, nil]])))
+				count++;
+		}
+		@catch (STBreakException *e)
+		{
+			*stop = YES;
+			return;
+		}
+		@catch (STContinueException *e)
+		{
+			return;
+		}
+	}];
+	
+	return count;
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	NSParameterAssert(function);
+	
+	NSMutableDictionary *groups = [NSMutableDictionary dictionary];
+	[self enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+		@try
+		{
+			id groupKey = STFunctionApply(function, [[STList alloc] initWithArray:[NSArray arrayWithObjects:key, value, nil]]);
+			if(!groupKey)
+				return;
+			
+			NSMutableDictionary *group = [groups objectForKey:groupKey];
+			if(!group)
+			{
+				group = [NSMutableDictionary dictionary];
+				[groups setObject:group forKey:groupKey];
+			}
+			
+			[group setObject:value forKey:key];
+		}
+		@catch (STBreakException *e)
+		{
+			*stop = YES;
+			return;
+		}
+		@catch (STContinueException *e)
+		{
+			return;
+		}
+	}];
+	
+	return groups;
+}
+
 #pragma mark - Pretty Printing
 
 - (NSString *)prettyDescription
 {
-	NSMutableString *description = [NSMutableString stringWithString:@"(dictionary"];
+	return [STOutput prettyDescriptionOfObject:self];
+}
+
+- (void)writePrettyDescriptionToOutput:(STOutput *)output
+{
+	[output writeString:@"(dictionary"];
 	
 	[self enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
-		[description appendFormat:@" %@ %@", [key prettyDescription], [value prettyDescription]];
+		[output writeString:@" "];
+		[key writePrettyDescriptionToOutput:output];
+		[output writeString:@" "];
+		[value writePrettyDescriptionToOutput:output];
 	}];
 	
-	[description appendString:@")"];
-	
-	return description;
+	[output writeString:@")"];
 }
 
 @end
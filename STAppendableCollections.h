@@ -0,0 +1,52 @@
+//
+//  STAppendableCollections.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class STAppendableArrayStorage, STAppendableStringStorage;
+
+///The STAppendableArray class is an immutable array that can be extended in amortized constant time.
+///
+///An appendable array is a view of the beginning of a storage buffer that it may share with other
+///appendable arrays. The view never changes, but when an array ends at the end of its storage and the
+///buffer has room, appending objects to it writes them past the end of every existing view and yields
+///a longer view of the same buffer. Otherwise the objects are copied into a new buffer with room to grow.
+///Buffers are never reallocated and the objects in a view are never replaced, so appending is never
+///visible through an existing array, and arrays are read and enumerated without locking.
+///
+///Appendable arrays are produced by the `+` operator on arrays, which makes
+///accumulating an array with `(set! array (array + more))` linear rather than quadratic.
+@interface STAppendableArray : NSArray
+{
+	STAppendableArrayStorage *mStorage;
+	NSUInteger mCount;
+}
+
+///Returns an array containing the objects of one array followed by the objects of another,
+///extending the storage of the first array in place if it is an appendable array that permits it.
++ (NSArray *)arrayWithArray:(NSArray *)array byAppendingObjectsFromArray:(NSArray *)otherArray;
+
+@end
+
+#pragma mark -
+
+///The STAppendableString class is an immutable string that can be extended in amortized constant time.
+///
+///Appendable strings share their storage in the same manner as STAppendableArray, and are
+///produced by the `+` operator on strings.
+@interface STAppendableString : NSString
+{
+	STAppendableStringStorage *mStorage;
+	NSUInteger mLength;
+}
+
+///Returns a string containing one string followed by another, extending the storage
+///of the first string in place if it is an appendable string that permits it.
++ (NSString *)stringWithString:(NSString *)string byAppendingString:(NSString *)otherString;
+
+@end
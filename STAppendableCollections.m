@@ -0,0 +1,303 @@
+//
+//  STAppendableCollections.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STAppendableCollections.h"
+
+///The smallest number of elements a new storage buffer has room for.
+#define MINIMUM_CAPACITY	16
+
+#pragma mark Storage
+
+///The STAppendableArrayStorage class is the fixed capacity buffer shared by appendable arrays.
+///
+///Objects are only ever written past the end of the buffer's filled slots, so the
+///slots seen by an existing array never change and are read without locking.
+@interface STAppendableArrayStorage : NSObject
+{
+@public
+	CFTypeRef *mObjects;
+	NSUInteger mCount;
+	NSUInteger mCapacity;
+}
+
+///Initialize the receiver as an empty buffer with room for a specified number of objects.
+- (id)initWithCapacity:(NSUInteger)capacity;
+
+///Appends the objects of an array to the receiver if its filled slots end at a specified index
+///and it has room for them. Returns YES if the objects were appended; NO otherwise.
+- (BOOL)appendObjectsFromArray:(NSArray *)array atIndex:(NSUInteger)index;
+
+@end
+
+@implementation STAppendableArrayStorage
+
+- (void)dealloc
+{
+	for (NSUInteger index = 0; index < mCount; index++)
+		CFRelease(mObjects[index]);
+	
+	free(mObjects);
+}
+
+- (id)initWithCapacity:(NSUInteger)capacity
+{
+	if((self = [super init]))
+	{
+		mCapacity = MAX(capacity, MINIMUM_CAPACITY);
+		mObjects = malloc(sizeof(CFTypeRef) * mCapacity);
+		NSAssert(mObjects != NULL, @"Could not allocate storage for %lu objects.", (unsigned long)mCapacity);
+	}
+	
+	return self;
+}
+
+- (BOOL)appendObjectsFromArray:(NSArray *)array atIndex:(NSUInteger)index
+{
+	NSUInteger count = [array count];
+	
+	//Appending arrays are serialized so only one of the arrays ending at `index` may claim the slots after it.
+	@synchronized(self)
+	{
+		if(mCount != index || count > mCapacity - mCount)
+			return NO;
+		
+		[array getObjects:(__unsafe_unretained id *)(mObjects + mCount) range:NSMakeRange(0, count)];
+		for (NSUInteger offset = 0; offset < count; offset++)
+			CFRetain(mObjects[mCount + offset]);
+		
+		mCount += count;
+	}
+	
+	return YES;
+}
+
+@end
+
+#pragma mark -
+
+///The STAppendableStringStorage class is the fixed capacity buffer shared by appendable strings.
+///
+///Characters are only ever written past the end of the buffer's filled characters, so the
+///characters seen by an existing string never change and are read without locking.
+@interface STAppendableStringStorage : NSObject
+{
+@public
+	unichar *mCharacters;
+	NSUInteger mLength;
+	NSUInteger mCapacity;
+}
+
+///Initialize the receiver as an empty buffer with room for a specified number of characters.
+- (id)initWithCapacity:(NSUInteger)capacity;
+
+///Appends the characters of a string to the receiver if its filled characters end at a specified
+///index and it has room for them. Returns YES if the characters were appended; NO otherwise.
+- (BOOL)appendString:(NSString *)string atIndex:(NSUInteger)index;
+
+@end
+
+@implementation STAppendableStringStorage
+
+- (void)dealloc
+{
+	free(mCharacters);
+}
+
+- (id)initWithCapacity:(NSUInteger)capacity
+{
+	if((self = [super init]))
+	{
+		mCapacity = MAX(capacity, MINIMUM_CAPACITY);
+		mCharacters = malloc(sizeof(unichar) * mCapacity);
+		NSAssert(mCharacters != NULL, @"Could not allocate storage for %lu characters.", (unsigned long)mCapacity);
+	}
+	
+	return self;
+}
+
+- (BOOL)appendString:(NSString *)string atIndex:(NSUInteger)index
+{
+	NSUInteger length = [string length];
+	
+	@synchronized(self)
+	{
+		if(mLength != index || length > mCapacity - mLength)
+			return NO;
+		
+		[string getCharacters:mCharacters + mLength range:NSMakeRange(0, length)];
+		mLength += length;
+	}
+	
+	return YES;
+}
+
+@end
+
+#pragma mark -
+
+@interface STAppendableArray ()
+
+///Initialize the receiver as a view of the first `count` objects of a specified storage buffer.
+- (id)initWithStorage:(STAppendableArrayStorage *)storage count:(NSUInteger)count;
+
+@end
+
+@implementation STAppendableArray
+
++ (NSArray *)arrayWithArray:(NSArray *)array byAppendingObjectsFromArray:(NSArray *)otherArray
+{
+	NSParameterAssert(array);
+	NSParameterAssert(otherArray);
+	
+	NSUInteger otherCount = [otherArray count];
+	if([array isKindOfClass:[STAppendableArray class]])
+	{
+		//Only the array that ends where its storage does may extend it.
+		STAppendableArray *appendableArray = (STAppendableArray *)array;
+		if([appendableArray->mStorage appendObjectsFromArray:otherArray atIndex:appendableArray->mCount])
+			return [[STAppendableArray alloc] initWithStorage:appendableArray->mStorage count:appendableArray->mCount + otherCount];
+	}
+	
+	//New buffers have room for as many objects again, so that repeated appends are amortized.
+	NSUInteger count = [array count];
+	STAppendableArrayStorage *storage = [[STAppendableArrayStorage alloc] initWithCapacity:(count + otherCount) * 2];
+	[storage appendObjectsFromArray:array atIndex:0];
+	[storage appendObjectsFromArray:otherArray atIndex:count];
+	return [[STAppendableArray alloc] initWithStorage:storage count:count + otherCount];
+}
+
+- (id)initWithStorage:(STAppendableArrayStorage *)storage count:(NSUInteger)count
+{
+	NSParameterAssert(storage);
+	
+	if((self = [super init]))
+	{
+		mStorage = storage;
+		mCount = count;
+	}
+	
+	return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	return self;
+}
+
+#pragma mark - Primitive Methods
+
+- (NSUInteger)count
+{
+	return mCount;
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+	if(index >= mCount)
+		[NSException raise:NSRangeException format:@"Index %lu is beyond bounds %lu.", (unsigned long)index, (unsigned long)mCount];
+	
+	return (__bridge id)mStorage->mObjects[index];
+}
+
+- (void)getObjects:(__unsafe_unretained id [])objects range:(NSRange)range
+{
+	if(NSMaxRange(range) > mCount)
+		[NSException raise:NSRangeException format:@"Range %@ is beyond bounds %lu.", NSStringFromRange(range), (unsigned long)mCount];
+	
+	memcpy(objects, mStorage->mObjects + range.location, sizeof(CFTypeRef) * range.length);
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)len
+{
+	//The receiver's objects never change, so they are enumerated straight out of the storage in a single batch.
+	if(state->state != 0)
+		return 0;
+	
+	state->state = 1;
+	state->itemsPtr = (__unsafe_unretained id *)mStorage->mObjects;
+	state->mutationsPtr = &state->extra[0];
+	
+	return mCount;
+}
+
+@end
+
+#pragma mark -
+
+@interface STAppendableString ()
+
+///Initialize the receiver as a view of the first `length` characters of a specified storage buffer.
+- (id)initWithStorage:(STAppendableStringStorage *)storage length:(NSUInteger)length;
+
+@end
+
+@implementation STAppendableString
+
++ (NSString *)stringWithString:(NSString *)string byAppendingString:(NSString *)otherString
+{
+	NSParameterAssert(string);
+	NSParameterAssert(otherString);
+	
+	NSUInteger otherLength = [otherString length];
+	if([string isKindOfClass:[STAppendableString class]])
+	{
+		//Only the string that ends where its storage does may extend it.
+		STAppendableString *appendableString = (STAppendableString *)string;
+		if([appendableString->mStorage appendString:otherString atIndex:appendableString->mLength])
+			return [[STAppendableString alloc] initWithStorage:appendableString->mStorage length:appendableString->mLength + otherLength];
+	}
+	
+	NSUInteger length = [string length];
+	STAppendableStringStorage *storage = [[STAppendableStringStorage alloc] initWithCapacity:(length + otherLength) * 2];
+	[storage appendString:string atIndex:0];
+	[storage appendString:otherString atIndex:length];
+	return [[STAppendableString alloc] initWithStorage:storage length:length + otherLength];
+}
+
+- (id)initWithStorage:(STAppendableStringStorage *)storage length:(NSUInteger)length
+{
+	NSParameterAssert(storage);
+	
+	if((self = [super init]))
+	{
+		mStorage = storage;
+		mLength = length;
+	}
+	
+	return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	return self;
+}
+
+#pragma mark - Primitive Methods
+
+- (NSUInteger)length
+{
+	return mLength;
+}
+
+- (unichar)characterAtIndex:(NSUInteger)index
+{
+	if(index >= mLength)
+		[NSException raise:NSRangeException format:@"Index %lu is beyond bounds %lu.", (unsigned long)index, (unsigned long)mLength];
+	
+	return mStorage->mCharacters[index];
+}
+
+- (void)getCharacters:(unichar *)buffer range:(NSRange)range
+{
+	if(NSMaxRange(range) > mLength)
+		[NSException raise:NSRangeException format:@"Range %@ is beyond bounds %lu.", NSStringFromRange(range), (unsigned long)mLength];
+	
+	memcpy(buffer, mStorage->mCharacters + range.location, sizeof(unichar) * range.length);
+}
+
+@end
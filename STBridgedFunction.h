@@ -16,6 +16,7 @@
 {
 	STFunctionInvocation *mInvocation;
 	NSString *mFunctionName;
+	BOOL mBorrowsReturnedPointers;
 }
 #pragma mark Initialization
 
@@ -38,4 +39,10 @@
 ///The name of the function this bridged-function object represents.
 @property (copy) NSString *functionName;
 
+///Whether or not pointers returned by the function are views of the memory they point to, rather than copies of the value.
+///
+///Borrowed pointers may be given a length with `-[STPointer arrayPointerOfCount:]`, but
+///are only valid for as long as the native code keeps the memory they point to alive.
+@property BOOL borrowsReturnedPointers;
+
 @end
@@ -10,6 +10,7 @@
 #import "STFunctionInvocation.h"
 #import "STTypeBridge.h"
 #import "STList.h"
+#import "STOutput.h"
 #import <dlfcn.h>
 
 @implementation STBridgedFunction
@@ -57,6 +58,7 @@
 #pragma mark - Properties
 
 @synthesize functionName = mFunctionName;
+@synthesize borrowsReturnedPointers = mBorrowsReturnedPointers;
 
 #pragma mark - STFunction
 
@@ -76,7 +78,9 @@
 	NSAssert(([arguments count] == [functionSignature numberOfArguments]), 
 			 @"Wrong number of arguments given to %@. Expected %ld, got %ld", self, [functionSignature numberOfArguments], [arguments count]);
 	
-	for (NSUInteger index = 0; index < [functionSignature numberOfArguments]; index++)
+	NSUInteger numberOfArguments = [functionSignature numberOfArguments];
+	void *buffers[MAX(numberOfArguments, 1)];
+	for (NSUInteger index = 0; index < numberOfArguments; index++)
 	{
 		const char *argumentSignature = [functionSignature getArgumentTypeAtIndex:index];
 		
@@ -86,10 +90,22 @@
 		STTypeBridgeConvertObjectIntoType([arguments objectAtIndex:index], argumentSignature, buffer);
 		
 		[mInvocation setArgument:buffer atIndex:index];
+		buffers[index] = buffer;
 	}
 	
+	//Native functions may print through stdio, so anything buffered so far is written out first.
+	[STOutput flushStandardOutputs];
+	
 	[mInvocation apply];
 	
+	//Mutable arrays passed as C arrays are updated if the function changed them.
+	for (NSUInteger index = 0; index < numberOfArguments; index++)
+	{
+		id argument = [arguments objectAtIndex:index];
+		if([argument isKindOfClass:[NSMutableArray class]])
+			STTypeBridgeCopyConvertedValuesIntoArray(buffers[index], [functionSignature getArgumentTypeAtIndex:index], argument);
+	}
+	
 	//If it returns void, it should be nil
 	if([functionSignature methodReturnType][0] == 'v')
 		return STNull;
@@ -97,6 +113,9 @@
 	void *returnValue = NULL;
 	[mInvocation getReturnValue:&returnValue];
 	
+	if(mBorrowsReturnedPointers)
+		return STTypeBridgeConvertValueOfTypeIntoObjectBorrowingPointers(returnValue, [functionSignature methodReturnType]);
+	
 	return STTypeBridgeConvertValueOfTypeIntoObject(returnValue, [functionSignature methodReturnType]);
 }
 
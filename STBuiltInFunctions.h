@@ -12,3 +12,11 @@
 
 ///To create a Stein scope that contains all of the core functions required for Stein to be useful.
 ST_EXTERN STScope *STBuiltInFunctionScope();
+
+///Returns whether or not a specified object is one of the native functions provided by `STBuiltInFunctionScope`.
+ST_EXTERN BOOL STIsBuiltInFunction(id object);
+
+///Returns whether or not a specified object is one of the native functions that create immutable collections,
+///such as `array` and `dictionary`. Forms applying these functions to literals yield equal values every time they
+///are evaluated, and so the interpreter only evaluates them once.
+ST_EXTERN BOOL STIsLiteralCollectionFunction(id object);
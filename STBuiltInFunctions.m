@@ -18,15 +18,27 @@
 #import "STStructClasses.h"
 #import "STPointer.h"
 #import <dlfcn.h>
+#import <fcntl.h>
+#import <unistd.h>
 #import <objc/message.h>
 
 #import "STParser.h"
 #import "STList.h"
+#import "STVector.h"
+#import "STHashMap.h"
+#import "STLazySequence.h"
+#import "STRope.h"
+#import "STFileSequence.h"
+#import "STJSON.h"
+#import "STSerialization.h"
+#import "STOutput.h"
 #import "STSymbol.h"
 
 #import "STInterpreter.h"
 #import "STScope.h"
 #import "STModule.h"
+#import "STMemoizedFunction.h"
+#import "STMacro.h"
 
 #import "STLibraryLoader.h"
 #import "STFrameworkLoader.h"
@@ -46,14 +58,24 @@ typedef id(*STBuiltInFunctionImplementation)(STList *arguments, STScope *scope);
 {
 	STBuiltInFunctionImplementation mImplementation;
 	BOOL mEvaluatesOwnArguments;
+	BOOL mIsPure;
 }
 
 #pragma mark Initialization
 
+//-
+//	method		initWithImplementation:evaluatesOwnArguments:isPure:
+//	intention	To initialize the receiver with a specified implementation, whether or not \
+//				the implementation intends on evaluating its own arguments, and whether or not \
+//				the implementation is free of side effects.
+//-
+- (id)initWithImplementation:(STBuiltInFunctionImplementation)implementation evaluatesOwnArguments:(BOOL)evaluatesOwnArguments isPure:(BOOL)isPure;
+
 //-
 //	method		initWithImplementation:evaluatesOwnArguments:
 //	intention	To initialize the receiver with a specified implementation \
-//				and whether or not the implementation intends on evaluating its own arguments.
+//				and whether or not the implementation intends on evaluating its own arguments. \
+//				The receiver is considered impure.
 //-
 - (id)initWithImplementation:(STBuiltInFunctionImplementation)implementation evaluatesOwnArguments:(BOOL)evaluatesOwnArguments;
 
@@ -66,6 +88,14 @@ typedef id(*STBuiltInFunctionImplementation)(STList *arguments, STScope *scope);
 //-
 @property (readonly, nonatomic) STBuiltInFunctionImplementation implementation;
 
+//-
+//	property	isPure
+//	description	Whether or not the STBuiltInFunction is free of side effects, and yields \
+//				results that depend only on its arguments. This corresponds to the absence \
+//				of the `impure` marker in a function's description below.
+//-
+@property (readonly, nonatomic) BOOL isPure;
+
 @end
 
 #pragma mark -
@@ -74,7 +104,7 @@ typedef id(*STBuiltInFunctionImplementation)(STList *arguments, STScope *scope);
 
 #pragma mark Initialization
 
-- (id)initWithImplementation:(STBuiltInFunctionImplementation)implementation evaluatesOwnArguments:(BOOL)evaluatesOwnArguments
+- (id)initWithImplementation:(STBuiltInFunctionImplementation)implementation evaluatesOwnArguments:(BOOL)evaluatesOwnArguments isPure:(BOOL)isPure
 {
 	NSParameterAssert(implementation);
 	
@@ -82,15 +112,22 @@ typedef id(*STBuiltInFunctionImplementation)(STList *arguments, STScope *scope);
 	{
 		mImplementation = implementation;
 		mEvaluatesOwnArguments = evaluatesOwnArguments;
+		mIsPure = isPure;
 	}
 	
 	return self;
 }
 
+- (id)initWithImplementation:(STBuiltInFunctionImplementation)implementation evaluatesOwnArguments:(BOOL)evaluatesOwnArguments
+{
+	return [self initWithImplementation:implementation evaluatesOwnArguments:evaluatesOwnArguments isPure:NO];
+}
+
 #pragma mark - Properties
 
 @synthesize evaluatesOwnArguments = mEvaluatesOwnArguments;
 @synthesize implementation = mImplementation;
+@synthesize isPure = mIsPure;
 
 - (STScope *)superscope
 {
@@ -223,6 +260,7 @@ static id unsetBang(STList *arguments, STScope *scope)
 //-
 //	function	load
 //	intention	To load all given paths.
+//	impure
 //	forms {
 //		(path...) -> id \
 //			If the path is a directory, it is treated like a bundle and loaded with NSBundle, \
@@ -262,6 +300,7 @@ static id load(STList *arguments, STScope *scope)
 //-
 //	function	super
 //	intention	To allow access to an object's superclass's methods.
+//	impure
 //	forms {
 //		(super |Message|) -> id
 //	}
@@ -302,6 +341,7 @@ static id _super(STList *message, STScope *scope)
 //-
 //  function    autoreleasepool
 //  intention   To encapsulate an area of code in a autorelease pool.
+//  impure
 //  forms {
 //      (autoreleasepool {function}) -> id
 //  }
@@ -322,6 +362,7 @@ static id autoreleasepool(STList *arguments, STScope *scope)
 //-
 //	function	parse
 //	intention	To parse a string into an AST
+//	impure
 //	forms {
 //		(string) -> NSArray \
 //			Parses string into an NSArray of STLists, STSymbols NSNumbers, and NSStrings.
@@ -377,11 +418,181 @@ static id apply(STList *arguments, STScope *scope)
 	return [function applyWithArguments:parameters inScope:scope];
 }
 
+#pragma mark - • Macros
+
+//-
+//	function	defmacro
+//	intention	To define functions that rewrite the forms they are used in before those forms are evaluated.
+//	impure
+//	forms {
+//		(name { |parameters...| body }) -> STMacro \
+//			Create a readonly binding from `name` to a macro, yielding the macro. When a form whose head is `name`
+//			is first evaluated, the body is applied to the form's unevaluated arguments, and the expression it yields
+//			is cached on the form and evaluated in its place. The form is never expanded again.
+//	}
+//-
+static id defmacro(STList *arguments, STScope *scope)
+{
+	if(arguments.count != 2)
+		STRaiseIssue(arguments.creationLocation, @"defmacro requires exactly 2 parameters (name {|parameters...| body}), got %ld.", arguments.count);
+	
+	id nameSymbol = [arguments objectAtIndex:0];
+	if(![nameSymbol isKindOfClass:[STSymbol class]])
+		STRaiseIssue(arguments.creationLocation, @"Wrong type given for defmacro's `name`, got %@, expected STSymbol.", [nameSymbol className]);
+	
+	NSObject <STFunction> *transformer = STEvaluate([arguments objectAtIndex:1], scope);
+	if(![transformer conformsToProtocol:@protocol(STFunction)] || [transformer evaluatesOwnArguments])
+		STRaiseIssue(arguments.creationLocation, @"defmacro's body must be a function, got %@.", [transformer className]);
+	
+	NSString *name = [nameSymbol string];
+	STMacro *macro = [[STMacro alloc] initWithName:name transformer:transformer];
+	[scope setValue:macro forConstantNamed:name];
+	
+	return macro;
+}
+
+//-
+//	function	quasiquote
+//	intention	To build expressions from templates.
+//	impure
+//	forms {
+//		(template) -> id \
+//			Yields a copy of the quoted `template` where every `(unquote expression)` form is replaced with the
+//			value of `expression`, and every `(unquote-splicing expression)` form is replaced with the contents
+//			of the list `expression` evaluates to.
+//	}
+//-
+static id quasiquote(STList *arguments, STScope *scope)
+{
+	if(arguments.count != 1)
+		STRaiseIssue(arguments.creationLocation, @"quasiquote requires exactly one parameter (template).");
+	
+	return STQuasiquote([arguments head], scope);
+}
+
+//-
+//	function	macroexpand
+//	intention	To find the expression a form naming a macro will be evaluated as.
+//	impure
+//	forms {
+//		(form) -> id \
+//			Expands the quoted `form` if its head names a macro, yielding the expansion. Otherwise yields `form`.
+//	}
+//-
+static id macroexpand(STList *arguments, STScope *scope)
+{
+	if(arguments.count != 1)
+		STRaiseIssue(arguments.creationLocation, @"macroexpand requires exactly one parameter (form).");
+	
+	STList *form = [arguments head];
+	if(![form isKindOfClass:[STList class]] || form.count == 0)
+		return form;
+	
+	id head = [form head];
+	id macro = [head isKindOfClass:[STSymbol class]]? [scope valueForVariableNamed:[head string] searchParentScopes:YES] : nil;
+	if(![macro isKindOfClass:[STMacro class]])
+		return form;
+	
+	return [macro expansionOfForm:form inScope:scope];
+}
+
+//-
+//	function	macro-statistics
+//	intention	To describe how often macros have been expanded.
+//	impure
+//	forms {
+//		() -> NSDictionary \
+//			Yields a dictionary containing the number of `expansions` performed by all macros, and the
+//			number of evaluations that reused a `cached-expansions`.
+//		(macro) -> NSDictionary \
+//			Yields the same statistics for a single `macro`.
+//	}
+//-
+static id macro_statistics(STList *arguments, STScope *scope)
+{
+	if(arguments.count == 0 || (arguments.count == 1 && [arguments head] == STNull))
+		return STMacroExpansionStatistics();
+	
+	STMacro *macro = [arguments head];
+	if(arguments.count != 1 || ![macro isKindOfClass:[STMacro class]])
+		STRaiseIssue(arguments.creationLocation, @"macro-statistics takes at most one parameter (macro).");
+	
+	return [NSDictionary dictionaryWithObjectsAndKeys:
+			[NSNumber numberWithUnsignedInteger:macro.expansionCount], @"expansions",
+			[NSNumber numberWithUnsignedInteger:macro.cachedExpansionCount], @"cached-expansions",
+			nil];
+}
+
+#pragma mark - • Memoization
+
+//-
+//	function	memoize
+//	intention	To cache the results of a function by its arguments.
+//	impure
+//	forms {
+//		(function) -> STMemoizedFunction \
+//			Wraps `function` so that it is only applied once for each distinct list of arguments, keeping the 1024 most recently used results.
+//		(function capacity) -> STMemoizedFunction \
+//			Wraps `function`, keeping at most `capacity` of its most recently used results.
+//		(function capacity thread-safe) -> STMemoizedFunction \
+//			Wraps `function`, keeping at most `capacity` results, guarding the cache against concurrent use if `thread-safe` is true.
+//	}
+//-
+static id memoize(STList *arguments, STScope *scope)
+{
+	if(arguments.count < 1 || arguments.count > 3)
+		STRaiseIssue(arguments.creationLocation, @"memoize requires 1 to 3 parameters (function [capacity [thread-safe]]), got %ld", arguments.count);
+	
+	id <STFunction> function = [arguments objectAtIndex:0];
+	if(![function conformsToProtocol:@protocol(STFunction)])
+		STRaiseIssue(arguments.creationLocation, @"Wrong type given for memoize's `function`, got %@, expected STFunction.", [function className]);
+	
+	if([function evaluatesOwnArguments])
+		STRaiseIssue(arguments.creationLocation, @"memoize cannot cache functions that evaluate their own arguments.");
+	
+	NSUInteger capacity = kSTMemoizationCacheDefaultCapacity;
+	if(arguments.count > 1)
+	{
+		NSInteger requestedCapacity = [[arguments objectAtIndex:1] integerValue];
+		if(requestedCapacity <= 0)
+			STRaiseIssue(arguments.creationLocation, @"memoize's `capacity` must be greater than zero, got %ld", requestedCapacity);
+		
+		capacity = requestedCapacity;
+	}
+	
+	BOOL isThreadSafe = (arguments.count > 2 && STIsTrue([arguments objectAtIndex:2]));
+	
+	STMemoizationCache *cache = [[STMemoizationCache alloc] initWithCapacity:capacity threadSafe:isThreadSafe];
+	return [[STMemoizedFunction alloc] initWithFunction:(NSObject <STFunction> *)function cache:cache];
+}
+
+//-
+//	function	memoize-statistics
+//	intention	To describe how effectively a memoized function's cache is being used.
+//	impure
+//	forms {
+//		(memoized-function) -> NSDictionary \
+//			Yields a dictionary containing the `hits`, `misses`, `evictions`, `count`, and `capacity` of the function's cache.
+//	}
+//-
+static id memoize_statistics(STList *arguments, STScope *scope)
+{
+	if(arguments.count != 1)
+		STRaiseIssue(arguments.creationLocation, @"memoize-statistics requires exactly one parameter (memoized-function).");
+	
+	STMemoizedFunction *function = [arguments head];
+	if(![function isKindOfClass:[STMemoizedFunction class]])
+		STRaiseIssue(arguments.creationLocation, @"Wrong type given for memoize-statistics's `memoized-function`, got %@, expected STMemoizedFunction.", [function className]);
+	
+	return function.cache.statistics;
+}
+
 #pragma mark - • Control Flow
 
 //-
 //	function	break
 //	intention	To raise a break exception.
+//	impure
 //-
 static id _break(STList *arguments, STScope *scope)
 {
@@ -392,6 +603,7 @@ static id _break(STList *arguments, STScope *scope)
 //-
 //	function	continue
 //	intention	To raise a continue exception.
+//	impure
 //-
 static id _continue(STList *arguments, STScope *scope)
 {
@@ -404,6 +616,7 @@ static id _continue(STList *arguments, STScope *scope)
 //-
 //	function	decide
 //	intention	To provide basic control flow for Stein.
+//	impure
 //	forms {
 //		(condition, true-block) -> id \
 //			Evaluates condition and calls true-block if condition is true. \
@@ -452,6 +665,7 @@ static id decide(STList *arguments, STScope *scope)
 //	function	match
 //	intention	To match a specified value against a list of values, \
 //				evaluating a specified block based on the result.
+//	impure
 //	forms {
 //		(left-operand { right-operand	expression|{ expressions... }... } -> id
 //	}
@@ -893,6 +1107,9 @@ static id not(STList *arguments, STScope *scope)
 //			Looks up the native constant specified by `symbol-name`, and if found, its value will be treated as `type`.
 //		(type symbol-name(parameter-type...)) -> STBridgedFunction \
 //			Looks up the native function specified by `symbol-name`, and if found, it will be wrapped into an STBridgedFunction instance whose return type is `type` and whose parameter types are `parameter-type...`.
+//		
+//		Pointers are copied into new STPointers unless `type` is written with a leading `&` in place of `^`, in which
+//		case they are borrowed as views of the memory they point to.
 //	}
 //-
 static id _extern(STList *arguments, STScope *scope)
@@ -900,7 +1117,12 @@ static id _extern(STList *arguments, STScope *scope)
 	if(arguments.count < 2)
 		STRaiseIssue(arguments.creationLocation, @"extern requires at least 2 parameters (type symbol) or (type symbol(type...)).");
 	
-	NSString *symbolType = STTypeBridgeGetObjCTypeForHumanReadableType([[arguments objectAtIndex:0] string]);
+	NSString *humanReadableType = [[arguments objectAtIndex:0] string];
+	BOOL borrowsPointers = [humanReadableType hasPrefix:@"&"];
+	if(borrowsPointers)
+		humanReadableType = [@"^" stringByAppendingString:[humanReadableType substringFromIndex:1]];
+	
+	NSString *symbolType = STTypeBridgeGetObjCTypeForHumanReadableType(humanReadableType);
 	NSString *symbolName = [[arguments objectAtIndex:1] string];
 	
 	id result = STNull;
@@ -909,7 +1131,10 @@ static id _extern(STList *arguments, STScope *scope)
 		void *value = dlsym(RTLD_DEFAULT, [symbolName UTF8String]);
 		NSCAssert((value != NULL), @"Could not find constant named %@.", symbolName);
 		
-		result = STTypeBridgeConvertValueOfTypeIntoObject(value, [symbolType UTF8String]);
+		if(borrowsPointers)
+			result = STTypeBridgeConvertValueOfTypeIntoObjectBorrowingPointers(value, [symbolType UTF8String]);
+		else
+			result = STTypeBridgeConvertValueOfTypeIntoObject(value, [symbolType UTF8String]);
 	}
 	else if(arguments.count == 3)
 	{
@@ -917,8 +1142,10 @@ static id _extern(STList *arguments, STScope *scope)
 		for (STSymbol *type in [arguments objectAtIndex:2])
 			[signature appendString:STTypeBridgeGetObjCTypeForHumanReadableType([type string])];
 		
-		result = [[STBridgedFunction alloc] initWithSymbolNamed:symbolName 
-													  signature:[NSMethodSignature signatureWithObjCTypes:[signature UTF8String]]];
+		STBridgedFunction *function = [[STBridgedFunction alloc] initWithSymbolNamed:symbolName
+																		   signature:[NSMethodSignature signatureWithObjCTypes:[signature UTF8String]]];
+		function.borrowsReturnedPointers = borrowsPointers;
+		result = function;
 	}
 	
 	[scope setValue:result forConstantNamed:symbolName];
@@ -931,6 +1158,7 @@ static id _extern(STList *arguments, STScope *scope)
 //-
 //	function	ref
 //	intention	To return a pointer of a specified type for a specified value.
+//	impure
 //	forms {
 //		(type, value) -> STPointer \
 //			Creates an STPointer whose `value` is of `type`.
@@ -952,6 +1180,7 @@ static id ref(STList *arguments, STScope *scope)
 //-
 //	function	ref-array
 //	intention	To create a pointer array of a specified type and length.
+//	impure
 //	forms {
 //		(type length) -> STPointer \
 //			Creates an STArrayPointer of `type` and of `length`.
@@ -973,6 +1202,7 @@ static id ref_array(STList *arguments, STScope *scope)
 //-
 //	function	to-native-function
 //	intention	To wrap Stein function's into native function wrappers that can be used as C function-pointers.
+//	impure
 //-
 static id to_native_function(STList *arguments, STScope *scope)
 {
@@ -994,6 +1224,7 @@ static id to_native_function(STList *arguments, STScope *scope)
 //-
 //	function	array
 //	intention	To create instances of NSArray
+//	impure
 //	forms {
 //		(null) -> NSArray \
 //			Creates an empty array
@@ -1013,6 +1244,7 @@ static id array(STList *arguments, STScope *scope)
 //-
 //	function	list
 //	intention	To create instances of STList
+//	impure
 //	forms {
 //		(null) -> STList \
 //			Creates an empty list
@@ -1029,13 +1261,34 @@ static id list(STList *arguments, STScope *scope)
 	return [arguments copy];
 }
 
+//-
+//	function	vector
+//	intention	To create instances of STVector
+//	impure
+//	forms {
+//		(null) -> STVector \
+//			Creates an empty vector
+//		(value...) -> STVector \
+//			Creates a vector with the specified `value[s]...`
+//	}
+//-
+static id vector(STList *arguments, STScope *scope)
+{
+	//Special case for `vector ()`
+	if(arguments.count == 1 && [arguments head] == STNull)
+		return [STVector vector];
+	
+	return [STVector vectorWithObjectsFromCollection:arguments];
+}
+
 //-
 //	function	dictionary
-//	intention	To create instances of NSDictionary
+//	intention	To create instances of STHashMap
+//	impure
 //	forms {
-//		(null) -> NSDictionary \
+//		(null) -> STHashMap \
 //			Creates an empty dictionary
-//		(key value...) -> NSDictionary \
+//		(key value...) -> STHashMap \
 //			Creates a dictionary with the specified `key value[s]...`
 //	}
 //-
@@ -1043,9 +1296,9 @@ static id dictionary(STList *arguments, STScope *scope)
 {
 	//Special case for `dictionary ()`
 	if(arguments.count == 1 && [arguments head] == STNull)
-		return [NSDictionary dictionary];
+		return [STHashMap map];
 	
-	NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+	STHashMap *dictionary = [STHashMap map];
 	
 	id key = nil;
 	for (id argument in arguments)
@@ -1057,22 +1310,23 @@ static id dictionary(STList *arguments, STScope *scope)
 		else
 		{
 			if(argument != STNull)
-				[dictionary setObject:argument forKey:key];
+				dictionary = [dictionary mapBySettingObject:argument forKey:key];
 			
 			key = nil;
 		}
 	}
 	
-	return [dictionary copy];
+	return dictionary;
 }
 
 //-
 //	function	set
-//	intention	To create instances of NSMutableSet
+//	intention	To create instances of STHashSet
+//	impure
 //	forms {
-//		(null) -> NSSet \
+//		(null) -> STHashSet \
 //			Creates an empty set
-//		(value...) -> NSSet \
+//		(value...) -> STHashSet \
 //			Creates a set with the specified `value[s]...`
 //	}
 //-
@@ -1080,14 +1334,15 @@ static id set(STList *arguments, STScope *scope)
 {
 	//Special case for `set ()`
 	if(arguments.count == 1 && [arguments head] == STNull)
-		return [NSSet set];
+		return [STHashSet hashSet];
 	
-	return [NSSet setWithArray:arguments.allObjects];
+	return [STHashSet hashSetWithObjectsFromCollection:arguments];
 }
 
 //-
 //	function	index-set
 //	intention	To create instances of NSIndexSet
+//	impure
 //	forms {
 //		(null) -> NSIndexSet \
 //			Creates an empty index set
@@ -1099,7 +1354,7 @@ static id index_set(STList *arguments, STScope *scope)
 {
 	//Special case for `index-set ()`
 	if(arguments.count == 1 && [arguments head] == STNull)
-		return [NSMutableDictionary dictionary];
+		return [NSIndexSet indexSet];
 	
 	NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
 	for (id argument in arguments)
@@ -1110,12 +1365,245 @@ static id index_set(STList *arguments, STScope *scope)
 	return [indexSet copy];
 }
 
+//-
+//	function	lazy
+//	intention	To create instances of STLazySequence
+//	impure
+//	forms {
+//		(collection) -> STLazySequence \
+//			Creates a lazy sequence over the contents of `collection`. The `map:`, `filter:`, `take:`,
+//			`drop:`, and `takeWhile:` stages of the sequence are performed in a single pass when it is enumerated.
+//	}
+//-
+static id lazy(STList *arguments, STScope *scope)
+{
+	if(arguments.count != 1)
+		STRaiseIssue(arguments.creationLocation, @"lazy requires exactly 1 parameter (collection).");
+	
+	return [STLazySequence sequenceWithSource:[arguments head]];
+}
+
+//-
+//	function	rope
+//	intention	To create instances of STRope
+//	impure
+//	forms {
+//		() -> STRope \
+//			Creates an empty rope.
+//		(values...) -> STRope \
+//			Creates a rope containing the descriptions of `values` one after the other. Ropes are
+//			concatenated with `+` without copying their contents, and are written out piece by piece.
+//	}
+//-
+static id rope(STList *arguments, STScope *scope)
+{
+	STRope *rope = [STRope rope];
+	if(arguments.count == 1 && [arguments head] == STNull)
+		return rope;
+	
+	for (id argument in arguments)
+	{
+		rope = [rope ropeByAppendingString:[argument description]];
+	}
+	
+	return rope;
+}
+
+//-
+//	function	open-lines
+//	intention	To create instances of STFileSequence that yield lines
+//	impure
+//	forms {
+//		(path) -> STFileSequence \
+//			Creates a sequence over the lines of the UTF-8 file at `path`, without their line terminators. \
+//			The file is read a block at a time as the sequence is enumerated, and is closed when it has \
+//			been read to its end or when a `foreach:` over it breaks.
+//	}
+//-
+static id open_lines(STList *arguments, STScope *scope)
+{
+	if(arguments.count != 1)
+		STRaiseIssue(arguments.creationLocation, @"open-lines requires exactly 1 parameter (path).");
+	
+	NSString *path = [[arguments head] description];
+	if(![[NSFileManager defaultManager] fileExistsAtPath:path])
+		STRaiseIssue(arguments.creationLocation, @"Could not open file at path %@, it does not exist.", path);
+	
+	return [STFileSequence linesOfFileAtPath:path];
+}
+
+//-
+//	function	open-chunks
+//	intention	To create instances of STFileSequence that yield chunks of data
+//	impure
+//	forms {
+//		(path) -> STFileSequence \
+//			Creates a sequence over the contents of the file at `path` in 64 kilobyte chunks.
+//		(path size) -> STFileSequence \
+//			Creates a sequence over the contents of the file at `path` in chunks of `size` bytes. \
+//			The last chunk of the file may be shorter than the rest.
+//	}
+//-
+static id open_chunks(STList *arguments, STScope *scope)
+{
+	if(arguments.count < 1 || arguments.count > 2)
+		STRaiseIssue(arguments.creationLocation, @"open-chunks requires 1 or 2 parameters (path [size]), got %ld.", arguments.count);
+	
+	NSString *path = [[arguments head] description];
+	if(![[NSFileManager defaultManager] fileExistsAtPath:path])
+		STRaiseIssue(arguments.creationLocation, @"Could not open file at path %@, it does not exist.", path);
+	
+	NSUInteger chunkSize = 65536;
+	if(arguments.count == 2)
+	{
+		NSInteger requestedChunkSize = [[arguments objectAtIndex:1] integerValue];
+		if(requestedChunkSize <= 0)
+			STRaiseIssue(arguments.creationLocation, @"open-chunks requires a positive chunk size, got %ld.", requestedChunkSize);
+		
+		chunkSize = requestedChunkSize;
+	}
+	
+	return [STFileSequence chunksOfFileAtPath:path size:chunkSize];
+}
+
+//-
+//	function	read-json
+//	intention	To create instances of STJSONSequence
+//	impure
+//	forms {
+//		(path) -> STJSONSequence \
+//			Creates a sequence over the values of the JSON file at `path`. If the file contains an array, \
+//			each element of the array is yielded as it is parsed. Otherwise each top-level value is yielded.
+//	}
+//-
+static id read_json(STList *arguments, STScope *scope)
+{
+	if(arguments.count != 1)
+		STRaiseIssue(arguments.creationLocation, @"read-json requires exactly 1 parameter (path).");
+	
+	NSString *path = [[arguments head] description];
+	if(![[NSFileManager defaultManager] fileExistsAtPath:path])
+		STRaiseIssue(arguments.creationLocation, @"Could not open file at path %@, it does not exist.", path);
+	
+	return [STJSONSequence sequenceWithContentsOfFileAtPath:path];
+}
+
+//-
+//	function	write-json
+//	intention	To write values as JSON
+//	impure
+//	forms {
+//		(value) -> value \
+//			Writes `value` to standard output as JSON, followed by a newline.
+//		(value path) -> value \
+//			Writes `value` as JSON to the file at `path`, replacing its contents. Sequences are \
+//			written one element at a time, so a sequence read with `read-json` is never held in memory.
+//	}
+//-
+static id write_json(STList *arguments, STScope *scope)
+{
+	if(arguments.count < 1 || arguments.count > 2)
+		STRaiseIssue(arguments.creationLocation, @"write-json requires 1 or 2 parameters (value [path]), got %ld.", arguments.count);
+	
+	id value = [arguments head];
+	if(arguments.count == 1)
+	{
+		STOutput *output = [STOutput standardOutput];
+		[output lock];
+		STJSONWriteObject(value, output);
+		[output finishLine];
+		[output unlock];
+		
+		return value;
+	}
+	
+	NSString *path = [[arguments objectAtIndex:1] description];
+	int fileDescriptor = open([path fileSystemRepresentation], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(fileDescriptor == -1)
+		STRaiseIssue(arguments.creationLocation, @"Could not write file at path %@. Got error «%s».", path, strerror(errno));
+	
+	@try
+	{
+		STOutput *output = [[STOutput alloc] initWithFileDescriptor:fileDescriptor];
+		STJSONWriteObject(value, output);
+		[output flush];
+	}
+	@finally
+	{
+		close(fileDescriptor);
+	}
+	
+	return value;
+}
+
+//-
+//	function	serialize
+//	intention	To write values in Stein's compact binary format
+//	impure
+//	forms {
+//		(value) -> NSData \
+//			Returns `value` serialized into a data object.
+//		(value path) -> value \
+//			Serializes `value` into the file at `path`, replacing its contents. The file is \
+//			written as the value is serialized.
+//	}
+//-
+static id serialize(STList *arguments, STScope *scope)
+{
+	if(arguments.count < 1 || arguments.count > 2)
+		STRaiseIssue(arguments.creationLocation, @"serialize requires 1 or 2 parameters (value [path]), got %ld.", arguments.count);
+	
+	id value = [arguments head];
+	if(arguments.count == 1)
+		return STSerializeObject(value);
+	
+	NSString *path = [[arguments objectAtIndex:1] description];
+	NSError *error = nil;
+	if(!STSerializeObjectToFileAtPath(value, path, &error))
+		STRaiseIssue(arguments.creationLocation, @"Could not serialize value to file at path %@. Got error «%@».", path, [error localizedDescription]);
+	
+	return value;
+}
+
+//-
+//	function	deserialize
+//	intention	To read values in Stein's compact binary format
+//	impure
+//	forms {
+//		(data) -> value \
+//			Returns the value serialized in `data`.
+//		(path) -> value \
+//			Returns the value serialized in the file at `path`. The file is read as the value is deserialized.
+//	}
+//-
+static id deserialize(STList *arguments, STScope *scope)
+{
+	if(arguments.count != 1)
+		STRaiseIssue(arguments.creationLocation, @"deserialize requires exactly 1 parameter (data or path).");
+	
+	id source = [arguments head];
+	if([source isKindOfClass:[NSData class]])
+		return STDeserializeData(source);
+	
+	NSString *path = [source description];
+	NSError *error = nil;
+	id value = STDeserializeFileAtPath(path, &error);
+	if(!value)
+		STRaiseIssue(arguments.creationLocation, @"Could not deserialize file at path %@. Got error «%@».", path, [error localizedDescription]);
+	
+	return value;
+}
+
 //-
 //	function	range
 //	intention	To create instances of STRange
+//	impure
 //	forms {
 //		(location length) -> STRange \
 //			Creates a range with a specified `location` and `length`.
+//		(location length step) -> STRange \
+//			Creates a range with a specified `location` and `length` that is enumerated
+//			by `step`. Negative steps enumerate the range in reverse.
 //	}
 //-
 static id range(STList *arguments, STScope *scope)
@@ -1123,12 +1611,39 @@ static id range(STList *arguments, STScope *scope)
 	if(arguments.count < 2)
 		STRaiseIssue(arguments.creationLocation, @"range requires 2 parameters (location, length).");
 	
-	return [[STRange alloc] initWithRange:NSMakeRange([[arguments objectAtIndex:0] unsignedIntegerValue], 
-													  [[arguments objectAtIndex:1] unsignedIntegerValue])];
+	NSInteger step = 1;
+	if(arguments.count > 2)
+	{
+		step = [[arguments objectAtIndex:2] integerValue];
+		if(step == 0)
+			STRaiseIssue(arguments.creationLocation, @"range cannot have a step of 0.");
+	}
+	
+	return [[STRange alloc] initWithLocation:[[arguments objectAtIndex:0] unsignedIntegerValue] 
+									  length:[[arguments objectAtIndex:1] unsignedIntegerValue] 
+										step:step];
 }
 
 #pragma mark - Public Interface
 
+BOOL STIsBuiltInFunction(id object)
+{
+	return [object isKindOfClass:[STBuiltInFunction class]];
+}
+
+BOOL STIsLiteralCollectionFunction(id object)
+{
+	if(![object isKindOfClass:[STBuiltInFunction class]])
+		return NO;
+	
+	STBuiltInFunctionImplementation implementation = [(STBuiltInFunction *)object implementation];
+	return (implementation == &array || 
+			implementation == &vector || 
+			implementation == &dictionary || 
+			implementation == &set || 
+			implementation == &index_set);
+}
+
 STScope *STBuiltInFunctionScope()
 {
 	STScope *functionScope = [STScope new];
@@ -1166,6 +1681,26 @@ STScope *STBuiltInFunctionScope()
                                                         evaluatesOwnArguments:NO]
 		   forConstantNamed:@"apply"];
 	
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&defmacro
+                                                        evaluatesOwnArguments:YES]
+		   forConstantNamed:@"defmacro"];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&quasiquote
+                                                        evaluatesOwnArguments:NO]
+		   forConstantNamed:@"quasiquote"];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&macroexpand
+                                                        evaluatesOwnArguments:NO]
+		   forConstantNamed:@"macroexpand"];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&macro_statistics
+                                                        evaluatesOwnArguments:NO]
+		   forConstantNamed:@"macro-statistics"];
+	
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&memoize
+                                                        evaluatesOwnArguments:NO]
+		   forConstantNamed:@"memoize"];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&memoize_statistics
+                                                        evaluatesOwnArguments:NO]
+		   forConstantNamed:@"memoize-statistics"];
+	
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&_break
                                                         evaluatesOwnArguments:NO]
 		   forConstantNamed:@"break"];
@@ -1196,63 +1731,77 @@ STScope *STBuiltInFunctionScope()
     
 	//Mathematics
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&plus
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"+" 
 		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&minus
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"-" 
 		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&multiply
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"*" 
 		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&divide
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"/" 
 		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&power
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"^"
 		 searchParentScopes:NO];
 	
 	//Comparison
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&equal
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"=" 
 		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&notEqual
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"≠" 
 		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&lessThan
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"<" 
 		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&lessThanOrEqual
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"≤" 
 		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&greaterThan
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@">" 
 		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&greaterThanOrEqual
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"≥" 
 		 searchParentScopes:NO];
 	
 	//Logical
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&or
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"or" 
 		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&and
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"and" 
 		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&not
-                                                        evaluatesOwnArguments:NO]
+                                                        evaluatesOwnArguments:NO
+                                                                       isPure:YES]
 		   forVariableNamed:@"not" 
 		 searchParentScopes:NO];
 	
@@ -1283,6 +1832,10 @@ STScope *STBuiltInFunctionScope()
                                                         evaluatesOwnArguments:NO]
 		   forVariableNamed:@"list" 
 		 searchParentScopes:NO];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&vector
+                                                        evaluatesOwnArguments:NO]
+		   forVariableNamed:@"vector" 
+		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&dictionary
                                                         evaluatesOwnArguments:NO]
 		   forVariableNamed:@"dictionary" 
@@ -1295,6 +1848,38 @@ STScope *STBuiltInFunctionScope()
                                                         evaluatesOwnArguments:NO]
 		   forVariableNamed:@"index-set" 
 		 searchParentScopes:NO];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&lazy
+                                                        evaluatesOwnArguments:NO]
+		   forVariableNamed:@"lazy" 
+		 searchParentScopes:NO];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&rope
+                                                        evaluatesOwnArguments:NO]
+		   forVariableNamed:@"rope" 
+		 searchParentScopes:NO];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&open_lines
+                                                        evaluatesOwnArguments:NO]
+		   forVariableNamed:@"open-lines" 
+		 searchParentScopes:NO];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&open_chunks
+                                                        evaluatesOwnArguments:NO]
+		   forVariableNamed:@"open-chunks" 
+		 searchParentScopes:NO];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&read_json
+                                                        evaluatesOwnArguments:NO]
+		   forVariableNamed:@"read-json" 
+		 searchParentScopes:NO];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&write_json
+                                                        evaluatesOwnArguments:NO]
+		   forVariableNamed:@"write-json" 
+		 searchParentScopes:NO];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&serialize
+                                                        evaluatesOwnArguments:NO]
+		   forVariableNamed:@"serialize" 
+		 searchParentScopes:NO];
+	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&deserialize
+                                                        evaluatesOwnArguments:NO]
+		   forVariableNamed:@"deserialize" 
+		 searchParentScopes:NO];
 	[functionScope setValue:[[STBuiltInFunction alloc] initWithImplementation:&range
                                                         evaluatesOwnArguments:NO]
 		   forVariableNamed:@"range" 
@@ -9,7 +9,7 @@
 #import <Foundation/Foundation.h>
 #import <Stein/STFunction.h>
 
-@class STList, STScope;
+@class STList, STScope, STMemoizationCache;
 
 ///The STClosure class is responsible for representing closures and functions in Stein.
 @interface STClosure : NSObject <STFunction>
@@ -21,6 +21,11 @@
 	//Closure Description
 	STList *mPrototype;
 	STList *mImplementation;
+	
+	//Purity
+	NSInteger mPurity;
+	BOOL mIsRecursive;
+	STMemoizationCache *mMemoizedResults;
 }
 
 ///Initialize a Stein closure with a prototype, implementation, and a signature describing it's prototype.
@@ -33,6 +38,16 @@
 ///This is the designated initializer of STClosure.
 - (id)initWithPrototype:(STList *)prototype forImplementation:(STList *)implementation inScope:(STScope *)superscope;
 
+///Initialize a Stein closure that only retains the variables it uses from its enclosing scopes.
+///
+/// \param		prototype		The prototype of the closure in the form of an STList of symbols. May not be nil.
+/// \param		implementation	The implementation of the closure in the form of an STList of Stein expressions. May not be nil.
+/// \param		freeVariables	The names of the variables the closure uses from its enclosing scopes, as returned
+///								by `STClosureFindFreeVariables`. If nil, the closure retains the entire scope chain.
+/// \param		superscope		The scope that encloses the closure being created.
+/// \result		A fully initialized Stein closure object ready for use.
+- (id)initWithPrototype:(STList *)prototype forImplementation:(STList *)implementation capturingVariables:(NSSet *)freeVariables fromScope:(STScope *)superscope;
+
 #pragma mark - Properties
 
 ///The superscope of the closure.
@@ -57,6 +72,21 @@
 ///An STList of expressions describing the closure's implementation.
 @property (readonly) STList *implementation;
 
+#pragma mark - Purity
+
+///Whether or not the closure is free of side effects, and yields results that depend only on its arguments.
+///
+///A closure is considered pure when it only calls pure functions (including itself), does not
+///assign variables outside of its own scope, and only reads its parameters, its own `let`
+///bindings, and pure functions. This property is computed the first time it is requested.
+///
+///When `STMemoizePureRecursiveClosures` is YES, the results of pure closures
+///that call themselves are cached by their arguments, keeping at most
+///`kSTMemoizationCacheDefaultCapacity` of the most recently used results.
+///Only immutable results, such as numbers, strings, and symbols, are cached,
+///as cached results are returned to every caller.
+@property (readonly) BOOL isPure;
+
 #pragma mark - Exception Handling
 
 ///Invoke the receiver in the context of a try..catch block, invoking a specified block if an exception occurs.
@@ -66,3 +96,25 @@
 - (BOOL)onException:(STClosure *)closure;
 
 @end
+
+#pragma mark - Closure Conversion
+
+///Returns the names of the variables a closure with a specified prototype and implementation uses from its enclosing scopes.
+///
+/// \param		prototype		The prototype of the closure. May not be nil.
+/// \param		implementation	The implementation of the closure. May not be nil.
+/// \result		A set of variable names, or nil if the closure requires access to its entire scope chain.
+///
+///The implementation is searched in order, so a variable that is read before the implementation binds it
+///with `let` is still included. Closures that use `eval`, `load`, `unset!`, `$_here`, or that define classes
+///cannot have their free variables determined ahead of time.
+ST_EXTERN NSSet *STClosureFindFreeVariables(STList *prototype, STList *implementation);
+
+///Returns whether or not a closure with a specified prototype and implementation is pure.
+///
+/// \param		prototype		The prototype of the closure. May not be nil.
+/// \param		implementation	The implementation of the closure. May not be nil.
+/// \param		isNamePure		A block that returns whether or not a variable the closure reads
+///								from its enclosing scopes refers to a pure function or constant.
+/// \result		YES if the closure is pure; NO otherwise.
+ST_EXTERN BOOL STClosureImplementationIsPure(STList *prototype, STList *implementation, BOOL(^isNamePure)(NSString *name));
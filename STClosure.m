@@ -9,6 +9,30 @@
 #import "STClosure.h"
 #import "STList.h"
 #import "STInterpreter.h"
+#import "STSymbol.h"
+#import "STStringWithCode.h"
+#import "STMemoizedFunction.h"
+
+///The states of a closure's purity.
+enum {
+	kPurityUnknown = 0,
+	kPurityComputing,
+	kPurityPure,
+	kPurityImpure,
+};
+
+///Returns whether or not a result can be shared between callers without being copied.
+static BOOL IsImmutableResult(id result)
+{
+	if(!result)
+		return NO;
+	
+	if(result == STNull || [result isKindOfClass:[NSNumber class]] || [result isKindOfClass:[STSymbol class]])
+		return YES;
+	
+	//Copying an immutable string returns the same string.
+	return ([result isKindOfClass:[NSString class]] && [result copy] == result);
+}
 
 @implementation STClosure
 
@@ -36,6 +60,14 @@
 	return nil;
 }
 
+- (id)initWithPrototype:(STList *)prototype forImplementation:(STList *)implementation capturingVariables:(NSSet *)freeVariables fromScope:(STScope *)superscope
+{
+	if(freeVariables && superscope)
+		superscope = [superscope scopeByCapturingVariablesNamed:freeVariables];
+	
+	return [self initWithPrototype:prototype forImplementation:implementation inScope:superscope];
+}
+
 #pragma mark - Stein Function
 
 - (BOOL)evaluatesOwnArguments
@@ -44,6 +76,33 @@
 }
 
 - (id)applyWithArguments:(STList *)arguments inScope:(STScope *)superscope
+{
+	//Only named closures can call themselves, so anonymous closures are never analyzed.
+	if(STMemoizePureRecursiveClosures && mName && mPrototype.count > 0 && self.isPure && mIsRecursive)
+	{
+		@synchronized(self)
+		{
+			if(!mMemoizedResults)
+				mMemoizedResults = [[STMemoizationCache alloc] initWithCapacity:kSTMemoizationCacheDefaultCapacity threadSafe:YES];
+		}
+		
+		NSArray *argumentObjects = arguments.allObjects;
+		id result = [mMemoizedResults resultForArguments:argumentObjects];
+		if(!result)
+		{
+			result = [self evaluateWithArguments:arguments inScope:superscope];
+			if(IsImmutableResult(result))
+				[mMemoizedResults setResult:result forArguments:argumentObjects];
+		}
+		
+		return result;
+	}
+	
+	return [self evaluateWithArguments:arguments inScope:superscope];
+}
+
+///Evaluates the receiver's implementation with a specified list of arguments.
+- (id)evaluateWithArguments:(STList *)arguments inScope:(STScope *)superscope
 {
 	STScope *scope = [STScope scopeWithParentScope:superscope];
 	NSUInteger index = 0;
@@ -84,6 +143,52 @@
 @synthesize prototype = mPrototype;
 @synthesize implementation = mImplementation;
 
+#pragma mark - Purity
+
+- (BOOL)isPure
+{
+	@synchronized(self)
+	{
+		if(mPurity == kPurityPure)
+			return YES;
+		else if(mPurity != kPurityUnknown)
+			return NO;
+		
+		//Methods depend on their receivers, and closures without
+		//a scope have nothing to resolve the functions they call in.
+		if(mSuperclass || !mSuperscope)
+		{
+			mPurity = kPurityImpure;
+			return NO;
+		}
+		
+		mPurity = kPurityComputing;
+	}
+	
+	__block BOOL isRecursive = NO;
+	BOOL isPure = STClosureImplementationIsPure(mPrototype, mImplementation, ^BOOL(NSString *name) {
+		id value = [mSuperscope valueForVariableNamed:name searchParentScopes:YES];
+		if(value == self)
+		{
+			isRecursive = YES;
+			return YES;
+		}
+		
+		if(value == STTrue || value == STFalse)
+			return YES;
+		
+		return ([value respondsToSelector:@selector(isPure)] && [value isPure]);
+	});
+	
+	@synchronized(self)
+	{
+		mIsRecursive = isRecursive;
+		mPurity = isPure? kPurityPure : kPurityImpure;
+	}
+	
+	return isPure;
+}
+
 #pragma mark - Identity
 
 - (BOOL)isEqualTo:(id)object
@@ -124,3 +229,331 @@
 }
 
 @end
+
+#pragma mark - Closure Conversion
+
+///Returns the variable name referenced by a symbol, stripping any key-path components.
+static NSString *VariableNameForSymbol(STSymbol *symbol)
+{
+	NSString *name = symbol.string;
+	NSRange rangeOfDot = [name rangeOfString:@"."];
+	if(rangeOfDot.location != NSNotFound && rangeOfDot.location > 0)
+		return [name substringToIndex:rangeOfDot.location];
+	
+	return name;
+}
+
+///Returns whether or not an expression is a `let` expression.
+static BOOL IsLetExpression(id expression)
+{
+	if(![expression isKindOfClass:[STList class]] || [expression count] < 3 ||
+	   ST_FLAG_IS_SET([expression flags], kSTListFlagIsQuoted) || ST_FLAG_IS_SET([expression flags], kSTListFlagIsDefinition))
+		return NO;
+	
+	id head = [expression head];
+	return ([head isKindOfClass:[STSymbol class]] && ![head isQuoted] && [[head string] isEqualToString:@"let"]);
+}
+
+///Returns whether or not a `let` expression is of the form `let name = value`.
+static BOOL IsLetBindingExpression(STList *list)
+{
+	id directive = [list objectAtIndex:2];
+	return ([directive isKindOfClass:[STSymbol class]] && [[directive string] isEqualToString:@"="]);
+}
+
+///Collects the variables an expression reads from its enclosing scopes.
+///
+/// \param		expression			The expression to search.
+/// \param		references			On return, contains the names of variables read or written by the expression
+///									that are not in `bindings`. These are resolved when the expression is evaluated.
+/// \param		deferredReferences	On return, contains the free variables of the closures the expression creates.
+///									These are resolved when the closures are created, and may be bound later.
+/// \param		bindings			The names of the variables bound before the expression is evaluated.
+/// \result		NO if the expression requires access to its entire scope chain; YES otherwise.
+///
+///`let` expressions nested within an expression may not be evaluated, so
+///the names they bind are not treated as bound by the expressions after them.
+static BOOL FindVariables(id expression, NSMutableSet *references, NSMutableSet *deferredReferences, NSSet *bindings)
+{
+	if([expression isKindOfClass:[STSymbol class]])
+	{
+		if([expression isQuoted])
+			return YES;
+		
+		NSString *name = VariableNameForSymbol(expression);
+		if([name hasSuffix:@":"])
+			return YES;
+		
+		if([name isEqualToString:@"$_here"] || [name isEqualToString:@"eval"] || 
+		   [name isEqualToString:@"load"] || [name isEqualToString:@"unset!"])
+			return NO;
+		
+		//`super` looks up the receiver and its superclass in the calling scope.
+		if([name isEqualToString:@"super"])
+		{
+			if(![bindings containsObject:@"self"])
+				[references addObject:@"self"];
+			
+			if(![bindings containsObject:kSTSuperclassVariableName])
+				[references addObject:kSTSuperclassVariableName];
+		}
+		
+		if(![bindings containsObject:name])
+			[references addObject:name];
+	}
+	else if([expression isKindOfClass:[STStringWithCode class]])
+	{
+		for (id subexpression in [expression expressions])
+		{
+			if(!FindVariables(subexpression, references, deferredReferences, bindings))
+				return NO;
+		}
+	}
+	else if([expression isKindOfClass:[STList class]])
+	{
+		STList *list = expression;
+		if(ST_FLAG_IS_SET(list.flags, kSTListFlagIsDefinition))
+		{
+			NSSet *freeVariables = STClosureFindFreeVariables([STList new], list);
+			if(!freeVariables)
+				return NO;
+			
+			[deferredReferences unionSet:freeVariables];
+			return YES;
+		}
+		
+		if(ST_FLAG_IS_SET(list.flags, kSTListFlagIsQuoted) || list.count == 0)
+			return YES;
+		
+		NSUInteger index = 0;
+		if(IsLetExpression(list))
+		{
+			//Only `let name = value` is understood, class definitions are left to the full scope chain.
+			if(!IsLetBindingExpression(list))
+				return NO;
+			
+			index = 3;
+		}
+		
+		for (NSUInteger count = list.count; index < count; index++)
+		{
+			if(!FindVariables([list objectAtIndex:index], references, deferredReferences, bindings))
+				return NO;
+		}
+	}
+	
+	return YES;
+}
+
+NSSet *STClosureFindFreeVariables(STList *prototype, STList *implementation)
+{
+	NSCParameterAssert(prototype);
+	NSCParameterAssert(implementation);
+	
+	NSMutableSet *references = [NSMutableSet set];
+	NSMutableSet *deferredReferences = [NSMutableSet set];
+	NSMutableSet *bindings = [NSMutableSet setWithObject:@"$_arguments"];
+	
+	NSUInteger index = 0;
+	id head = [implementation head];
+	if([head isKindOfClass:[STList class]] && ST_FLAG_IS_SET([head flags], kSTListFlagIsDefinitionParameters))
+	{
+		for (id parameter in head)
+			[bindings addObject:[parameter string]];
+		
+		index = 1;
+	}
+	
+	for (id parameter in prototype)
+		[bindings addObject:[parameter string]];
+	
+	//Statements are searched in order, so a variable that is read before the body binds it is still captured.
+	for (NSUInteger count = implementation.count; index < count; index++)
+	{
+		id statement = [implementation objectAtIndex:index];
+		if(IsLetExpression(statement) && IsLetBindingExpression(statement))
+		{
+			for (NSUInteger valueIndex = 3, statementCount = [statement count]; valueIndex < statementCount; valueIndex++)
+			{
+				if(!FindVariables([statement objectAtIndex:valueIndex], references, deferredReferences, bindings))
+					return nil;
+			}
+			
+			[bindings addObject:[[statement objectAtIndex:1] string]];
+		}
+		else if(!FindVariables(statement, references, deferredReferences, bindings))
+		{
+			return nil;
+		}
+	}
+	
+	//Closures created before a variable is bound reserve it in the frame that creates
+	//them, so the variables bound by the body are not captured for them.
+	[deferredReferences minusSet:bindings];
+	[references unionSet:deferredReferences];
+	
+	return references;
+}
+
+#pragma mark - Purity
+
+///Returns whether or not an expression is an unquoted symbol with a specified name.
+static BOOL IsSymbolNamed(id expression, NSString *name)
+{
+	return ([expression isKindOfClass:[STSymbol class]] && ![expression isQuoted] && [[expression string] isEqualToString:name]);
+}
+
+///Returns whether or not an expression is the label of an arithmetic operator message.
+static BOOL IsOperatorLabel(id expression)
+{
+	if(![expression isKindOfClass:[STSymbol class]] || [expression isQuoted])
+		return NO;
+	
+	NSString *name = [expression string];
+	return (name.length == 1 && [@"+-*/^" rangeOfString:name].location != NSNotFound);
+}
+
+///Collects the names bound by `let` in an expression, ignoring nested closures.
+static void CollectLocalBindings(id expression, NSMutableSet *locals)
+{
+	if(![expression isKindOfClass:[STList class]] || ST_FLAG_IS_SET([expression flags], kSTListFlagIsQuoted))
+		return;
+	
+	STList *list = expression;
+	if(list.count >= 2 && IsSymbolNamed([list head], @"let"))
+		[locals addObject:[[list objectAtIndex:1] string]];
+	
+	for (id subexpression in list)
+		CollectLocalBindings(subexpression, locals);
+}
+
+///Returns whether or not an expression can be evaluated without side effects.
+static BOOL IsPureExpression(id expression, NSSet *locals, BOOL(^isNamePure)(NSString *name))
+{
+	if([expression isKindOfClass:[NSNumber class]] || [expression isKindOfClass:[NSString class]])
+	{
+		return YES;
+	}
+	else if([expression isKindOfClass:[STStringWithCode class]])
+	{
+		return IsPureExpression([expression expressions], locals, isNamePure);
+	}
+	else if([expression isKindOfClass:[NSArray class]])
+	{
+		for (id subexpression in expression)
+		{
+			if(!IsPureExpression(subexpression, locals, isNamePure))
+				return NO;
+		}
+		
+		return YES;
+	}
+	else if([expression isKindOfClass:[STSymbol class]])
+	{
+		if([expression isQuoted])
+			return YES;
+		
+		NSString *name = [expression string];
+		if([name rangeOfString:@"."].location != NSNotFound)
+			return NO;
+		
+		return ([locals containsObject:name] || isNamePure(name));
+	}
+	else if([expression isKindOfClass:[STList class]])
+	{
+		STList *list = expression;
+		if(ST_FLAG_IS_SET(list.flags, kSTListFlagIsDefinition))
+			return NO;
+		
+		if(ST_FLAG_IS_SET(list.flags, kSTListFlagIsQuoted) || list.count == 0)
+			return YES;
+		
+		NSArray *elements = list.allObjects;
+		id head = [elements objectAtIndex:0];
+		if(elements.count == 1)
+			return IsPureExpression(head, locals, isNamePure);
+		
+		NSArray *arguments = [elements subarrayWithRange:NSMakeRange(1, elements.count - 1)];
+		
+		//Local bindings only affect the closure's own scope.
+		if(IsSymbolNamed(head, @"let"))
+		{
+			if(elements.count < 4 || !IsSymbolNamed([elements objectAtIndex:2], @"="))
+				return NO;
+			
+			return IsPureExpression([elements subarrayWithRange:NSMakeRange(3, elements.count - 3)], locals, isNamePure);
+		}
+		
+		//The blocks given to decide are evaluated in place.
+		if(IsSymbolNamed(head, @"decide") && ![locals containsObject:@"decide"])
+		{
+			for (id argument in arguments)
+			{
+				if([argument isKindOfClass:[STList class]] && ST_FLAG_IS_SET([argument flags], kSTListFlagIsDefinition))
+				{
+					if(!IsPureExpression([argument allObjects], locals, isNamePure))
+						return NO;
+				}
+				else if(!IsPureExpression(argument, locals, isNamePure))
+				{
+					return NO;
+				}
+			}
+			
+			return YES;
+		}
+		
+		if([head isKindOfClass:[STSymbol class]] && ![head isQuoted] && 
+		   ![locals containsObject:[head string]] && [[head string] rangeOfString:@"."].location == NSNotFound && 
+		   isNamePure([head string]))
+		{
+			return IsPureExpression(arguments, locals, isNamePure);
+		}
+		
+		//Infix arithmetic is sent as a message to the left-most operand.
+		if((elements.count % 2) == 1)
+		{
+			for (NSUInteger index = 1; index < elements.count; index += 2)
+			{
+				if(!IsOperatorLabel([elements objectAtIndex:index]))
+					return NO;
+			}
+			
+			for (NSUInteger index = 0; index < elements.count; index += 2)
+			{
+				if(!IsPureExpression([elements objectAtIndex:index], locals, isNamePure))
+					return NO;
+			}
+			
+			return YES;
+		}
+	}
+	
+	return NO;
+}
+
+BOOL STClosureImplementationIsPure(STList *prototype, STList *implementation, BOOL(^isNamePure)(NSString *name))
+{
+	NSCParameterAssert(prototype);
+	NSCParameterAssert(implementation);
+	NSCParameterAssert(isNamePure);
+	
+	NSMutableSet *locals = [NSMutableSet setWithObject:@"$_arguments"];
+	for (id parameter in prototype)
+		[locals addObject:[parameter string]];
+	
+	NSArray *statements = implementation.allObjects;
+	id head = [implementation head];
+	if([head isKindOfClass:[STList class]] && ST_FLAG_IS_SET([head flags], kSTListFlagIsDefinitionParameters))
+	{
+		for (id parameter in head)
+			[locals addObject:[parameter string]];
+		
+		statements = [statements subarrayWithRange:NSMakeRange(1, statements.count - 1)];
+	}
+	
+	for (id statement in statements)
+		CollectLocalBindings(statement, locals);
+	
+	return IsPureExpression(statements, locals, isNamePure);
+}
@@ -57,8 +57,73 @@
 ///The receiver should expect, and react to both continue and break exceptions as appropriate.
 - (id)filter:(id <STFunction>)function;
 
+#pragma mark - Aggregation
+
+///Combine the objects in the receiver's contents into a single value.
+///
+/// \param		function	The function used to combine objects. May not be nil.
+/// \param		initial		The value to combine with the first object. May not be nil.
+/// \result		The last result of the function, or `initial` if the receiver is empty.
+///
+///The function is given the result of the previous combination (or `initial`) as its first
+///parameter, followed by the parameters that `-[STEnumerable foreach:]` would give it.
+///
+///The receiver should expect, and react to both continue and break exceptions as appropriate.
+- (id)reduce:(id <STFunction>)function initial:(id)initial;
+
+///Returns the sum of the objects in the receiver's contents, or 0 if the receiver is empty.
+///If the receiver's contents are key-value pairs, the values are summed.
+- (id)sum;
+
+///Returns the smallest object in the receiver's contents, or nil if the receiver is empty.
+///If the receiver's contents are key-value pairs, the smallest value is returned.
+- (id)min;
+
+///Returns the largest object in the receiver's contents, or nil if the receiver is empty.
+///If the receiver's contents are key-value pairs, the largest value is returned.
+- (id)max;
+
+///Returns the number of objects in the receiver's contents that a function returns true for.
+///
+/// \param		function	The function to apply to each object. May not be nil.
+/// \result		The number of objects the function returned true for.
+///
+///The function is given the same parameters as it would be by `-[STEnumerable foreach:]`.
+- (NSUInteger)count:(id <STFunction>)function;
+
+///Partition the receiver's contents into groups by the result of applying a function to each object.
+///
+/// \param		function	The function that yields the key of each object's group. May not be nil.
+/// \result		A dictionary whose keys are the results of the function, and whose values are
+///				collections of the same kind as the receiver containing each group's objects.
+///
+///The function is given the same parameters as it would be by `-[STEnumerable foreach:]`.
+///Objects the function yields nil for are not placed in any group.
+- (NSDictionary *)groupBy:(id <STFunction>)function;
+
 @end
 
+#pragma mark - Aggregation Support
+
+///Combine the objects of a collection into a single value by applying a function to each in turn.
+ST_EXTERN id STEnumerableReduce(id <NSFastEnumeration> objects, id <STFunction> function, id initial);
+
+///Returns the sum of the objects of a collection. Numbers are accumulated without being boxed,
+///other objects are added together using their `operatorAdd:` method.
+ST_EXTERN id STEnumerableSum(id <NSFastEnumeration> objects);
+
+///Returns the smallest object of a collection, or nil if it is empty.
+ST_EXTERN id STEnumerableMinimum(id <NSFastEnumeration> objects);
+
+///Returns the largest object of a collection, or nil if it is empty.
+ST_EXTERN id STEnumerableMaximum(id <NSFastEnumeration> objects);
+
+///Returns the number of objects of a collection that a function returns true for.
+ST_EXTERN NSUInteger STEnumerableCount(id <NSFastEnumeration> objects, id <STFunction> function);
+
+///Returns a dictionary of arrays containing the objects of a collection grouped by the results of applying a function to them.
+ST_EXTERN NSDictionary *STEnumerableGroup(id <NSFastEnumeration> objects, id <STFunction> function);
+
 #pragma mark -
 
 @interface STBreakException : NSException
@@ -84,3 +149,23 @@
 @property STCreationLocation *creationLocation;
 
 @end
+
+#pragma mark - Parallel Support
+
+///Returns the results of applying a pure function to each object of an array, computed on multiple threads.
+///
+/// \param	objects		The objects to map. Required.
+/// \param	function	The function to apply. Must report itself as pure, an exception is raised otherwise.
+/// \result	An array containing the non-nil results of the function, in the same order as `objects`.
+ST_EXTERN NSArray *STEnumerableParallelMap(NSArray *objects, id <STFunction> function);
+
+///Returns the objects of an array that a pure function returns true for, computed on multiple threads.
+///The order of the objects is preserved. The function must report itself as pure.
+ST_EXTERN NSArray *STEnumerableParallelFilter(NSArray *objects, id <STFunction> function);
+
+///Combines the objects of an array into a single value using a pure, associative function on multiple threads.
+///
+///The array is split into contiguous runs that are each combined separately, and the results of each run are
+///then combined in order. Returns nil if the array is empty. Results of nil are treated as STNull.
+///The function must report itself as pure.
+ST_EXTERN id STEnumerableParallelReduce(NSArray *objects, id <STFunction> function);
@@ -7,6 +7,9 @@
 //
 
 #import "STEnumerable.h"
+#import "STList.h"
+#import "NSObject+SteinInternalSupport.h"
+#import "NSObject+SteinTools.h"
 
 @implementation STBreakException
 
@@ -33,3 +36,339 @@
 @synthesize creationLocation = mCreationLocation;
 
 @end
+
+#pragma mark - Aggregation Support
+
+id STEnumerableReduce(id <NSFastEnumeration> objects, id <STFunction> function, id initial)
+{
+	NSCParameterAssert(function);
+	NSCParameterAssert(initial);
+	
+	id result = initial;
+	for (id object in objects)
+	{
+		@try
+		{
+			//A function that yields nothing must not cut the argument list short.
+			result = STFunctionApply(function, [[STList alloc] initWithObjects:(result ?: STNull), object, nil]);
+		}
+		@catch (STBreakException *e)
+		{
+			break;
+		}
+		@catch (STContinueException *e)
+		{
+			continue;
+		}
+	}
+	
+	return result;
+}
+
+id STEnumerableSum(id <NSFastEnumeration> objects)
+{
+	//Plain numbers are accumulated as doubles, matching the `+` operator on NSNumber.
+	//Once anything else is encountered the sum is boxed and `operatorAdd:` is used instead.
+	double sum = 0.0;
+	id boxedSum = nil;
+	for (id object in objects)
+	{
+		if(!boxedSum && [object isKindOfClass:[NSNumber class]] && ![object isKindOfClass:[NSDecimalNumber class]])
+		{
+			sum += [object doubleValue];
+		}
+		else
+		{
+			if(!boxedSum)
+				boxedSum = [NSNumber numberWithDouble:sum];
+			
+			boxedSum = [boxedSum operatorAdd:object];
+		}
+	}
+	
+	return boxedSum? boxedSum : [NSNumber numberWithDouble:sum];
+}
+
+///Returns the object of a collection that compares as `order` to every other object in the collection.
+static id Extremum(id <NSFastEnumeration> objects, NSComparisonResult order)
+{
+	id extremum = nil;
+	double extremeValue = 0.0;
+	BOOL extremumIsNumber = NO;
+	for (id object in objects)
+	{
+		BOOL objectIsNumber = [object isKindOfClass:[NSNumber class]] && ![object isKindOfClass:[NSDecimalNumber class]];
+		if(!extremum)
+		{
+			extremum = object;
+			extremumIsNumber = objectIsNumber;
+			extremeValue = objectIsNumber? [object doubleValue] : 0.0;
+			continue;
+		}
+		
+		if(extremumIsNumber && objectIsNumber)
+		{
+			double value = [object doubleValue];
+			if((order == NSOrderedAscending)? (value < extremeValue) : (value > extremeValue))
+			{
+				extremum = object;
+				extremeValue = value;
+			}
+		}
+		else if([object compare:extremum] == order)
+		{
+			extremum = object;
+			extremumIsNumber = objectIsNumber;
+			extremeValue = objectIsNumber? [object doubleValue] : 0.0;
+		}
+	}
+	
+	return extremum;
+}
+
+id STEnumerableMinimum(id <NSFastEnumeration> objects)
+{
+	return Extremum(objects, NSOrderedAscending);
+}
+
+id STEnumerableMaximum(id <NSFastEnumeration> objects)
+{
+	return Extremum(objects, NSOrderedDescending);
+}
+
+NSUInteger STEnumerableCount(id <NSFastEnumeration> objects, id <STFunction> function)
+{
+	NSCParameterAssert(function);
+	
+	NSUInteger count = 0;
+	for (id object in objects)
+	{
+		@try
+		{
+			if(STIsTrue(STFunctionApply(function, [[STList alloc] initWithObject:object])))
+				count++;
+		}
+		@catch (STBreakException *e)
+		{
+			break;
+		}
+		@catch (STContinueException *e)
+		{
+			continue;
+		}
+	}
+	
+	return count;
+}
+
+NSDictionary *STEnumerableGroup(id <NSFastEnumeration> objects, id <STFunction> function)
+{
+	NSCParameterAssert(function);
+	
+	NSMutableDictionary *groups = [NSMutableDictionary dictionary];
+	for (id object in objects)
+	{
+		@try
+		{
+			id key = STFunctionApply(function, [[STList alloc] initWithObject:object]);
+			if(!key)
+				continue;
+			
+			NSMutableArray *group = [groups objectForKey:key];
+			if(!group)
+			{
+				group = [NSMutableArray array];
+				[groups setObject:group forKey:key];
+			}
+			
+			[group addObject:object];
+		}
+		@catch (STBreakException *e)
+		{
+			break;
+		}
+		@catch (STContinueException *e)
+		{
+			continue;
+		}
+	}
+	
+	return groups;
+}
+
+#pragma mark - Parallel Support
+
+///Raises an exception if a specified function cannot be proven safe to apply from multiple threads at once.
+static void AssertFunctionIsParallelSafe(id <STFunction> function, NSString *operation)
+{
+	NSCParameterAssert(function);
+	
+	if(![function respondsToSelector:@selector(isPure)] || ![function isPure])
+	{
+		[NSException raise:NSInvalidArgumentException 
+					format:@"%@ requires a pure function. %@ may depend on or modify mutable state outside of itself, and cannot safely be applied in parallel.", operation, [(id)function prettyDescription]];
+	}
+}
+
+///Splits a specified number of objects into runs, processes each run on the global concurrent queue, and collects
+///the results of each run in order. The first `serialCount` objects are processed on the calling thread beforehand
+///so that any caches the function's implementation populates on first use are not populated concurrently.
+static NSArray *ParallelApply(NSUInteger count, NSUInteger serialCount, NSString *operation, NSArray *(^processRun)(NSRange range))
+{
+	NSMutableArray *results = [NSMutableArray arrayWithCapacity:count];
+	
+	serialCount = MIN(serialCount, count);
+	if(serialCount > 0)
+		[results addObjectsFromArray:processRun(NSMakeRange(0, serialCount))];
+	
+	NSUInteger remainingCount = count - serialCount;
+	if(remainingCount == 0)
+		return results;
+	
+	//Several runs are created per processor so that threads which finish early take on the remaining work.
+	NSUInteger processorCount = [[NSProcessInfo processInfo] activeProcessorCount];
+	NSUInteger runLength = MAX((remainingCount + processorCount * 4 - 1) / (processorCount * 4), 1);
+	NSUInteger runCount = (remainingCount + runLength - 1) / runLength;
+	
+	__strong NSArray **runResults = (__strong NSArray **)calloc(runCount, sizeof(NSArray *));
+	__block NSException *failure = nil;
+	__block volatile BOOL hasFailed = NO;
+	NSObject *failureLock = [NSObject new];
+	
+	dispatch_apply(runCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t runIndex) {
+		if(hasFailed)
+			return;
+		
+		@autoreleasepool
+		{
+			NSUInteger location = serialCount + runIndex * runLength;
+			NSRange range = NSMakeRange(location, MIN(runLength, count - location));
+			@try
+			{
+				runResults[runIndex] = processRun(range);
+			}
+			@catch (STBreakException *e)
+			{
+				@synchronized(failureLock)
+				{
+					if(!failure)
+						failure = [NSException exceptionWithName:NSInvalidArgumentException 
+														  reason:[NSString stringWithFormat:@"break cannot be used within %@.", operation] 
+														userInfo:nil];
+					
+					hasFailed = YES;
+				}
+			}
+			@catch (NSException *e)
+			{
+				@synchronized(failureLock)
+				{
+					if(!failure)
+						failure = e;
+					
+					hasFailed = YES;
+				}
+			}
+		}
+	});
+	
+	for (NSUInteger runIndex = 0; runIndex < runCount; runIndex++)
+	{
+		if(!failure)
+			[results addObjectsFromArray:runResults[runIndex]];
+		
+		runResults[runIndex] = nil;
+	}
+	free(runResults);
+	
+	if(failure)
+		@throw failure;
+	
+	return results;
+}
+
+NSArray *STEnumerableParallelMap(NSArray *objects, id <STFunction> function)
+{
+	NSCParameterAssert(objects);
+	AssertFunctionIsParallelSafe(function, @"pmap:");
+	
+	return ParallelApply([objects count], 1, @"pmap:", ^NSArray *(NSRange range) {
+		NSMutableArray *mappedObjects = [NSMutableArray arrayWithCapacity:range.length];
+		for (NSUInteger index = range.location; index < NSMaxRange(range); index++)
+		{
+			@try
+			{
+				id mappedObject = STFunctionApply(function, [[STList alloc] initWithObject:[objects objectAtIndex:index]]);
+				if(mappedObject)
+					[mappedObjects addObject:mappedObject];
+			}
+			@catch (STContinueException *e)
+			{
+				continue;
+			}
+		}
+		
+		return mappedObjects;
+	});
+}
+
+NSArray *STEnumerableParallelFilter(NSArray *objects, id <STFunction> function)
+{
+	NSCParameterAssert(objects);
+	AssertFunctionIsParallelSafe(function, @"pfilter:");
+	
+	return ParallelApply([objects count], 1, @"pfilter:", ^NSArray *(NSRange range) {
+		NSMutableArray *filteredObjects = [NSMutableArray arrayWithCapacity:range.length];
+		for (NSUInteger index = range.location; index < NSMaxRange(range); index++)
+		{
+			id object = [objects objectAtIndex:index];
+			@try
+			{
+				if(STIsTrue(STFunctionApply(function, [[STList alloc] initWithObject:object])))
+					[filteredObjects addObject:object];
+			}
+			@catch (STContinueException *e)
+			{
+				continue;
+			}
+		}
+		
+		return filteredObjects;
+	});
+}
+
+id STEnumerableParallelReduce(NSArray *objects, id <STFunction> function)
+{
+	NSCParameterAssert(objects);
+	AssertFunctionIsParallelSafe(function, @"preduce:");
+	
+	//Each run is combined into a single partial result, which are then combined on the calling thread.
+	NSArray *partialResults = ParallelApply([objects count], 2, @"preduce:", ^NSArray *(NSRange range) {
+		id result = [objects objectAtIndex:range.location];
+		for (NSUInteger index = range.location + 1; index < NSMaxRange(range); index++)
+		{
+			@try
+			{
+				//Results of nil would end the argument list early, so they are passed on as null.
+				result = STFunctionApply(function, [[STList alloc] initWithObjects:result, [objects objectAtIndex:index], nil]) ?: STNull;
+			}
+			@catch (STContinueException *e)
+			{
+				continue;
+			}
+		}
+		
+		return [NSArray arrayWithObject:result];
+	});
+	
+	if([partialResults count] == 0)
+		return nil;
+	
+	id result = [partialResults objectAtIndex:0];
+	for (NSUInteger index = 1, count = [partialResults count]; index < count; index++)
+	{
+		result = STFunctionApply(function, [[STList alloc] initWithObjects:result, [partialResults objectAtIndex:index], nil]) ?: STNull;
+	}
+	
+	return result;
+}
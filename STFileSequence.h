@@ -0,0 +1,53 @@
+//
+//  STFileSequence.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <Stein/STEnumerable.h>
+
+///The STFileSequence class represents the lines or fixed-size chunks of a file, read as they are enumerated.
+///
+///A file sequence does not read its file until it is enumerated, and then only reads as much of the
+///file at a time as is needed to yield its next object. Each enumeration opens the file again, and the
+///file is closed as soon as it has been read to its end, or when a function given to `-[STFileSequence foreach:]`
+///breaks. Fast enumeration only holds the file open while it reads each batch of objects, so a `for` loop that
+///breaks does not leave it open. `map:` and `filter:` yield lazy sequences, so pipelines over a file never hold
+///all of it in memory.
+///
+///Lines are yielded without their line terminators as strings that refer to the block of the file they were
+///read from, and are only decoded when their characters are first needed. Lines that are still alive when
+///enumeration moves past their block, or ends, copy their own bytes out of it, so they never keep a whole
+///block in memory. Chunks are yielded as data objects.
+///
+///File sequences are created in Stein with the `open-lines` and `open-chunks` functions.
+@interface STFileSequence : NSObject < STEnumerable, NSFastEnumeration >
+{
+	NSString *mPath;
+	BOOL mYieldsLines;
+	NSUInteger mChunkSize;
+}
+
+#pragma mark Creation
+
+///Returns a sequence over the lines of the file at a specified path, which is assumed to be UTF-8.
++ (STFileSequence *)linesOfFileAtPath:(NSString *)path;
+
+///Returns a sequence over the contents of the file at a specified path, in chunks of a specified number of bytes.
+///The last chunk may be shorter than the rest.
++ (STFileSequence *)chunksOfFileAtPath:(NSString *)path size:(NSUInteger)chunkSize;
+
+#pragma mark - Properties
+
+///The path of the file the receiver reads.
+@property (readonly) NSString *path;
+
+#pragma mark - Materializing
+
+///Returns an array containing every object yielded by the receiver.
+- (NSArray *)toArray;
+
+@end
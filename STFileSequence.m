@@ -0,0 +1,567 @@
+//
+//  STFileSequence.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STFileSequence.h"
+#import "STLazySequence.h"
+#import "STList.h"
+#import "NSObject+SteinTools.h"
+#import <fcntl.h>
+#import <unistd.h>
+#import <sys/stat.h>
+#import <libkern/OSAtomic.h>
+
+///The number of bytes read from a file at a time when reading lines.
+#define BLOCK_SIZE	(64 * 1024)
+
+#define BATCH_SIZE	16
+
+///Reads up to a specified number of bytes from a file, returning fewer only at the end of the file.
+static NSUInteger ReadFully(int fileDescriptor, void *buffer, NSUInteger length)
+{
+	NSUInteger totalLength = 0;
+	while (totalLength < length)
+	{
+		ssize_t readLength = read(fileDescriptor, (Byte *)buffer + totalLength, length - totalLength);
+		if(readLength == 0)
+			break;
+		
+		if(readLength == -1)
+		{
+			if(errno == EINTR)
+				continue;
+			
+			[NSException raise:NSGenericException format:@"Could not read file. Got error «%s».", strerror(errno)];
+		}
+		
+		totalLength += readLength;
+	}
+	
+	return totalLength;
+}
+
+#pragma mark Lines
+
+///The STFileLine class is a line of a file that refers to the block of the file it was read from.
+@interface STFileLine : NSString
+{
+	NSData *mBlock;
+	NSRange mByteRange;
+	NSString *mString;
+}
+
+///Initialize the receiver with a range of bytes in a specified block.
+- (id)initWithBlock:(NSData *)block byteRange:(NSRange)byteRange;
+
+///Copy the receiver's bytes out of its block if it has not been decoded yet, so it no longer refers to the block.
+- (void)detachFromBlock;
+
+@end
+
+@implementation STFileLine
+
+- (id)initWithBlock:(NSData *)block byteRange:(NSRange)byteRange
+{
+	NSParameterAssert(block);
+	
+	if((self = [super init]))
+	{
+		mBlock = block;
+		mByteRange = byteRange;
+	}
+	
+	return self;
+}
+
+///Returns the characters of the receiver, decoding them if needed.
+///
+///Lines may be shared between threads, so they are decoded under a lock. Once decoded,
+///the string is published with a barrier and read without taking the lock.
+- (NSString *)decodedString
+{
+	NSString *string = mString;
+	if(string)
+		return string;
+	
+	@synchronized(self)
+	{
+		if(!mString)
+		{
+			const Byte *bytes = (const Byte *)[mBlock bytes] + mByteRange.location;
+			string = [[NSString alloc] initWithBytes:bytes length:mByteRange.length encoding:NSUTF8StringEncoding];
+			
+			//Lines that are not valid UTF-8 are read byte for byte, rather than being lost.
+			if(!string)
+				string = [[NSString alloc] initWithBytes:bytes length:mByteRange.length encoding:NSISOLatin1StringEncoding];
+			
+			OSMemoryBarrier();
+			mString = string;
+			mBlock = nil;
+		}
+		
+		return mString;
+	}
+}
+
+- (void)detachFromBlock
+{
+	@synchronized(self)
+	{
+		if(mBlock)
+		{
+			mBlock = [NSData dataWithBytes:(const Byte *)[mBlock bytes] + mByteRange.location length:mByteRange.length];
+			mByteRange.location = 0;
+		}
+	}
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	return [[self decodedString] copy];
+}
+
+#pragma mark - Primitive Methods
+
+- (NSUInteger)length
+{
+	return [[self decodedString] length];
+}
+
+- (unichar)characterAtIndex:(NSUInteger)index
+{
+	return [[self decodedString] characterAtIndex:index];
+}
+
+- (void)getCharacters:(unichar *)buffer range:(NSRange)range
+{
+	[[self decodedString] getCharacters:buffer range:range];
+}
+
+@end
+
+#pragma mark - Reader
+
+///The STFileReader class performs a single pass over the file of a file sequence.
+@interface STFileReader : NSObject
+{
+	NSString *mPath;
+	int mFileDescriptor;
+	off_t mFileOffset;
+	BOOL mIsAtEnd;
+	
+	//The identity of the file when it was first opened.
+	BOOL mHasOpenedFile;
+	dev_t mFileDevice;
+	ino_t mFileNode;
+	BOOL mYieldsLines;
+	NSUInteger mChunkSize;
+	
+	//The block lines are currently being read from. Blocks are never
+	//changed once they have been read, as lines may refer to them.
+	NSData *mBlock;
+	NSUInteger mBlockOffset;
+	
+	//The lines yielded from the current block that are still alive.
+	NSHashTable *mLinesOfBlock;
+	
+	//The objects most recently yielded through fast enumeration.
+	__strong id mYieldedObjects[BATCH_SIZE];
+}
+
+///Initialize the receiver by opening the file at a specified path.
+- (id)initWithPath:(NSString *)path yieldsLines:(BOOL)yieldsLines chunkSize:(NSUInteger)chunkSize;
+
+///Returns the next line or chunk of the receiver's file, or nil if the file has been read to its end.
+- (id)nextObject;
+
+///Close the receiver's file. The file is opened again if more of it is read.
+- (void)close;
+
+///Close the receiver's file, and detach the lines yielded from the current block from it.
+- (void)finish;
+
+///Fill a specified fast enumeration state with the next batch of yielded objects.
+///The receiver's file is closed again before this method returns.
+- (NSUInteger)fillState:(NSFastEnumerationState *)state count:(NSUInteger)length;
+
+@end
+
+@implementation STFileReader
+
+- (void)dealloc
+{
+	[self finish];
+}
+
+- (id)initWithPath:(NSString *)path yieldsLines:(BOOL)yieldsLines chunkSize:(NSUInteger)chunkSize
+{
+	NSParameterAssert(path);
+	
+	if((self = [super init]))
+	{
+		mPath = [path copy];
+		mFileDescriptor = -1;
+		mYieldsLines = yieldsLines;
+		mChunkSize = chunkSize;
+		mBlock = [NSData data];
+		mLinesOfBlock = [[NSHashTable alloc] initWithOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+													capacity:0];
+		
+		//The file is opened up front so that missing files are reported when enumeration begins.
+		[self open];
+	}
+	
+	return self;
+}
+
+///Open the receiver's file if it is not open, positioned where the receiver stopped reading it.
+///
+///An exception is raised if the path no longer refers to the file that was first opened,
+///such as when a log file has been rotated between batches.
+- (void)open
+{
+	if(mFileDescriptor != -1)
+		return;
+	
+	mFileDescriptor = open([mPath fileSystemRepresentation], O_RDONLY);
+	if(mFileDescriptor == -1)
+		[NSException raise:NSInvalidArgumentException format:@"Could not open file at path %@. Got error «%s».", mPath, strerror(errno)];
+	
+	struct stat fileInfo;
+	if(fstat(mFileDescriptor, &fileInfo) == -1)
+	{
+		int error = errno;
+		[self close];
+		[NSException raise:NSGenericException format:@"Could not get info for file at path %@. Got error «%s».", mPath, strerror(error)];
+	}
+	
+	if(!mHasOpenedFile)
+	{
+		mHasOpenedFile = YES;
+		mFileDevice = fileInfo.st_dev;
+		mFileNode = fileInfo.st_ino;
+	}
+	else if(fileInfo.st_dev != mFileDevice || fileInfo.st_ino != mFileNode)
+	{
+		[self close];
+		[NSException raise:NSGenericException format:@"File at path %@ was replaced while it was being read.", mPath];
+	}
+	
+	if(mFileOffset > 0 && lseek(mFileDescriptor, mFileOffset, SEEK_SET) == -1)
+	{
+		int error = errno;
+		[self close];
+		[NSException raise:NSGenericException format:@"Could not seek in file at path %@. Got error «%s».", mPath, strerror(error)];
+	}
+}
+
+- (void)close
+{
+	if(mFileDescriptor != -1)
+	{
+		close(mFileDescriptor);
+		mFileDescriptor = -1;
+	}
+}
+
+///Detach the lines that are still alive from the current block, so they do not keep it in memory.
+- (void)detachLinesOfBlock
+{
+	for (STFileLine *line in mLinesOfBlock)
+		[line detachFromBlock];
+	
+	[mLinesOfBlock removeAllObjects];
+}
+
+- (void)finish
+{
+	[self close];
+	[self detachLinesOfBlock];
+}
+
+///Read up to a specified number of bytes from the receiver's file, marking the receiver as
+///being at the end of its file if fewer bytes than requested could be read.
+- (NSUInteger)readBytes:(void *)buffer length:(NSUInteger)length
+{
+	[self open];
+	
+	NSUInteger readLength = ReadFully(mFileDescriptor, buffer, length);
+	mFileOffset += readLength;
+	if(readLength < length)
+	{
+		mIsAtEnd = YES;
+		[self close];
+	}
+	
+	return readLength;
+}
+
+#pragma mark - Reading
+
+///Returns the next chunk of the receiver's file.
+- (NSData *)nextChunk
+{
+	if(mIsAtEnd)
+		return nil;
+	
+	NSMutableData *chunk = [NSMutableData dataWithLength:mChunkSize];
+	NSUInteger chunkLength = [self readBytes:[chunk mutableBytes] length:mChunkSize];
+	if(chunkLength < mChunkSize)
+	{
+		if(chunkLength == 0)
+			return nil;
+		
+		[chunk setLength:chunkLength];
+	}
+	
+	return chunk;
+}
+
+///Returns a line of the current block with a specified range of bytes, without its carriage return.
+- (STFileLine *)lineWithByteRange:(NSRange)byteRange
+{
+	if(byteRange.length > 0 && ((const Byte *)[mBlock bytes])[NSMaxRange(byteRange) - 1] == '\r')
+		byteRange.length--;
+	
+	STFileLine *line = [[STFileLine alloc] initWithBlock:mBlock byteRange:byteRange];
+	[mLinesOfBlock addObject:line];
+	return line;
+}
+
+///Returns the next line of the receiver's file.
+- (STFileLine *)nextLine
+{
+	while (YES)
+	{
+		const Byte *bytes = [mBlock bytes];
+		NSUInteger blockLength = [mBlock length];
+		if(mBlockOffset < blockLength)
+		{
+			const Byte *newline = memchr(bytes + mBlockOffset, '\n', blockLength - mBlockOffset);
+			if(newline)
+			{
+				NSUInteger lineEnd = newline - bytes;
+				STFileLine *line = [self lineWithByteRange:NSMakeRange(mBlockOffset, lineEnd - mBlockOffset)];
+				mBlockOffset = lineEnd + 1;
+				return line;
+			}
+		}
+		
+		if(mIsAtEnd)
+		{
+			//The last line of a file does not need to end with a newline.
+			if(mBlockOffset < blockLength)
+			{
+				STFileLine *line = [self lineWithByteRange:NSMakeRange(mBlockOffset, blockLength - mBlockOffset)];
+				mBlockOffset = blockLength;
+				return line;
+			}
+			
+			return nil;
+		}
+		
+		//The unfinished line at the end of the current block is carried into the next block.
+		//Blocks grow with the line, so reading very long lines does not take quadratic time.
+		NSUInteger carriedLength = blockLength - mBlockOffset;
+		NSUInteger readLength = MAX(BLOCK_SIZE, carriedLength);
+		NSMutableData *block = [NSMutableData dataWithLength:carriedLength + readLength];
+		memcpy([block mutableBytes], bytes + mBlockOffset, carriedLength);
+		
+		NSUInteger actualReadLength = [self readBytes:(Byte *)[block mutableBytes] + carriedLength length:readLength];
+		if(actualReadLength < readLength)
+			[block setLength:carriedLength + actualReadLength];
+		
+		//Lines that outlive the block they were read from copy their bytes out of it.
+		[self detachLinesOfBlock];
+		
+		mBlock = block;
+		mBlockOffset = 0;
+	}
+}
+
+- (id)nextObject
+{
+	return mYieldsLines? [self nextLine] : [self nextChunk];
+}
+
+- (NSUInteger)fillState:(NSFastEnumerationState *)state count:(NSUInteger)length
+{
+	NSUInteger count = 0;
+	@try
+	{
+		for (NSUInteger limit = MIN(length, BATCH_SIZE); count < limit; count++)
+		{
+			id object = [self nextObject];
+			if(!object)
+				break;
+			
+			mYieldedObjects[count] = object;
+		}
+	}
+	@finally
+	{
+		//Nothing tells a reader when a for-in loop breaks, so the file is
+		//only kept open while a batch is read, and reopened for the next one.
+		[self close];
+	}
+	
+	state->itemsPtr = (__unsafe_unretained id *)(void *)mYieldedObjects;
+	return count;
+}
+
+@end
+
+#pragma mark -
+
+@implementation STFileSequence
+
+#pragma mark Creation
+
++ (STFileSequence *)linesOfFileAtPath:(NSString *)path
+{
+	NSParameterAssert(path);
+	
+	STFileSequence *sequence = [self new];
+	sequence->mPath = [path copy];
+	sequence->mYieldsLines = YES;
+	return sequence;
+}
+
++ (STFileSequence *)chunksOfFileAtPath:(NSString *)path size:(NSUInteger)chunkSize
+{
+	NSParameterAssert(path);
+	NSAssert((chunkSize > 0), @"Chunk size is 0. You cannot read a file in empty chunks.");
+	
+	STFileSequence *sequence = [self new];
+	sequence->mPath = [path copy];
+	sequence->mChunkSize = chunkSize;
+	return sequence;
+}
+
+#pragma mark - Properties
+
+@synthesize path = mPath;
+
+#pragma mark - Enumeration
+
+///Returns a new reader for a single pass over the receiver's file.
+- (STFileReader *)reader
+{
+	return [[STFileReader alloc] initWithPath:mPath yieldsLines:mYieldsLines chunkSize:mChunkSize];
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)len
+{
+	if(state->state == 0)
+	{
+		//The reader is kept alive by the enclosing autorelease pool for the duration of the loop.
+		//It only holds the file open while it fills a batch, so loops that break do not leak it.
+		__autoreleasing STFileReader *reader = [self reader];
+		state->extra[0] = (unsigned long)(__bridge void *)reader;
+		state->mutationsPtr = &state->extra[1];
+		state->state = 1;
+	}
+	
+	STFileReader *reader = (__bridge STFileReader *)(void *)state->extra[0];
+	return [reader fillState:state count:len];
+}
+
+#pragma mark - STEnumerable
+
+- (id)foreach:(id <STFunction>)function
+{
+	STFileReader *reader = [self reader];
+	@try
+	{
+		for (id object = [reader nextObject]; object != nil; object = [reader nextObject])
+		{
+			@try
+			{
+				STFunctionApply(function, [[STList alloc] initWithObject:object]);
+			}
+			@catch (STBreakException *e)
+			{
+				break;
+			}
+			@catch (STContinueException *e)
+			{
+				continue;
+			}
+		}
+	}
+	@finally
+	{
+		[reader finish];
+	}
+	
+	return self;
+}
+
+- (id)map:(id <STFunction>)function
+{
+	return [[STLazySequence sequenceWithSource:self] map:function];
+}
+
+- (id)filter:(id <STFunction>)function
+{
+	return [[STLazySequence sequenceWithSource:self] filter:function];
+}
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	return STEnumerableReduce(self, function, initial);
+}
+
+- (id)sum
+{
+	return STEnumerableSum(self);
+}
+
+- (id)min
+{
+	return STEnumerableMinimum(self);
+}
+
+- (id)max
+{
+	return STEnumerableMaximum(self);
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	return STEnumerableCount(self, function);
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	return STEnumerableGroup(self, function);
+}
+
+#pragma mark - Materializing
+
+- (NSArray *)toArray
+{
+	NSMutableArray *objects = [NSMutableArray array];
+	for (id object in self)
+	{
+		[objects addObject:object];
+	}
+	
+	return [objects copy];
+}
+
+#pragma mark - Printing
+
+- (NSString *)prettyDescription
+{
+	if(mYieldsLines)
+		return [NSString stringWithFormat:@"<lines of %@>", [mPath prettyDescription]];
+	
+	return [NSString stringWithFormat:@"<%lu byte chunks of %@>", (unsigned long)mChunkSize, [mPath prettyDescription]];
+}
+
+@end
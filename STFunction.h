@@ -28,6 +28,14 @@
 ///The enclosing scope the receiver was created in. This is used to implement closures.
 @property (readonly) STScope *superscope;
 
+@optional
+
+///Returns YES if applying the receiver has no side effects, and yields a result that depends only on its arguments.
+///
+///The results of pure functions may be cached and shared between call sites.
+///Functions that do not implement this property are considered impure.
+@property (readonly) BOOL isPure;
+
 @end
 
 #pragma mark -
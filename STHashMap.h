@@ -0,0 +1,92 @@
+//
+//  STHashMap.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <Stein/STEnumerable.h>
+
+@class STHashTrieNode;
+
+///The STHashMap class is an immutable dictionary that is cheap to derive new dictionaries from.
+///
+///Hash maps are stored as hash array mapped tries. Every method that derives a new map
+///from an existing one, such as `-[STHashMap mapBySettingObject:forKey:]`, shares all but
+///the nodes along the path it changes with the receiver, and so takes O(log n) time
+///instead of copying the receiver.
+///
+///STHashMap is a subclass of NSDictionary, and so may be given to any API that expects a
+///dictionary without being converted. Like NSDictionary, hash maps copy their keys, so that
+///modifying a key after it has been inserted cannot change where it is stored. Hash maps are
+///created in Stein with the `dictionary` function.
+@interface STHashMap : NSDictionary < STEnumerable >
+{
+	STHashTrieNode *mRoot;
+	NSUInteger mCount;
+}
+
+#pragma mark Creation
+
+///Returns the empty hash map.
++ (STHashMap *)map;
+
+///Returns a hash map with the contents of a specified dictionary. If the dictionary
+///is already a hash map it is returned as-is, otherwise its contents are copied.
++ (STHashMap *)mapWithDictionary:(NSDictionary *)dictionary;
+
+#pragma mark - Deriving Maps
+
+///Returns a new map where a specified key is associated with a specified object. Neither may be nil.
+- (STHashMap *)mapBySettingObject:(id)object forKey:(id)key;
+
+///Returns a new map without any object associated with a specified key.
+- (STHashMap *)mapByRemovingObjectForKey:(id)key;
+
+///Returns a new map containing the receiver's entries, and the entries of a specified dictionary.
+///Where both contain the same key, the object from the dictionary is used.
+- (STHashMap *)mapByAddingEntriesFromDictionary:(NSDictionary *)dictionary;
+
+///Returns a new map without the objects associated with the keys in a specified collection.
+- (STHashMap *)mapByRemovingObjectsForKeys:(id <NSFastEnumeration>)keys;
+
+@end
+
+#pragma mark -
+
+///The STHashSet class is an immutable set that is cheap to derive new sets from.
+///
+///Hash sets are stored in the same manner as STHashMap, and share all but the nodes
+///along the path changed with the sets they were derived from. STHashSet is a subclass
+///of NSSet. Hash sets are created in Stein with the `set` function.
+@interface STHashSet : NSSet < STEnumerable >
+{
+	STHashTrieNode *mRoot;
+	NSUInteger mCount;
+}
+
+#pragma mark Creation
+
+///Returns the empty hash set.
++ (STHashSet *)hashSet;
+
+///Returns a hash set containing the objects of a specified array, set, list, or other collection.
++ (STHashSet *)hashSetWithObjectsFromCollection:(id <NSFastEnumeration>)collection;
+
+#pragma mark - Deriving Sets
+
+///Returns a new set containing the receiver's objects, and a specified object. May not be nil.
+- (STHashSet *)setByAddingObject:(id)object;
+
+///Returns a new set containing the receiver's objects, and the objects of a specified collection.
+- (STHashSet *)setByAddingObjectsFromCollection:(id <NSFastEnumeration>)collection;
+
+///Returns a new set containing the receiver's objects except for a specified object.
+- (STHashSet *)setByRemovingObject:(id)object;
+
+///Returns a new set containing the receiver's objects except for those in a specified collection.
+- (STHashSet *)setByRemovingObjectsFromCollection:(id <NSFastEnumeration>)collection;
+
+@end
@@ -0,0 +1,883 @@
+//
+//  STHashMap.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STHashMap.h"
+#import "STList.h"
+#import "NSObject+SteinTools.h"
+
+#define NODE_BITS		5
+#define NODE_MASK		((1 << NODE_BITS) - 1)
+#define MAXIMUM_DEPTH	16
+
+#pragma mark Nodes
+
+///The STHashTrieNode class represents a single node in a hash array mapped trie.
+///
+///A node holds key-value pairs and child nodes for up to 32 fragments of a hash. Its
+///contents are laid out as the pairs in fragment order, followed by the children in
+///fragment order. Keys whose entire hashes are equal are kept together in collision nodes.
+@interface STHashTrieNode : NSObject
+{
+@public
+	uint32_t mDataMap;
+	uint32_t mNodeMap;
+	NSArray *mContents;
+	
+	BOOL mIsCollision;
+	NSUInteger mHash;
+}
+
+@end
+
+@implementation STHashTrieNode
+
+@end
+
+#pragma mark - Trie Operations
+
+ST_INLINE uint32_t BitForHash(NSUInteger hash, NSUInteger shift)
+{
+	return 1u << ((hash >> shift) & NODE_MASK);
+}
+
+ST_INLINE NSUInteger IndexForBit(uint32_t map, uint32_t bit)
+{
+	return __builtin_popcount(map & (bit - 1));
+}
+
+ST_INLINE NSUInteger CountOfPairs(STHashTrieNode *node)
+{
+	return node->mIsCollision? [node->mContents count] / 2 : __builtin_popcount(node->mDataMap);
+}
+
+static STHashTrieNode *NodeWithContents(uint32_t dataMap, uint32_t nodeMap, NSArray *contents)
+{
+	STHashTrieNode *node = [STHashTrieNode new];
+	node->mDataMap = dataMap;
+	node->mNodeMap = nodeMap;
+	node->mContents = contents;
+	return node;
+}
+
+static STHashTrieNode *CollisionNodeWithContents(NSUInteger hash, NSArray *contents)
+{
+	STHashTrieNode *node = [STHashTrieNode new];
+	node->mIsCollision = YES;
+	node->mHash = hash;
+	node->mContents = contents;
+	return node;
+}
+
+///Returns whether or not a node contains exactly one pair and no children, and so may be stored in its parent directly.
+ST_INLINE BOOL IsSinglePairNode(STHashTrieNode *node)
+{
+	return (node->mNodeMap == 0 && CountOfPairs(node) == 1);
+}
+
+#pragma mark -
+
+static id FindObject(STHashTrieNode *node, id key, NSUInteger hash, NSUInteger shift)
+{
+	while (node)
+	{
+		NSArray *contents = node->mContents;
+		if(node->mIsCollision)
+		{
+			if(hash != node->mHash)
+				return nil;
+			
+			for (NSUInteger index = 0, count = [contents count]; index < count; index += 2)
+			{
+				if([[contents objectAtIndex:index] isEqual:key])
+					return [contents objectAtIndex:index + 1];
+			}
+			
+			return nil;
+		}
+		
+		uint32_t bit = BitForHash(hash, shift);
+		if(node->mDataMap & bit)
+		{
+			NSUInteger index = IndexForBit(node->mDataMap, bit) * 2;
+			return [[contents objectAtIndex:index] isEqual:key]? [contents objectAtIndex:index + 1] : nil;
+		}
+		else if(node->mNodeMap & bit)
+		{
+			NSUInteger index = __builtin_popcount(node->mDataMap) * 2 + IndexForBit(node->mNodeMap, bit);
+			node = [contents objectAtIndex:index];
+			shift += NODE_BITS;
+		}
+		else
+		{
+			return nil;
+		}
+	}
+	
+	return nil;
+}
+
+///Returns a node containing two pairs whose keys have different hashes, or the same hash.
+static STHashTrieNode *MergePairs(id firstKey, id firstObject, NSUInteger firstHash, id secondKey, id secondObject, NSUInteger secondHash, NSUInteger shift)
+{
+	if(firstHash == secondHash)
+		return CollisionNodeWithContents(firstHash, [NSArray arrayWithObjects:firstKey, firstObject, secondKey, secondObject, nil]);
+	
+	uint32_t firstBit = BitForHash(firstHash, shift);
+	uint32_t secondBit = BitForHash(secondHash, shift);
+	if(firstBit == secondBit)
+	{
+		STHashTrieNode *child = MergePairs(firstKey, firstObject, firstHash, secondKey, secondObject, secondHash, shift + NODE_BITS);
+		return NodeWithContents(0, firstBit, [NSArray arrayWithObject:child]);
+	}
+	
+	NSArray *contents = (firstBit < secondBit)?
+		[NSArray arrayWithObjects:firstKey, firstObject, secondKey, secondObject, nil] :
+		[NSArray arrayWithObjects:secondKey, secondObject, firstKey, firstObject, nil];
+	return NodeWithContents(firstBit | secondBit, 0, contents);
+}
+
+///Returns a node derived from a specified node where a key is associated with an object.
+static STHashTrieNode *SetObject(STHashTrieNode *node, id key, id object, NSUInteger hash, NSUInteger shift, BOOL *outDidAdd)
+{
+	NSArray *contents = node->mContents;
+	if(node->mIsCollision)
+	{
+		if(hash != node->mHash)
+		{
+			//The key only shares part of its hash with the colliding keys, so the
+			//collision node is moved beneath a node that can tell them apart.
+			STHashTrieNode *parent = NodeWithContents(0, BitForHash(node->mHash, shift), [NSArray arrayWithObject:node]);
+			return SetObject(parent, key, object, hash, shift, outDidAdd);
+		}
+		
+		NSMutableArray *newContents = [contents mutableCopy];
+		for (NSUInteger index = 0, count = [contents count]; index < count; index += 2)
+		{
+			if([[contents objectAtIndex:index] isEqual:key])
+			{
+				if([contents objectAtIndex:index + 1] == object)
+					return node;
+				
+				[newContents replaceObjectAtIndex:index + 1 withObject:object];
+				return CollisionNodeWithContents(hash, newContents);
+			}
+		}
+		
+		[newContents addObject:key];
+		[newContents addObject:object];
+		*outDidAdd = YES;
+		
+		return CollisionNodeWithContents(hash, newContents);
+	}
+	
+	uint32_t bit = BitForHash(hash, shift);
+	NSUInteger countOfPairs = __builtin_popcount(node->mDataMap);
+	if(node->mDataMap & bit)
+	{
+		NSUInteger index = IndexForBit(node->mDataMap, bit) * 2;
+		id existingKey = [contents objectAtIndex:index];
+		id existingObject = [contents objectAtIndex:index + 1];
+		if([existingKey isEqual:key])
+		{
+			if(existingObject == object)
+				return node;
+			
+			NSMutableArray *newContents = [contents mutableCopy];
+			[newContents replaceObjectAtIndex:index + 1 withObject:object];
+			return NodeWithContents(node->mDataMap, node->mNodeMap, newContents);
+		}
+		
+		//The existing pair and the new pair are pushed down into a new child.
+		STHashTrieNode *child = MergePairs(existingKey, existingObject, [existingKey hash], key, object, hash, shift + NODE_BITS);
+		uint32_t newNodeMap = node->mNodeMap | bit;
+		
+		NSMutableArray *newContents = [contents mutableCopy];
+		[newContents removeObjectsInRange:NSMakeRange(index, 2)];
+		[newContents insertObject:child atIndex:(countOfPairs - 1) * 2 + IndexForBit(newNodeMap, bit)];
+		*outDidAdd = YES;
+		
+		return NodeWithContents(node->mDataMap ^ bit, newNodeMap, newContents);
+	}
+	else if(node->mNodeMap & bit)
+	{
+		NSUInteger index = countOfPairs * 2 + IndexForBit(node->mNodeMap, bit);
+		STHashTrieNode *child = [contents objectAtIndex:index];
+		STHashTrieNode *newChild = SetObject(child, key, object, hash, shift + NODE_BITS, outDidAdd);
+		if(newChild == child)
+			return node;
+		
+		NSMutableArray *newContents = [contents mutableCopy];
+		[newContents replaceObjectAtIndex:index withObject:newChild];
+		return NodeWithContents(node->mDataMap, node->mNodeMap, newContents);
+	}
+	
+	NSUInteger index = IndexForBit(node->mDataMap, bit) * 2;
+	NSMutableArray *newContents = [NSMutableArray arrayWithCapacity:[contents count] + 2];
+	[newContents addObjectsFromArray:contents];
+	[newContents insertObject:object atIndex:index];
+	[newContents insertObject:key atIndex:index];
+	*outDidAdd = YES;
+	
+	return NodeWithContents(node->mDataMap | bit, node->mNodeMap, newContents);
+}
+
+///Returns a node derived from a specified node where a key is not associated with any object.
+static STHashTrieNode *RemoveObject(STHashTrieNode *node, id key, NSUInteger hash, NSUInteger shift, BOOL *outDidRemove)
+{
+	NSArray *contents = node->mContents;
+	if(node->mIsCollision)
+	{
+		if(hash != node->mHash)
+			return node;
+		
+		for (NSUInteger index = 0, count = [contents count]; index < count; index += 2)
+		{
+			if(![[contents objectAtIndex:index] isEqual:key])
+				continue;
+			
+			NSMutableArray *newContents = [contents mutableCopy];
+			[newContents removeObjectsInRange:NSMakeRange(index, 2)];
+			*outDidRemove = YES;
+			
+			//A single remaining pair is moved back into the parent of the collision node.
+			if([newContents count] == 2)
+				return NodeWithContents(BitForHash(hash, shift), 0, newContents);
+			
+			return CollisionNodeWithContents(hash, newContents);
+		}
+		
+		return node;
+	}
+	
+	uint32_t bit = BitForHash(hash, shift);
+	NSUInteger countOfPairs = __builtin_popcount(node->mDataMap);
+	if(node->mDataMap & bit)
+	{
+		NSUInteger index = IndexForBit(node->mDataMap, bit) * 2;
+		if(![[contents objectAtIndex:index] isEqual:key])
+			return node;
+		
+		NSMutableArray *newContents = [contents mutableCopy];
+		[newContents removeObjectsInRange:NSMakeRange(index, 2)];
+		*outDidRemove = YES;
+		
+		return NodeWithContents(node->mDataMap ^ bit, node->mNodeMap, newContents);
+	}
+	else if(node->mNodeMap & bit)
+	{
+		NSUInteger index = countOfPairs * 2 + IndexForBit(node->mNodeMap, bit);
+		STHashTrieNode *child = [contents objectAtIndex:index];
+		STHashTrieNode *newChild = RemoveObject(child, key, hash, shift + NODE_BITS, outDidRemove);
+		if(newChild == child)
+			return node;
+		
+		NSMutableArray *newContents = [contents mutableCopy];
+		if(IsSinglePairNode(newChild))
+		{
+			//Children with a single pair are never kept, the pair is stored in the receiver instead.
+			uint32_t newDataMap = node->mDataMap | bit;
+			NSUInteger pairIndex = IndexForBit(newDataMap, bit) * 2;
+			
+			[newContents removeObjectAtIndex:index];
+			[newContents insertObject:[newChild->mContents objectAtIndex:1] atIndex:pairIndex];
+			[newContents insertObject:[newChild->mContents objectAtIndex:0] atIndex:pairIndex];
+			
+			return NodeWithContents(newDataMap, node->mNodeMap ^ bit, newContents);
+		}
+		
+		[newContents replaceObjectAtIndex:index withObject:newChild];
+		return NodeWithContents(node->mDataMap, node->mNodeMap, newContents);
+	}
+	
+	return node;
+}
+
+///Invokes a block with each pair beneath a specified node, returning NO if the block asked to stop.
+static BOOL EnumeratePairs(STHashTrieNode *node, void(^block)(id key, id object, BOOL *stop))
+{
+	NSArray *contents = node->mContents;
+	NSUInteger countOfPairs = CountOfPairs(node);
+	
+	BOOL stop = NO;
+	for (NSUInteger index = 0; index < countOfPairs; index++)
+	{
+		block([contents objectAtIndex:index * 2], [contents objectAtIndex:index * 2 + 1], &stop);
+		if(stop)
+			return NO;
+	}
+	
+	for (NSUInteger index = countOfPairs * 2, count = [contents count]; index < count; index++)
+	{
+		if(!EnumeratePairs([contents objectAtIndex:index], block))
+			return NO;
+	}
+	
+	return YES;
+}
+
+#pragma mark - Enumerators
+
+///The STHashTrieEnumerator class enumerates the keys or objects of a hash array mapped trie.
+@interface STHashTrieEnumerator : NSEnumerator
+{
+	__strong STHashTrieNode *mNodes[MAXIMUM_DEPTH];
+	NSUInteger mPositions[MAXIMUM_DEPTH];
+	NSInteger mDepth;
+	BOOL mEnumeratesObjects;
+}
+
+///Initialize the receiver to enumerate the keys, or objects, beneath a specified root node.
+- (id)initWithRoot:(STHashTrieNode *)root enumeratesObjects:(BOOL)enumeratesObjects;
+
+@end
+
+@implementation STHashTrieEnumerator
+
+- (id)initWithRoot:(STHashTrieNode *)root enumeratesObjects:(BOOL)enumeratesObjects
+{
+	NSParameterAssert(root);
+	
+	if((self = [super init]))
+	{
+		mNodes[0] = root;
+		mDepth = 0;
+		mEnumeratesObjects = enumeratesObjects;
+	}
+	
+	return self;
+}
+
+- (id)nextObject
+{
+	while (mDepth >= 0)
+	{
+		STHashTrieNode *node = mNodes[mDepth];
+		NSUInteger position = mPositions[mDepth];
+		NSUInteger countOfPairs = CountOfPairs(node);
+		if(position < countOfPairs)
+		{
+			mPositions[mDepth]++;
+			return [node->mContents objectAtIndex:position * 2 + (mEnumeratesObjects? 1 : 0)];
+		}
+		
+		NSUInteger childIndex = countOfPairs * 2 + (position - countOfPairs);
+		if(childIndex < [node->mContents count])
+		{
+			mPositions[mDepth]++;
+			
+			mDepth++;
+			NSAssert((mDepth < MAXIMUM_DEPTH), @"Hash trie is deeper than expected.");
+			mNodes[mDepth] = [node->mContents objectAtIndex:childIndex];
+			mPositions[mDepth] = 0;
+			
+			continue;
+		}
+		
+		mNodes[mDepth] = nil;
+		mDepth--;
+	}
+	
+	return nil;
+}
+
+@end
+
+#pragma mark -
+
+static STHashTrieNode *EmptyNode()
+{
+	static STHashTrieNode *emptyNode = nil;
+	static dispatch_once_t predicate;
+	dispatch_once(&predicate, ^{
+		emptyNode = NodeWithContents(0, 0, [NSArray array]);
+	});
+	
+	return emptyNode;
+}
+
+///Returns the copy of a key that a map stores, so that modifying the key after it is inserted cannot
+///change its hash. Like NSDictionary, keys are copied; keys that cannot be copied are stored as they are.
+ST_INLINE id CopyKey(id key)
+{
+	return [key respondsToSelector:@selector(copyWithZone:)]? [key copy] : key;
+}
+
+@interface STHashMap ()
+
+///Initialize the receiver with a specified root node, and number of pairs.
+- (id)initWithRoot:(STHashTrieNode *)root count:(NSUInteger)count;
+
+@end
+
+@implementation STHashMap
+
+#pragma mark Creation
+
++ (STHashMap *)map
+{
+	static STHashMap *emptyMap = nil;
+	static dispatch_once_t predicate;
+	dispatch_once(&predicate, ^{
+		emptyMap = [[STHashMap alloc] initWithRoot:EmptyNode() count:0];
+	});
+	
+	return emptyMap;
+}
+
++ (STHashMap *)mapWithDictionary:(NSDictionary *)dictionary
+{
+	NSParameterAssert(dictionary);
+	
+	if([dictionary isKindOfClass:[STHashMap class]])
+		return (STHashMap *)dictionary;
+	
+	return [[self map] mapByAddingEntriesFromDictionary:dictionary];
+}
+
+- (id)initWithRoot:(STHashTrieNode *)root count:(NSUInteger)count
+{
+	if((self = [super init]))
+	{
+		mRoot = root;
+		mCount = count;
+	}
+	
+	return self;
+}
+
+- (id)init
+{
+	return [self initWithRoot:EmptyNode() count:0];
+}
+
+- (id)initWithObjects:(const id [])objects forKeys:(const id <NSCopying> [])keys count:(NSUInteger)count
+{
+	STHashTrieNode *root = EmptyNode();
+	NSUInteger countOfPairs = 0;
+	for (NSUInteger index = 0; index < count; index++)
+	{
+		BOOL didAdd = NO;
+		id key = CopyKey(keys[index]);
+		root = SetObject(root, key, objects[index], [key hash], 0, &didAdd);
+		if(didAdd)
+			countOfPairs++;
+	}
+	
+	return [self initWithRoot:root count:countOfPairs];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	return self;
+}
+
+#pragma mark - Primitive Methods
+
+- (NSUInteger)count
+{
+	return mCount;
+}
+
+- (id)objectForKey:(id)key
+{
+	if(!key)
+		return nil;
+	
+	return FindObject(mRoot, key, [key hash], 0);
+}
+
+- (NSEnumerator *)keyEnumerator
+{
+	return [[STHashTrieEnumerator alloc] initWithRoot:mRoot enumeratesObjects:NO];
+}
+
+- (NSEnumerator *)objectEnumerator
+{
+	return [[STHashTrieEnumerator alloc] initWithRoot:mRoot enumeratesObjects:YES];
+}
+
+- (void)enumerateKeysAndObjectsUsingBlock:(void (^)(id key, id object, BOOL *stop))block
+{
+	NSParameterAssert(block);
+	
+	EnumeratePairs(mRoot, block);
+}
+
+#pragma mark - Deriving Maps
+
+- (STHashMap *)mapBySettingObject:(id)object forKey:(id)key
+{
+	NSParameterAssert(object);
+	NSParameterAssert(key);
+	
+	key = CopyKey(key);
+	
+	BOOL didAdd = NO;
+	STHashTrieNode *root = SetObject(mRoot, key, object, [key hash], 0, &didAdd);
+	if(root == mRoot)
+		return self;
+	
+	return [[STHashMap alloc] initWithRoot:root count:mCount + (didAdd? 1 : 0)];
+}
+
+- (STHashMap *)mapByRemovingObjectForKey:(id)key
+{
+	NSParameterAssert(key);
+	
+	BOOL didRemove = NO;
+	STHashTrieNode *root = RemoveObject(mRoot, key, [key hash], 0, &didRemove);
+	if(!didRemove)
+		return self;
+	
+	return [[STHashMap alloc] initWithRoot:root count:mCount - 1];
+}
+
+- (STHashMap *)mapByAddingEntriesFromDictionary:(NSDictionary *)dictionary
+{
+	NSParameterAssert(dictionary);
+	
+	__block STHashTrieNode *root = mRoot;
+	__block NSUInteger count = mCount;
+	[dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop) {
+		key = CopyKey(key);
+		
+		BOOL didAdd = NO;
+		root = SetObject(root, key, object, [key hash], 0, &didAdd);
+		if(didAdd)
+			count++;
+	}];
+	
+	if(root == mRoot)
+		return self;
+	
+	return [[STHashMap alloc] initWithRoot:root count:count];
+}
+
+- (STHashMap *)mapByRemovingObjectsForKeys:(id <NSFastEnumeration>)keys
+{
+	NSParameterAssert(keys);
+	
+	STHashTrieNode *root = mRoot;
+	NSUInteger count = mCount;
+	for (id key in keys)
+	{
+		BOOL didRemove = NO;
+		root = RemoveObject(root, key, [key hash], 0, &didRemove);
+		if(didRemove)
+			count--;
+	}
+	
+	if(root == mRoot)
+		return self;
+	
+	return [[STHashMap alloc] initWithRoot:root count:count];
+}
+
+#pragma mark - Operators
+
+- (NSDictionary *)operatorAdd:(NSDictionary *)rightOperand
+{
+	return [self mapByAddingEntriesFromDictionary:rightOperand];
+}
+
+- (NSDictionary *)operatorSubtract:(id)rightOperand
+{
+	if([rightOperand isKindOfClass:[NSDictionary class]])
+		return [self mapByRemovingObjectsForKeys:[rightOperand keyEnumerator]];
+	
+	return [self mapByRemovingObjectsForKeys:rightOperand];
+}
+
+#pragma mark - Enumerable
+
+- (id)map:(id <STFunction>)function
+{
+	__block STHashMap *result = [STHashMap map];
+	
+	[self enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+		@try
+		{
+			id mappedValue = STFunctionApply(function, [[STList alloc] initWithArray:[NSArray arrayWithObjects:key, value, nil]]);
+			if(STIsTrue(mappedValue))
+				result = [result mapBySettingObject:mappedValue forKey:key];
+		}
+		@catch (STBreakException *e)
+		{
+			*stop = YES;
+			return;
+		}
+		@catch (STContinueException *e)
+		{
+			return;
+		}
+	}];
+	
+	return result;
+}
+
+- (id)filter:(id <STFunction>)function
+{
+	//Only the pairs that pass are added, so pairs skipped by `break` or `continue` are left out.
+	__block STHashMap *result = [STHashMap map];
+	
+	[self enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+		@try
+		{
+			if(STIsTrue(STFunctionApply(function, [[STList alloc] initWithArray:[NSArray arrayWithObjects:key, value, nil]])))
+				result = [result mapBySettingObject:value forKey:key];
+		}
+		@catch (STBreakException *e)
+		{
+			*stop = YES;
+			return;
+		}
+		@catch (STContinueException *e)
+		{
+			return;
+		}
+	}];
+	
+	return result;
+}
+
+@end
+
+#pragma mark -
+
+@interface STHashSet ()
+
+///Initialize the receiver with a specified root node, and number of objects.
+- (id)initWithRoot:(STHashTrieNode *)root count:(NSUInteger)count;
+
+@end
+
+@implementation STHashSet
+
+#pragma mark Creation
+
++ (STHashSet *)hashSet
+{
+	static STHashSet *emptySet = nil;
+	static dispatch_once_t predicate;
+	dispatch_once(&predicate, ^{
+		emptySet = [[STHashSet alloc] initWithRoot:EmptyNode() count:0];
+	});
+	
+	return emptySet;
+}
+
++ (STHashSet *)hashSetWithObjectsFromCollection:(id <NSFastEnumeration>)collection
+{
+	NSParameterAssert(collection);
+	
+	if([(id)collection isKindOfClass:[STHashSet class]])
+		return (STHashSet *)collection;
+	
+	return [[self hashSet] setByAddingObjectsFromCollection:collection];
+}
+
+- (id)initWithRoot:(STHashTrieNode *)root count:(NSUInteger)count
+{
+	if((self = [super init]))
+	{
+		mRoot = root;
+		mCount = count;
+	}
+	
+	return self;
+}
+
+- (id)init
+{
+	return [self initWithRoot:EmptyNode() count:0];
+}
+
+- (id)initWithObjects:(const id [])objects count:(NSUInteger)count
+{
+	STHashTrieNode *root = EmptyNode();
+	NSUInteger countOfObjects = 0;
+	for (NSUInteger index = 0; index < count; index++)
+	{
+		//Sets are stored as maps whose keys are associated with themselves.
+		BOOL didAdd = NO;
+		root = SetObject(root, objects[index], objects[index], [objects[index] hash], 0, &didAdd);
+		if(didAdd)
+			countOfObjects++;
+	}
+	
+	return [self initWithRoot:root count:countOfObjects];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	return self;
+}
+
+#pragma mark - Primitive Methods
+
+- (NSUInteger)count
+{
+	return mCount;
+}
+
+- (id)member:(id)object
+{
+	if(!object)
+		return nil;
+	
+	return FindObject(mRoot, object, [object hash], 0);
+}
+
+- (NSEnumerator *)objectEnumerator
+{
+	return [[STHashTrieEnumerator alloc] initWithRoot:mRoot enumeratesObjects:NO];
+}
+
+#pragma mark - Deriving Sets
+
+- (STHashSet *)setByAddingObject:(id)object
+{
+	NSParameterAssert(object);
+	
+	BOOL didAdd = NO;
+	STHashTrieNode *root = SetObject(mRoot, object, object, [object hash], 0, &didAdd);
+	if(!didAdd)
+		return self;
+	
+	return [[STHashSet alloc] initWithRoot:root count:mCount + 1];
+}
+
+- (STHashSet *)setByAddingObjectsFromCollection:(id <NSFastEnumeration>)collection
+{
+	NSParameterAssert(collection);
+	
+	STHashTrieNode *root = mRoot;
+	NSUInteger count = mCount;
+	for (id object in collection)
+	{
+		BOOL didAdd = NO;
+		root = SetObject(root, object, object, [object hash], 0, &didAdd);
+		if(didAdd)
+			count++;
+	}
+	
+	if(count == mCount)
+		return self;
+	
+	return [[STHashSet alloc] initWithRoot:root count:count];
+}
+
+- (STHashSet *)setByAddingObjectsFromSet:(NSSet *)other
+{
+	return [self setByAddingObjectsFromCollection:other];
+}
+
+- (STHashSet *)setByAddingObjectsFromArray:(NSArray *)other
+{
+	return [self setByAddingObjectsFromCollection:other];
+}
+
+- (STHashSet *)setByRemovingObject:(id)object
+{
+	NSParameterAssert(object);
+	
+	BOOL didRemove = NO;
+	STHashTrieNode *root = RemoveObject(mRoot, object, [object hash], 0, &didRemove);
+	if(!didRemove)
+		return self;
+	
+	return [[STHashSet alloc] initWithRoot:root count:mCount - 1];
+}
+
+- (STHashSet *)setByRemovingObjectsFromCollection:(id <NSFastEnumeration>)collection
+{
+	NSParameterAssert(collection);
+	
+	STHashTrieNode *root = mRoot;
+	NSUInteger count = mCount;
+	for (id object in collection)
+	{
+		BOOL didRemove = NO;
+		root = RemoveObject(root, object, [object hash], 0, &didRemove);
+		if(didRemove)
+			count--;
+	}
+	
+	if(count == mCount)
+		return self;
+	
+	return [[STHashSet alloc] initWithRoot:root count:count];
+}
+
+#pragma mark - Operators
+
+- (NSSet *)operatorAdd:(NSSet *)rightOperand
+{
+	return [self setByAddingObjectsFromCollection:rightOperand];
+}
+
+- (NSSet *)operatorSubtract:(NSSet *)rightOperand
+{
+	return [self setByRemovingObjectsFromCollection:rightOperand];
+}
+
+#pragma mark - Enumerable
+
+- (id)map:(id <STFunction>)function
+{
+	STHashSet *mappedObjects = [STHashSet hashSet];
+	
+	for (id object in self)
+	{
+		@try
+		{
+			id mappedObject = STFunctionApply(function, [[STList alloc] initWithObject:object]);
+			if(!mappedObject)
+				continue;
+			
+			mappedObjects = [mappedObjects setByAddingObject:mappedObject];
+		}
+		@catch (STBreakException *e)
+		{
+			break;
+		}
+		@catch (STContinueException *e)
+		{
+			continue;
+		}
+	}
+	
+	return mappedObjects;
+}
+
+- (id)filter:(id <STFunction>)function
+{
+	//Only the objects that pass are added, so objects skipped by `break` or `continue` are left out.
+	STHashSet *filteredObjects = [STHashSet hashSet];
+	
+	for (id object in self)
+	{
+		@try
+		{
+			if(STIsTrue(STFunctionApply(function, [[STList alloc] initWithObject:object])))
+				filteredObjects = [filteredObjects setByAddingObject:object];
+		}
+		@catch (STBreakException *e)
+		{
+			break;
+		}
+		@catch (STContinueException *e)
+		{
+			continue;
+		}
+	}
+	
+	return filteredObjects;
+}
+
+@end
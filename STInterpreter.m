@@ -12,6 +12,7 @@
 #import "NSObject+SteinTools.h"
 
 #import "STClosure.h"
+#import "STMacro.h"
 #import "STFunction.h"
 #import "STScope.h"
 #import "STEnumerable.h"
@@ -23,9 +24,13 @@
 
 #import "STBuiltInFunctions.h"
 #import "SteinException.h"
+#import "STOutput.h"
 
 #pragma mark Evaluation
 
+///The key under which the free variables of a definition are cached.
+static NSString *const kFreeVariablesCacheKey = @"STFreeVariables";
+
 static id LambdaFromDefinition(STList *definition, STScope *scope)
 {
 	STList *prototype = nil;
@@ -45,7 +50,74 @@ static id LambdaFromDefinition(STList *definition, STScope *scope)
 	
 	body.flags = kSTListFlagsNone;
 	
-	return [[STClosure alloc] initWithPrototype:prototype forImplementation:body inScope:scope];
+	//The free variables of a definition never change, so they are only found once.
+	NSSet *freeVariables = [definition cachedValueForKey:kFreeVariablesCacheKey];
+	if(!freeVariables)
+	{
+		freeVariables = STClosureFindFreeVariables(prototype, body);
+		
+		//The expansion of a macro may reference variables that do not appear in the definition.
+		for (NSString *name in freeVariables)
+		{
+			if([[scope valueForVariableNamed:name searchParentScopes:YES] isKindOfClass:[STMacro class]])
+			{
+				freeVariables = nil;
+				break;
+			}
+		}
+		
+		freeVariables = freeVariables ?: (NSSet *)STNull;
+		[definition setCachedValue:freeVariables forKey:kFreeVariablesCacheKey];
+	}
+	
+	return [[STClosure alloc] initWithPrototype:prototype 
+							  forImplementation:body 
+							 capturingVariables:(freeVariables != STNull)? freeVariables : nil 
+									  fromScope:scope];
+}
+
+///The key under which the value of a constant collection form is cached.
+static NSString *const kPooledLiteralCacheKey = @"STPooledLiteral";
+
+///The STPooledLiteral class records the value a constant collection form evaluated to,
+///and the function that created it. The value is only reused while the form's head
+///continues to name the same function.
+@interface STPooledLiteral : NSObject
+{
+@public
+	id mFunction;
+	id mValue;
+}
+
+@end
+
+@implementation STPooledLiteral
+
+@end
+
+///Returns whether or not every expression in a list of arguments always evaluates to the same immutable value.
+static BOOL IsConstantArgumentList(STList *arguments)
+{
+	for (id expression in arguments)
+	{
+		if([expression isKindOfClass:[NSNumber class]] || [expression isKindOfClass:[NSString class]])
+			continue;
+		
+		if([expression isKindOfClass:[STList class]])
+		{
+			STList *list = expression;
+			if(ST_FLAG_IS_SET(list.flags, kSTListFlagIsDefinition) || ST_FLAG_IS_SET(list.flags, kSTListFlagIsQuoted))
+				return NO;
+			
+			//Empty lists evaluate to null, and nested constant collections have already been pooled.
+			if(list.count == 0 || [list cachedValueForKey:kPooledLiteralCacheKey])
+				continue;
+		}
+		
+		return NO;
+	}
+	
+	return YES;
 }
 
 static id EvaluateList(STList *list, STScope *scope)
@@ -59,18 +131,45 @@ static id EvaluateList(STList *list, STScope *scope)
 	NSUInteger listCount = list.count;
 	if(listCount == 0)
 		return STNull;
-	else if(listCount == 1)
-		return STEvaluate([list head], scope);
+	
+	//Forms naming macros are only expanded the first time they are evaluated.
+	id expansion = STMacroCachedExpansionOfForm(list);
+	if(expansion)
+		return STEvaluate(expansion, scope);
 	
 	id <STFunction> target = STEvaluate([list head], scope);
+	if([target isKindOfClass:[STMacro class]])
+		return STEvaluate([(STMacro *)target expansionOfForm:list inScope:scope], scope);
+	
+	if(listCount == 1)
+		return target;
+	
 	if([target evaluatesOwnArguments])
 		return [target applyWithArguments:[list tail] inScope:scope];
 	
+	//Constant collections are only created the first time they are evaluated.
+	BOOL createsLiteralCollection = STIsLiteralCollectionFunction(target);
+	if(createsLiteralCollection)
+	{
+		STPooledLiteral *pooledLiteral = [list cachedValueForKey:kPooledLiteralCacheKey];
+		if(pooledLiteral && pooledLiteral->mFunction == target)
+			return pooledLiteral->mValue;
+	}
+	
 	STList *evaluatedArguments = [[STList alloc] init];
 	for (id expression in [list tail])
 		[evaluatedArguments addObject:STEvaluate(expression, scope)];
 	
-	return [target applyWithArguments:evaluatedArguments inScope:scope];
+	id result = [target applyWithArguments:evaluatedArguments inScope:scope];
+	if(createsLiteralCollection && IsConstantArgumentList([list tail]))
+	{
+		STPooledLiteral *pooledLiteral = [STPooledLiteral new];
+		pooledLiteral->mFunction = target;
+		pooledLiteral->mValue = result;
+		[list setCachedValue:pooledLiteral forKey:kPooledLiteralCacheKey];
+	}
+	
+	return result;
 }
 
 id STEvaluate(id expression, STScope *scope)
@@ -113,6 +212,8 @@ id STEvaluate(id expression, STScope *scope)
 		}
 		else if([expression isKindOfClass:[NSString class]])
 		{
+			//The parser produces immutable strings, for which copying is free.
+			//Strings placed into expressions by other means may still be mutable.
 			return [expression copy];
 		}
 	}
@@ -204,17 +305,24 @@ void STRunREPL()
 	//Create a scope
 	STScope *scope = STBuiltInFunctionScope();
 	
-	printf("stein ready [version %s]\n", [[SteinBundle() objectForInfoDictionaryKey:@"CFBundleShortVersionString"] UTF8String]);
+	STOutput *output = [STOutput standardOutput];
+	[output writeFormat:@"stein ready [version %@]", [SteinBundle() objectForInfoDictionaryKey:@"CFBundleShortVersionString"]];
+	[output finishLine];
     
     NSObject *pool = [NSClassFromString(@"NSAutoreleasePool") new];
 	for (;;)
 	{
+		//Everything printed by the last line is written out before the prompt.
+		[output flush];
+		
 		//Break away if we've been told to quit|exit|EOF.
 		char *rawLine = readline("Stein> ");
 		if(!rawLine || (strlen(rawLine) == 0) || (strcmp(rawLine, "quit") == 0) || (strcmp(rawLine, "exit") == 0))
 		{
 			free(rawLine);
-			fprintf(stdout, "goodbye\n");
+			[output writeString:@"goodbye"];
+			[output finishLine];
+			[output flush];
 			break;
 		}
         else if(strcmp(rawLine, "collect") == 0)
@@ -235,6 +343,7 @@ void STRunREPL()
 			
 			while (numberOfUnbalancedParentheses > 0)
 			{
+				[output flush];
 				char *partialLine = readline("... ");
 				
 				for (int i = 0; i < strlen(partialLine); i++)
@@ -251,6 +360,7 @@ void STRunREPL()
 			
 			while (numberOfUnbalancedBrackets > 0)
 			{
+				[output flush];
 				char *partialLine = readline("... ");
 				
 				for (int i = 0; i < strlen(partialLine); i++)
@@ -267,10 +377,15 @@ void STRunREPL()
 			
             //Parse and evaluate the data we just read in from the user, and print out the result.
             id result = STEvaluate(STParseString(line, @"<<REPL>>"), scope);
-            fprintf(stdout, "=> %s\n", [[result prettyDescription] UTF8String]);
+            [output lock];
+            [output writeString:@"=> "];
+            [output writePrettyDescriptionOfObject:result];
+            [output finishLine];
+            [output unlock];
 		}
 		@catch (SteinException *e)
 		{
+			[output flush];
 			fprintf(stderr, "Error: %s\n", [[e reason] UTF8String]);
 		}
 		@finally
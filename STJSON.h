@@ -0,0 +1,63 @@
+//
+//  STJSON.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <Stein/STEnumerable.h>
+
+@class STOutput;
+
+///The STJSONSequence class represents the values of a JSON file, parsed as they are enumerated.
+///
+///If the file contains a single array, the sequence yields each element of the array. Otherwise the
+///sequence yields each top-level value of the file in turn, so files with one value per line are also
+///supported. Only the value being parsed and a small block of the file are held in memory at a time, and
+///each enumeration reads the file again. The file is closed when it has been read to its end, or when a
+///function given to `-[STJSONSequence foreach:]` breaks. Fast enumeration only holds the file open while it
+///reads each batch of values, so a `for` loop that breaks does not leave it open. `map:` and `filter:` yield
+///lazy sequences.
+///
+///Numbers must match the grammar of RFC 8259 exactly, so leading plus signs, leading zeros, and numbers
+///followed by anything other than whitespace or a delimiter are rejected.
+///
+///Objects are yielded as dictionaries, whose short keys are shared between every object read by one
+///enumeration. `null` is yielded as NSNull, integers as long long numbers, and all other numbers as doubles.
+///
+///JSON sequences are created in Stein with the `read-json` function.
+@interface STJSONSequence : NSObject < STEnumerable, NSFastEnumeration >
+{
+	NSString *mPath;
+}
+
+#pragma mark Creation
+
+///Returns a sequence over the values of the UTF-8 JSON file at a specified path.
++ (STJSONSequence *)sequenceWithContentsOfFileAtPath:(NSString *)path;
+
+#pragma mark - Properties
+
+///The path of the file the receiver reads.
+@property (readonly) NSString *path;
+
+#pragma mark - Materializing
+
+///Returns an array containing every value yielded by the receiver.
+- (NSArray *)toArray;
+
+@end
+
+#pragma mark -
+
+///Write a specified value to an output as compact JSON.
+///
+/// \param	object	The value to write. Dictionaries are written as objects, with keys that are not strings
+///					written as their descriptions. Any other enumerable collection, including lazy and JSON
+///					sequences, is written as an array one element at a time. May be nil, which is written as `null`.
+/// \param	output	The output to write to. May not be nil.
+///
+///This function raises an exception if the value contains an object that cannot be represented in JSON.
+ST_EXTERN void STJSONWriteObject(id object, STOutput *output);
@@ -0,0 +1,1048 @@
+//
+//  STJSON.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STJSON.h"
+#import "STLazySequence.h"
+#import "STList.h"
+#import "STOutput.h"
+#import "NSObject+SteinTools.h"
+#import <fcntl.h>
+#import <unistd.h>
+#import <sys/stat.h>
+
+///The number of bytes read from a JSON file at a time.
+#define BLOCK_SIZE	(64 * 1024)
+
+#define BATCH_SIZE	16
+
+///The number of keys a reader shares between objects, and the longest key in bytes that is shared.
+#define INTERNED_KEY_COUNT		256
+#define INTERNED_KEY_MAX_LENGTH	32
+
+///The deepest that arrays and objects may be nested in a JSON file.
+#define MAXIMUM_DEPTH	512
+
+#pragma mark Reader
+
+///The STJSONReader class performs a single pass over the values of a JSON file.
+///
+///The reader is parsed by the static functions below, which access its state directly.
+@interface STJSONReader : NSObject
+{
+@public
+	NSString *mPath;
+	int mFileDescriptor;
+	BOOL mIsAtEndOfFile;
+	
+	//The identity of the file when it was first opened.
+	BOOL mHasOpenedFile;
+	dev_t mFileDevice;
+	ino_t mFileNode;
+	
+	//The block of the file currently being parsed.
+	Byte *mBuffer;
+	NSUInteger mBufferLength;
+	NSUInteger mBufferOffset;
+	unsigned long long mBufferPosition;
+	
+	//The bytes of the string or number currently being parsed.
+	char *mScratch;
+	NSUInteger mScratchLength;
+	NSUInteger mScratchCapacity;
+	
+	BOOL mHasReadFirstByte;
+	BOOL mIsReadingTopLevelArray;
+	BOOL mHasReadTopLevelElement;
+	BOOL mIsFinished;
+	
+	//Short keys are looked up by the hash of their bytes, so each distinct key is only created once.
+	__strong NSString *mInternedKeys[INTERNED_KEY_COUNT];
+	char mInternedKeyBytes[INTERNED_KEY_COUNT][INTERNED_KEY_MAX_LENGTH];
+	NSUInteger mInternedKeyLengths[INTERNED_KEY_COUNT];
+	
+	//The objects most recently yielded through fast enumeration.
+	__strong id mYieldedObjects[BATCH_SIZE];
+}
+
+///Initialize the receiver by opening the file at a specified path.
+- (id)initWithPath:(NSString *)path;
+
+///Returns the next value of the receiver's file, or nil if the file has been read to its end.
+- (id)nextObject;
+
+///Open the receiver's file if it is not open, positioned after the last block the receiver read.
+///Raises an exception if the path no longer refers to the file that was first opened.
+- (void)open;
+
+///Close the receiver's file. The file is opened again if more of it is read.
+- (void)close;
+
+///Fill a specified fast enumeration state with the next batch of yielded values.
+///The receiver's file is closed again before this method returns.
+- (NSUInteger)fillState:(NSFastEnumerationState *)state count:(NSUInteger)length;
+
+@end
+
+#pragma mark - Tools
+
+static void RaiseMalformedJSON(STJSONReader *reader, NSString *expectation) __attribute__((noreturn));
+static void RaiseMalformedJSON(STJSONReader *reader, NSString *expectation)
+{
+	unsigned long long position = reader->mBufferPosition + reader->mBufferOffset;
+	@throw [NSException exceptionWithName:NSInvalidArgumentException
+								   reason:[NSString stringWithFormat:@"Malformed JSON at byte %llu, expected %@.", position, expectation]
+								 userInfo:nil];
+}
+
+///Read the next block of a reader's file, returning NO if the end of the file has been reached.
+static BOOL ReadNextBlock(STJSONReader *reader)
+{
+	if(reader->mIsAtEndOfFile)
+		return NO;
+	
+	[reader open];
+	
+	ssize_t readLength;
+	do {
+		readLength = read(reader->mFileDescriptor, reader->mBuffer, BLOCK_SIZE);
+	} while (readLength == -1 && errno == EINTR);
+	
+	if(readLength == -1)
+		[NSException raise:NSGenericException format:@"Could not read JSON file. Got error «%s».", strerror(errno)];
+	
+	reader->mBufferPosition += reader->mBufferLength;
+	reader->mBufferLength = readLength;
+	reader->mBufferOffset = 0;
+	
+	if(readLength == 0)
+	{
+		reader->mIsAtEndOfFile = YES;
+		[reader close];
+		return NO;
+	}
+	
+	return YES;
+}
+
+ST_INLINE int PeekByte(STJSONReader *reader)
+{
+	if(reader->mBufferOffset == reader->mBufferLength && !ReadNextBlock(reader))
+		return EOF;
+	
+	return reader->mBuffer[reader->mBufferOffset];
+}
+
+ST_INLINE int NextByte(STJSONReader *reader)
+{
+	int byte = PeekByte(reader);
+	if(byte != EOF)
+		reader->mBufferOffset++;
+	
+	return byte;
+}
+
+///Skip past any whitespace, returning the first byte after it without consuming it.
+static int SkipWhitespace(STJSONReader *reader)
+{
+	for (;;)
+	{
+		int byte = PeekByte(reader);
+		if(byte != ' ' && byte != '\n' && byte != '\r' && byte != '\t')
+			return byte;
+		
+		reader->mBufferOffset++;
+	}
+}
+
+///Consume a specified literal, raising if the bytes of the file do not match it.
+static void ExpectLiteral(STJSONReader *reader, const char *literal)
+{
+	for (const char *character = literal; *character != '\0'; character++)
+	{
+		if(NextByte(reader) != *character)
+			RaiseMalformedJSON(reader, [NSString stringWithFormat:@"'%s'", literal]);
+	}
+}
+
+#pragma mark - Scratch
+
+static void AppendBytesToScratch(STJSONReader *reader, const void *bytes, NSUInteger length)
+{
+	if(reader->mScratchLength + length + 1 > reader->mScratchCapacity)
+	{
+		NSUInteger capacity = MAX(reader->mScratchCapacity * 2, reader->mScratchLength + length + 1);
+		char *scratch = realloc(reader->mScratch, capacity);
+		if(!scratch)
+			[NSException raise:NSMallocException format:@"Could not allocate %lu bytes to parse JSON.", (unsigned long)capacity];
+		
+		reader->mScratch = scratch;
+		reader->mScratchCapacity = capacity;
+	}
+	
+	memcpy(reader->mScratch + reader->mScratchLength, bytes, length);
+	reader->mScratchLength += length;
+}
+
+ST_INLINE void AppendByteToScratch(STJSONReader *reader, char byte)
+{
+	AppendBytesToScratch(reader, &byte, 1);
+}
+
+///Append a code point to a reader's scratch as UTF-8.
+static void AppendCodePointToScratch(STJSONReader *reader, uint32_t codePoint)
+{
+	char bytes[4];
+	NSUInteger length;
+	if(codePoint < 0x80)
+	{
+		bytes[0] = codePoint;
+		length = 1;
+	}
+	else if(codePoint < 0x800)
+	{
+		bytes[0] = 0xC0 | (codePoint >> 6);
+		bytes[1] = 0x80 | (codePoint & 0x3F);
+		length = 2;
+	}
+	else if(codePoint < 0x10000)
+	{
+		bytes[0] = 0xE0 | (codePoint >> 12);
+		bytes[1] = 0x80 | ((codePoint >> 6) & 0x3F);
+		bytes[2] = 0x80 | (codePoint & 0x3F);
+		length = 3;
+	}
+	else
+	{
+		bytes[0] = 0xF0 | (codePoint >> 18);
+		bytes[1] = 0x80 | ((codePoint >> 12) & 0x3F);
+		bytes[2] = 0x80 | ((codePoint >> 6) & 0x3F);
+		bytes[3] = 0x80 | (codePoint & 0x3F);
+		length = 4;
+	}
+	
+	AppendBytesToScratch(reader, bytes, length);
+}
+
+#pragma mark - Strings
+
+///Read the four hexadecimal digits of a unicode escape.
+static uint32_t GetHexadecimalEscapeAt(STJSONReader *reader)
+{
+	uint32_t value = 0;
+	for (int index = 0; index < 4; index++)
+	{
+		int byte = NextByte(reader);
+		if(byte >= '0' && byte <= '9')
+			value = (value << 4) | (byte - '0');
+		else if(byte >= 'a' && byte <= 'f')
+			value = (value << 4) | (byte - 'a' + 10);
+		else if(byte >= 'A' && byte <= 'F')
+			value = (value << 4) | (byte - 'A' + 10);
+		else
+			RaiseMalformedJSON(reader, @"a hexadecimal digit");
+	}
+	
+	return value;
+}
+
+///Read the contents of a string into a reader's scratch as UTF-8. The opening quote must already have been consumed.
+static void ReadStringIntoScratch(STJSONReader *reader)
+{
+	reader->mScratchLength = 0;
+	for (;;)
+	{
+		if(reader->mBufferOffset == reader->mBufferLength && !ReadNextBlock(reader))
+			RaiseMalformedJSON(reader, @"'\"'");
+		
+		//Runs of plain characters are copied into the scratch all at once.
+		const Byte *start = reader->mBuffer + reader->mBufferOffset;
+		const Byte *end = reader->mBuffer + reader->mBufferLength;
+		const Byte *cursor = start;
+		while (cursor < end && *cursor != '"' && *cursor != '\\' && *cursor >= 0x20)
+			cursor++;
+		
+		AppendBytesToScratch(reader, start, cursor - start);
+		reader->mBufferOffset += cursor - start;
+		if(cursor == end)
+			continue;
+		
+		int byte = NextByte(reader);
+		if(byte == '"')
+			return;
+		
+		if(byte != '\\')
+			RaiseMalformedJSON(reader, @"an escaped control character");
+		
+		int escape = NextByte(reader);
+		switch (escape)
+		{
+			case '"':
+			case '\\':
+			case '/':
+				AppendByteToScratch(reader, escape);
+				break;
+			
+			case 'b':
+				AppendByteToScratch(reader, '\b');
+				break;
+			
+			case 'f':
+				AppendByteToScratch(reader, '\f');
+				break;
+			
+			case 'n':
+				AppendByteToScratch(reader, '\n');
+				break;
+			
+			case 'r':
+				AppendByteToScratch(reader, '\r');
+				break;
+			
+			case 't':
+				AppendByteToScratch(reader, '\t');
+				break;
+			
+			case 'u': {
+				uint32_t codePoint = GetHexadecimalEscapeAt(reader);
+				if(codePoint >= 0xD800 && codePoint <= 0xDBFF)
+				{
+					if(NextByte(reader) != '\\' || NextByte(reader) != 'u')
+						RaiseMalformedJSON(reader, @"a low surrogate escape");
+					
+					uint32_t lowSurrogate = GetHexadecimalEscapeAt(reader);
+					if(lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+						RaiseMalformedJSON(reader, @"a low surrogate escape");
+					
+					codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+				}
+				else if(codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+				{
+					//Unpaired low surrogates cannot be represented in UTF-8.
+					codePoint = 0xFFFD;
+				}
+				
+				AppendCodePointToScratch(reader, codePoint);
+				break;
+			}
+			
+			default:
+				RaiseMalformedJSON(reader, @"a valid escape sequence");
+		}
+	}
+}
+
+static NSString *CreateStringFromScratch(STJSONReader *reader)
+{
+	NSString *string = [[NSString alloc] initWithBytes:reader->mScratch length:reader->mScratchLength encoding:NSUTF8StringEncoding];
+	if(!string)
+		RaiseMalformedJSON(reader, @"a string of valid UTF-8");
+	
+	return string;
+}
+
+static NSString *GetStringAt(STJSONReader *reader)
+{
+	ReadStringIntoScratch(reader);
+	return CreateStringFromScratch(reader);
+}
+
+///Read the key of an object, sharing it with every other equal short key read by the reader.
+static NSString *GetKeyAt(STJSONReader *reader)
+{
+	ReadStringIntoScratch(reader);
+	
+	NSUInteger length = reader->mScratchLength;
+	if(length > INTERNED_KEY_MAX_LENGTH)
+		return CreateStringFromScratch(reader);
+	
+	//FNV-1a
+	uint32_t hash = 2166136261u;
+	for (NSUInteger index = 0; index < length; index++)
+		hash = (hash ^ (Byte)reader->mScratch[index]) * 16777619u;
+	
+	NSUInteger slot = hash & (INTERNED_KEY_COUNT - 1);
+	if(reader->mInternedKeys[slot] && reader->mInternedKeyLengths[slot] == length &&
+	   memcmp(reader->mInternedKeyBytes[slot], reader->mScratch, length) == 0)
+		return reader->mInternedKeys[slot];
+	
+	NSString *key = CreateStringFromScratch(reader);
+	reader->mInternedKeys[slot] = key;
+	reader->mInternedKeyLengths[slot] = length;
+	memcpy(reader->mInternedKeyBytes[slot], reader->mScratch, length);
+	
+	return key;
+}
+
+#pragma mark - Values
+
+///Consume the next byte of a reader's file into its scratch.
+ST_INLINE void ConsumeByteIntoScratch(STJSONReader *reader, int byte)
+{
+	AppendByteToScratch(reader, byte);
+	reader->mBufferOffset++;
+}
+
+///Consume a run of decimal digits into a reader's scratch, returning how many were consumed.
+static NSUInteger ConsumeDigitsIntoScratch(STJSONReader *reader)
+{
+	NSUInteger count = 0;
+	for (int byte = PeekByte(reader); byte >= '0' && byte <= '9'; byte = PeekByte(reader))
+	{
+		ConsumeByteIntoScratch(reader, byte);
+		count++;
+	}
+	
+	return count;
+}
+
+///Read a number, which must match the grammar of RFC 8259 exactly.
+static NSNumber *GetNumberAt(STJSONReader *reader)
+{
+	reader->mScratchLength = 0;
+	
+	BOOL isInteger = YES;
+	int byte = PeekByte(reader);
+	if(byte == '-')
+	{
+		ConsumeByteIntoScratch(reader, byte);
+		byte = PeekByte(reader);
+	}
+	
+	//The integer part is a single zero, or digits that do not start with zero.
+	if(byte == '0')
+	{
+		ConsumeByteIntoScratch(reader, byte);
+		
+		byte = PeekByte(reader);
+		if(byte >= '0' && byte <= '9')
+			RaiseMalformedJSON(reader, @"a number without leading zeros");
+	}
+	else if(byte >= '1' && byte <= '9')
+	{
+		ConsumeDigitsIntoScratch(reader);
+		byte = PeekByte(reader);
+	}
+	else
+	{
+		RaiseMalformedJSON(reader, @"a digit");
+	}
+	
+	if(byte == '.')
+	{
+		isInteger = NO;
+		ConsumeByteIntoScratch(reader, byte);
+		if(ConsumeDigitsIntoScratch(reader) == 0)
+			RaiseMalformedJSON(reader, @"a digit after the decimal point");
+		
+		byte = PeekByte(reader);
+	}
+	
+	if(byte == 'e' || byte == 'E')
+	{
+		isInteger = NO;
+		ConsumeByteIntoScratch(reader, byte);
+		
+		byte = PeekByte(reader);
+		if(byte == '+' || byte == '-')
+			ConsumeByteIntoScratch(reader, byte);
+		
+		if(ConsumeDigitsIntoScratch(reader) == 0)
+			RaiseMalformedJSON(reader, @"a digit in the exponent");
+		
+		byte = PeekByte(reader);
+	}
+	
+	if(byte != EOF && byte != ' ' && byte != '\n' && byte != '\r' && byte != '\t' && byte != ',' && byte != ']' && byte != '}')
+		RaiseMalformedJSON(reader, @"whitespace, ',', ']', or '}' after a number");
+	
+	//The scratch always has room for a terminator.
+	reader->mScratch[reader->mScratchLength] = '\0';
+	
+	char *numberEnd = NULL;
+	if(isInteger)
+	{
+		errno = 0;
+		long long value = strtoll(reader->mScratch, &numberEnd, 10);
+		if(errno != ERANGE && numberEnd == reader->mScratch + reader->mScratchLength && reader->mScratchLength > 0)
+			return [NSNumber numberWithLongLong:value];
+	}
+	
+	//Integers too large for a long long are read as doubles.
+	double value = strtod(reader->mScratch, NULL);
+	
+	return [NSNumber numberWithDouble:value];
+}
+
+static id GetValueAt(STJSONReader *reader, NSUInteger depth);
+
+static NSArray *GetArrayAt(STJSONReader *reader, NSUInteger depth)
+{
+	NSMutableArray *array = [NSMutableArray array];
+	if(SkipWhitespace(reader) == ']')
+	{
+		reader->mBufferOffset++;
+		return array;
+	}
+	
+	for (;;)
+	{
+		[array addObject:GetValueAt(reader, depth + 1)];
+		
+		SkipWhitespace(reader);
+		int byte = NextByte(reader);
+		if(byte == ']')
+			return array;
+		
+		if(byte != ',')
+			RaiseMalformedJSON(reader, @"',' or ']'");
+	}
+}
+
+static NSDictionary *GetObjectAt(STJSONReader *reader, NSUInteger depth)
+{
+	NSMutableDictionary *object = [NSMutableDictionary dictionary];
+	if(SkipWhitespace(reader) == '}')
+	{
+		reader->mBufferOffset++;
+		return object;
+	}
+	
+	for (;;)
+	{
+		SkipWhitespace(reader);
+		if(NextByte(reader) != '"')
+			RaiseMalformedJSON(reader, @"a key");
+		
+		NSString *key = GetKeyAt(reader);
+		
+		SkipWhitespace(reader);
+		if(NextByte(reader) != ':')
+			RaiseMalformedJSON(reader, @"':'");
+		
+		[object setObject:GetValueAt(reader, depth + 1) forKey:key];
+		
+		SkipWhitespace(reader);
+		int byte = NextByte(reader);
+		if(byte == '}')
+			return object;
+		
+		if(byte != ',')
+			RaiseMalformedJSON(reader, @"',' or '}'");
+	}
+}
+
+static id GetValueAt(STJSONReader *reader, NSUInteger depth)
+{
+	if(depth > MAXIMUM_DEPTH)
+		RaiseMalformedJSON(reader, [NSString stringWithFormat:@"values nested at most %d levels deep", MAXIMUM_DEPTH]);
+	
+	int byte = SkipWhitespace(reader);
+	switch (byte)
+	{
+		case '{':
+			reader->mBufferOffset++;
+			return GetObjectAt(reader, depth);
+		
+		case '[':
+			reader->mBufferOffset++;
+			return GetArrayAt(reader, depth);
+		
+		case '"':
+			reader->mBufferOffset++;
+			return GetStringAt(reader);
+		
+		case 't':
+			ExpectLiteral(reader, "true");
+			return STTrue;
+		
+		case 'f':
+			ExpectLiteral(reader, "false");
+			return STFalse;
+		
+		case 'n':
+			ExpectLiteral(reader, "null");
+			return [NSNull null];
+		
+		default:
+			if(byte == '-' || (byte >= '0' && byte <= '9'))
+				return GetNumberAt(reader);
+			
+			RaiseMalformedJSON(reader, @"a value");
+	}
+}
+
+@implementation STJSONReader
+
+- (void)dealloc
+{
+	[self close];
+	
+	free(mBuffer);
+	free(mScratch);
+}
+
+- (id)initWithPath:(NSString *)path
+{
+	NSParameterAssert(path);
+	
+	if((self = [super init]))
+	{
+		mPath = [path copy];
+		mFileDescriptor = -1;
+		
+		mBuffer = malloc(BLOCK_SIZE);
+		NSAssert(mBuffer != NULL, @"Could not allocate JSON buffer.");
+		
+		//The file is opened up front so that missing files are reported when enumeration begins.
+		[self open];
+	}
+	
+	return self;
+}
+
+- (void)open
+{
+	if(mFileDescriptor != -1)
+		return;
+	
+	mFileDescriptor = open([mPath fileSystemRepresentation], O_RDONLY);
+	if(mFileDescriptor == -1)
+		[NSException raise:NSInvalidArgumentException format:@"Could not open file at path %@. Got error «%s».", mPath, strerror(errno)];
+	
+	struct stat fileInfo;
+	if(fstat(mFileDescriptor, &fileInfo) == -1)
+	{
+		int error = errno;
+		[self close];
+		[NSException raise:NSGenericException format:@"Could not get info for file at path %@. Got error «%s».", mPath, strerror(error)];
+	}
+	
+	if(!mHasOpenedFile)
+	{
+		mHasOpenedFile = YES;
+		mFileDevice = fileInfo.st_dev;
+		mFileNode = fileInfo.st_ino;
+	}
+	else if(fileInfo.st_dev != mFileDevice || fileInfo.st_ino != mFileNode)
+	{
+		[self close];
+		[NSException raise:NSGenericException format:@"File at path %@ was replaced while it was being read.", mPath];
+	}
+	
+	off_t fileOffset = (off_t)(mBufferPosition + mBufferLength);
+	if(fileOffset > 0 && lseek(mFileDescriptor, fileOffset, SEEK_SET) == -1)
+	{
+		int error = errno;
+		[self close];
+		[NSException raise:NSGenericException format:@"Could not seek in file at path %@. Got error «%s».", mPath, strerror(error)];
+	}
+}
+
+- (void)close
+{
+	if(mFileDescriptor != -1)
+	{
+		close(mFileDescriptor);
+		mFileDescriptor = -1;
+	}
+}
+
+#pragma mark - Reading
+
+///Mark the receiver as having yielded all of its values.
+- (id)finish
+{
+	mIsFinished = YES;
+	mIsAtEndOfFile = YES;
+	[self close];
+	
+	return nil;
+}
+
+- (id)nextObject
+{
+	if(mIsFinished)
+		return nil;
+	
+	//A file that starts with an array yields the elements of the array.
+	if(!mHasReadFirstByte)
+	{
+		mHasReadFirstByte = YES;
+		if(SkipWhitespace(self) == '[')
+		{
+			mBufferOffset++;
+			mIsReadingTopLevelArray = YES;
+		}
+	}
+	
+	if(mIsReadingTopLevelArray)
+	{
+		SkipWhitespace(self);
+		if(mHasReadTopLevelElement)
+		{
+			int byte = NextByte(self);
+			if(byte == ']')
+				return [self finish];
+			
+			if(byte != ',')
+				RaiseMalformedJSON(self, @"',' or ']'");
+		}
+		else if(PeekByte(self) == ']')
+		{
+			return [self finish];
+		}
+		
+		mHasReadTopLevelElement = YES;
+		return GetValueAt(self, 1);
+	}
+	
+	if(SkipWhitespace(self) == EOF)
+		return [self finish];
+	
+	return GetValueAt(self, 0);
+}
+
+- (NSUInteger)fillState:(NSFastEnumerationState *)state count:(NSUInteger)length
+{
+	NSUInteger count = 0;
+	@try
+	{
+		for (NSUInteger limit = MIN(length, BATCH_SIZE); count < limit; count++)
+		{
+			id object = [self nextObject];
+			if(!object)
+				break;
+			
+			mYieldedObjects[count] = object;
+		}
+	}
+	@finally
+	{
+		//As with file sequences, the file is only open while a batch is read, so loops that break do not leak it.
+		[self close];
+	}
+	
+	state->itemsPtr = (__unsafe_unretained id *)(void *)mYieldedObjects;
+	return count;
+}
+
+@end
+
+#pragma mark -
+
+@implementation STJSONSequence
+
+#pragma mark Creation
+
++ (STJSONSequence *)sequenceWithContentsOfFileAtPath:(NSString *)path
+{
+	NSParameterAssert(path);
+	
+	STJSONSequence *sequence = [self new];
+	sequence->mPath = [path copy];
+	return sequence;
+}
+
+#pragma mark - Properties
+
+@synthesize path = mPath;
+
+#pragma mark - Enumeration
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)len
+{
+	if(state->state == 0)
+	{
+		//As with file sequences, the reader lives in the enclosing autorelease pool for the duration of the loop,
+		//and only holds its file open while it fills each batch.
+		__autoreleasing STJSONReader *reader = [[STJSONReader alloc] initWithPath:mPath];
+		state->extra[0] = (unsigned long)(__bridge void *)reader;
+		state->mutationsPtr = &state->extra[1];
+		state->state = 1;
+	}
+	
+	STJSONReader *reader = (__bridge STJSONReader *)(void *)state->extra[0];
+	return [reader fillState:state count:len];
+}
+
+#pragma mark - STEnumerable
+
+- (id)foreach:(id <STFunction>)function
+{
+	STJSONReader *reader = [[STJSONReader alloc] initWithPath:mPath];
+	@try
+	{
+		for (id object = [reader nextObject]; object != nil; object = [reader nextObject])
+		{
+			@try
+			{
+				STFunctionApply(function, [[STList alloc] initWithObject:object]);
+			}
+			@catch (STBreakException *e)
+			{
+				break;
+			}
+			@catch (STContinueException *e)
+			{
+				continue;
+			}
+		}
+	}
+	@finally
+	{
+		[reader close];
+	}
+	
+	return self;
+}
+
+- (id)map:(id <STFunction>)function
+{
+	return [[STLazySequence sequenceWithSource:self] map:function];
+}
+
+- (id)filter:(id <STFunction>)function
+{
+	return [[STLazySequence sequenceWithSource:self] filter:function];
+}
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	return STEnumerableReduce(self, function, initial);
+}
+
+- (id)sum
+{
+	return STEnumerableSum(self);
+}
+
+- (id)min
+{
+	return STEnumerableMinimum(self);
+}
+
+- (id)max
+{
+	return STEnumerableMaximum(self);
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	return STEnumerableCount(self, function);
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	return STEnumerableGroup(self, function);
+}
+
+#pragma mark - Materializing
+
+- (NSArray *)toArray
+{
+	NSMutableArray *objects = [NSMutableArray array];
+	for (id object in self)
+	{
+		[objects addObject:object];
+	}
+	
+	return [objects copy];
+}
+
+#pragma mark - Printing
+
+- (NSString *)prettyDescription
+{
+	return [NSString stringWithFormat:@"<JSON values of %@>", [mPath prettyDescription]];
+}
+
+@end
+
+#pragma mark - Writing
+
+static void WriteJSONObject(id object, STOutput *output);
+
+static void WriteJSONString(NSString *string, STOutput *output)
+{
+	static NSCharacterSet *escapedCharacters = nil;
+	static dispatch_once_t predicate = 0;
+	dispatch_once(&predicate, ^{
+		NSMutableCharacterSet *characters = [NSMutableCharacterSet characterSetWithRange:NSMakeRange(0, 0x20)];
+		[characters addCharactersInString:@"\"\\"];
+		escapedCharacters = [characters copy];
+	});
+	
+	[output writeString:@"\""];
+	
+	//Write the runs of characters between the characters that must be escaped.
+	NSUInteger length = [string length];
+	NSRange remainingRange = NSMakeRange(0, length);
+	for (;;)
+	{
+		NSRange escapeRange = [string rangeOfCharacterFromSet:escapedCharacters options:NSLiteralSearch range:remainingRange];
+		if(escapeRange.location == NSNotFound)
+			break;
+		
+		if(escapeRange.location > remainingRange.location)
+			[output writeString:string range:NSMakeRange(remainingRange.location, escapeRange.location - remainingRange.location)];
+		
+		unichar character = [string characterAtIndex:escapeRange.location];
+		switch (character)
+		{
+			case '"':
+				[output writeBytes:"\\\"" length:2];
+				break;
+			
+			case '\\':
+				[output writeBytes:"\\\\" length:2];
+				break;
+			
+			case '\n':
+				[output writeBytes:"\\n" length:2];
+				break;
+			
+			case '\r':
+				[output writeBytes:"\\r" length:2];
+				break;
+			
+			case '\t':
+				[output writeBytes:"\\t" length:2];
+				break;
+			
+			default: {
+				char escape[8];
+				int escapeLength = snprintf(escape, sizeof(escape), "\\u%04x", character);
+				[output writeBytes:escape length:escapeLength];
+				break;
+			}
+		}
+		
+		remainingRange = NSMakeRange(NSMaxRange(escapeRange), length - NSMaxRange(escapeRange));
+	}
+	
+	if(remainingRange.location == 0)
+		[output writeString:string];
+	else if(remainingRange.length > 0)
+		[output writeString:string range:remainingRange];
+	
+	[output writeString:@"\""];
+}
+
+static void WriteJSONNumber(NSNumber *number, STOutput *output)
+{
+	if(number == STTrue)
+	{
+		[output writeBytes:"true" length:4];
+		return;
+	}
+	else if(number == STFalse)
+	{
+		[output writeBytes:"false" length:5];
+		return;
+	}
+	
+	if([number isKindOfClass:[NSDecimalNumber class]])
+	{
+		if([number isEqual:[NSDecimalNumber notANumber]])
+			[NSException raise:NSInvalidArgumentException format:@"NaN cannot be written as JSON."];
+		
+		[output writeString:[number stringValue]];
+		return;
+	}
+	
+	char numberString[32];
+	int numberLength;
+	char type = *[number objCType];
+	if(type == 'f' || type == 'd')
+	{
+		double value = [number doubleValue];
+		if(!isfinite(value))
+			[NSException raise:NSInvalidArgumentException format:@"%f cannot be written as JSON.", value];
+		
+		numberLength = snprintf(numberString, sizeof(numberString), "%.17g", value);
+	}
+	else if(type == 'Q' || type == 'L' || type == 'I')
+	{
+		numberLength = snprintf(numberString, sizeof(numberString), "%llu", [number unsignedLongLongValue]);
+	}
+	else
+	{
+		numberLength = snprintf(numberString, sizeof(numberString), "%lld", [number longLongValue]);
+	}
+	
+	[output writeBytes:numberString length:numberLength];
+}
+
+static void WriteJSONObject(id object, STOutput *output)
+{
+	if(!object || object == [NSNull null])
+	{
+		[output writeBytes:"null" length:4];
+	}
+	else if([object isKindOfClass:[NSString class]])
+	{
+		WriteJSONString(object, output);
+	}
+	else if([object isKindOfClass:[NSNumber class]])
+	{
+		WriteJSONNumber(object, output);
+	}
+	else if([object isKindOfClass:[NSDictionary class]])
+	{
+		[output writeString:@"{"];
+		
+		__block BOOL isFirstPair = YES;
+		[object enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+			if(!isFirstPair)
+				[output writeString:@","];
+			
+			WriteJSONString([key isKindOfClass:[NSString class]]? key : [key description], output);
+			[output writeString:@":"];
+			WriteJSONObject(value, output);
+			
+			isFirstPair = NO;
+		}];
+		
+		[output writeString:@"}"];
+	}
+	else if([object conformsToProtocol:@protocol(NSFastEnumeration)])
+	{
+		[output writeString:@"["];
+		
+		BOOL isFirstElement = YES;
+		for (id element in object)
+		{
+			if(!isFirstElement)
+				[output writeString:@","];
+			
+			WriteJSONObject(element, output);
+			isFirstElement = NO;
+		}
+		
+		[output writeString:@"]"];
+	}
+	else
+	{
+		[NSException raise:NSInvalidArgumentException format:@"%@ cannot be written as JSON.", [object prettyDescription]];
+	}
+}
+
+void STJSONWriteObject(id object, STOutput *output)
+{
+	NSCParameterAssert(output);
+	
+	[output lock];
+	@try
+	{
+		WriteJSONObject(object, output);
+	}
+	@finally
+	{
+		[output unlock];
+	}
+}
@@ -0,0 +1,73 @@
+//
+//  STLazySequence.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <Stein/STEnumerable.h>
+
+///The STLazySequence class represents a pipeline of operations over the contents of a collection
+///that is only performed when the contents of the pipeline are requested.
+///
+///Deriving a sequence with `-[STLazySequence map:]`, `-[STLazySequence filter:]`, and the other
+///stage methods does not touch the source collection. Instead, every stage is applied to each
+///object of the source in turn during a single pass when the sequence is enumerated, materialized
+///with `-[STLazySequence toArray]`, or reduced. No intermediate collections are created, and
+///objects are only taken from the source as they are needed.
+///
+///The source of a lazy sequence may be any collection that supports fast enumeration, a string,
+///or an index set. Strings yield their characters as numbers, and dictionaries yield their keys.
+///
+///Lazy sequences are created in Stein with the `lazy` function.
+@interface STLazySequence : NSObject < STEnumerable, NSFastEnumeration >
+{
+	id mSource;
+	NSArray *mStages;
+}
+
+///Returns a lazy sequence over the contents of a specified collection. If the collection
+///is already a lazy sequence it is returned as-is.
++ (STLazySequence *)sequenceWithSource:(id)source;
+
+#pragma mark - Properties
+
+///The collection the receiver takes its objects from.
+@property (readonly) id source;
+
+#pragma mark - Stages
+
+///Returns a sequence that yields the result of applying a function to each object of the receiver.
+///Objects that the function yields nil for are skipped.
+- (STLazySequence *)map:(id <STFunction>)function;
+
+///Returns a sequence that yields the objects of the receiver that a function returns true for.
+- (STLazySequence *)filter:(id <STFunction>)function;
+
+///Returns a sequence that yields at most a specified number of objects from the receiver.
+- (STLazySequence *)take:(NSUInteger)count;
+
+///Returns a sequence that yields the objects of the receiver after skipping a specified number of them.
+- (STLazySequence *)drop:(NSUInteger)count;
+
+///Returns a sequence that yields the objects of the receiver until a function returns false for one of them.
+- (STLazySequence *)takeWhile:(id <STFunction>)function;
+
+#pragma mark - Materializing
+
+///Apply a function to each object yielded by the receiver.
+- (id)foreach:(id <STFunction>)function;
+
+///Returns an array containing every object yielded by the receiver.
+- (NSArray *)toArray;
+
+///Combines the objects yielded by the receiver into a single value.
+///
+/// \param	function	A function that is given the combination of the previous objects, and the next object. Required.
+///
+/// \result	The last result of `function`, the only object yielded by the receiver, or nil if it yields no objects.
+- (id)reduce:(id <STFunction>)function;
+
+@end
@@ -0,0 +1,445 @@
+//
+//  STLazySequence.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STLazySequence.h"
+#import "STList.h"
+#import "NSObject+SteinTools.h"
+
+#define BATCH_SIZE	16
+
+#pragma mark Stages
+
+typedef enum STLazyStageKind {
+	kSTLazyStageKindMap = 0,
+	kSTLazyStageKindFilter,
+	kSTLazyStageKindTake,
+	kSTLazyStageKindDrop,
+	kSTLazyStageKindTakeWhile,
+} STLazyStageKind;
+
+///The STLazyStage class describes a single stage of a lazy sequence's pipeline.
+@interface STLazyStage : NSObject
+{
+@public
+	STLazyStageKind mKind;
+	id <STFunction> mFunction;
+	NSUInteger mCount;
+}
+
+@end
+
+@implementation STLazyStage
+
+@end
+
+#pragma mark - Enumerator
+
+///The STLazySequenceEnumerator class performs a single pass over the pipeline of a lazy sequence.
+@interface STLazySequenceEnumerator : NSEnumerator
+{
+	id mSource;
+	NSArray *mStages;
+	NSUInteger *mCounters;
+	
+	//Set when no further objects will be yielded.
+	BOOL mIsFinished;
+	
+	//Set when the object being processed is the last that will be yielded.
+	BOOL mIsFinishing;
+	
+	//Fast enumeration sources.
+	NSFastEnumerationState mSourceState;
+	__unsafe_unretained id mSourceBuffer[BATCH_SIZE];
+	NSUInteger mSourceBatchCount;
+	NSUInteger mSourceBatchIndex;
+	unsigned long mSourceMutations;
+	BOOL mHasSourceMutations;
+	
+	//String and index set sources.
+	NSUInteger mSourceIndex;
+	
+	//The objects most recently yielded through fast enumeration.
+	__strong id mYieldedObjects[BATCH_SIZE];
+}
+
+///Initialize the receiver to enumerate a specified source through a specified pipeline.
+- (id)initWithSource:(id)source stages:(NSArray *)stages;
+
+///Fill a specified fast enumeration state with the next batch of yielded objects.
+- (NSUInteger)fillState:(NSFastEnumerationState *)state count:(NSUInteger)length;
+
+@end
+
+@implementation STLazySequenceEnumerator
+
+- (void)dealloc
+{
+	free(mCounters);
+}
+
+- (id)initWithSource:(id)source stages:(NSArray *)stages
+{
+	NSParameterAssert(source);
+	NSParameterAssert(stages);
+	
+	if((self = [super init]))
+	{
+		mSource = source;
+		mStages = stages;
+		mCounters = calloc(MAX([stages count], 1), sizeof(NSUInteger));
+		mSourceIndex = [source isKindOfClass:[NSIndexSet class]]? [source firstIndex] : 0;
+		
+		for (STLazyStage *stage in stages)
+		{
+			if(stage->mKind == kSTLazyStageKindTake && stage->mCount == 0)
+				mIsFinished = YES;
+		}
+	}
+	
+	return self;
+}
+
+#pragma mark - Pulling
+
+///Returns the next object of the source, or nil if the source has been exhausted.
+- (id)nextSourceObject
+{
+	if([mSource isKindOfClass:[NSString class]])
+	{
+		if(mSourceIndex >= [mSource length])
+			return nil;
+		
+		return [NSNumber numberWithChar:[mSource characterAtIndex:mSourceIndex++]];
+	}
+	else if([mSource isKindOfClass:[NSIndexSet class]])
+	{
+		if(mSourceIndex == NSNotFound)
+			return nil;
+		
+		NSUInteger index = mSourceIndex;
+		mSourceIndex = [mSource indexGreaterThanIndex:index];
+		return [NSNumber numberWithUnsignedInteger:index];
+	}
+	
+	if(mSourceBatchIndex >= mSourceBatchCount)
+	{
+		mSourceBatchCount = [mSource countByEnumeratingWithState:&mSourceState objects:mSourceBuffer count:BATCH_SIZE];
+		mSourceBatchIndex = 0;
+		if(mSourceBatchCount == 0)
+			return nil;
+		
+		if(!mHasSourceMutations)
+		{
+			mSourceMutations = *mSourceState.mutationsPtr;
+			mHasSourceMutations = YES;
+		}
+		else if(mSourceMutations != *mSourceState.mutationsPtr)
+		{
+			[NSException raise:NSGenericException format:@"Collection %p was mutated while being lazily enumerated.", mSource];
+		}
+	}
+	
+	return mSourceState.itemsPtr[mSourceBatchIndex++];
+}
+
+///Applies the pipeline to a specified object, returning nil if the object should not be yielded.
+- (id)processObject:(id)object
+{
+	NSUInteger stageIndex = 0;
+	for (STLazyStage *stage in mStages)
+	{
+		switch (stage->mKind)
+		{
+			case kSTLazyStageKindMap:
+				object = STFunctionApply(stage->mFunction, [[STList alloc] initWithObject:object]);
+				if(!object)
+					return nil;
+				
+				break;
+			
+			case kSTLazyStageKindFilter:
+				if(!STIsTrue(STFunctionApply(stage->mFunction, [[STList alloc] initWithObject:object])))
+					return nil;
+				
+				break;
+			
+			case kSTLazyStageKindTake:
+				if(mCounters[stageIndex] >= stage->mCount)
+				{
+					mIsFinished = YES;
+					return nil;
+				}
+				
+				//Once the last object a take stage allows through has been seen, the source is
+				//not consulted again. This allows sequences over expensive sources to stop early.
+				if(++mCounters[stageIndex] == stage->mCount)
+					mIsFinishing = YES;
+				
+				break;
+			
+			case kSTLazyStageKindDrop:
+				if(mCounters[stageIndex] < stage->mCount)
+				{
+					mCounters[stageIndex]++;
+					return nil;
+				}
+				
+				break;
+			
+			case kSTLazyStageKindTakeWhile:
+				if(!STIsTrue(STFunctionApply(stage->mFunction, [[STList alloc] initWithObject:object])))
+				{
+					mIsFinished = YES;
+					return nil;
+				}
+				
+				break;
+		}
+		
+		stageIndex++;
+	}
+	
+	return object;
+}
+
+- (id)nextObject
+{
+	while (!mIsFinished)
+	{
+		id object = [self nextSourceObject];
+		if(!object)
+		{
+			mIsFinished = YES;
+			break;
+		}
+		
+		id result = nil;
+		@try
+		{
+			result = [self processObject:object];
+		}
+		@catch (STBreakException *e)
+		{
+			mIsFinished = YES;
+			break;
+		}
+		@catch (STContinueException *e)
+		{
+			result = nil;
+		}
+		
+		if(mIsFinishing)
+			mIsFinished = YES;
+		
+		if(result)
+			return result;
+	}
+	
+	return nil;
+}
+
+- (NSUInteger)fillState:(NSFastEnumerationState *)state count:(NSUInteger)length
+{
+	NSUInteger count = 0;
+	for (NSUInteger limit = MIN(length, BATCH_SIZE); count < limit; count++)
+	{
+		id object = [self nextObject];
+		if(!object)
+			break;
+		
+		mYieldedObjects[count] = object;
+	}
+	
+	state->itemsPtr = (__unsafe_unretained id *)(void *)mYieldedObjects;
+	return count;
+}
+
+@end
+
+#pragma mark -
+
+@implementation STLazySequence
+
++ (STLazySequence *)sequenceWithSource:(id)source
+{
+	NSParameterAssert(source);
+	
+	if([source isKindOfClass:[STLazySequence class]])
+		return source;
+	
+	if(![source conformsToProtocol:@protocol(NSFastEnumeration)] &&
+	   ![source isKindOfClass:[NSString class]] &&
+	   ![source isKindOfClass:[NSIndexSet class]])
+	{
+		[NSException raise:NSInvalidArgumentException format:@"Cannot create a lazy sequence over %@, it cannot be enumerated.", [source class]];
+	}
+	
+	STLazySequence *sequence = [self new];
+	sequence->mSource = source;
+	sequence->mStages = [NSArray array];
+	return sequence;
+}
+
+#pragma mark - Properties
+
+@synthesize source = mSource;
+
+#pragma mark - Stages
+
+///Returns a sequence over the receiver's source whose pipeline is the receiver's followed by a specified stage.
+- (STLazySequence *)sequenceByAddingStage:(STLazyStageKind)kind function:(id <STFunction>)function count:(NSUInteger)count
+{
+	STLazyStage *stage = [STLazyStage new];
+	stage->mKind = kind;
+	stage->mFunction = function;
+	stage->mCount = count;
+	
+	STLazySequence *sequence = [STLazySequence new];
+	sequence->mSource = mSource;
+	sequence->mStages = [mStages arrayByAddingObject:stage];
+	return sequence;
+}
+
+- (STLazySequence *)map:(id <STFunction>)function
+{
+	NSParameterAssert(function);
+	
+	return [self sequenceByAddingStage:kSTLazyStageKindMap function:function count:0];
+}
+
+- (STLazySequence *)filter:(id <STFunction>)function
+{
+	NSParameterAssert(function);
+	
+	return [self sequenceByAddingStage:kSTLazyStageKindFilter function:function count:0];
+}
+
+- (STLazySequence *)take:(NSUInteger)count
+{
+	return [self sequenceByAddingStage:kSTLazyStageKindTake function:nil count:count];
+}
+
+- (STLazySequence *)drop:(NSUInteger)count
+{
+	return [self sequenceByAddingStage:kSTLazyStageKindDrop function:nil count:count];
+}
+
+- (STLazySequence *)takeWhile:(id <STFunction>)function
+{
+	NSParameterAssert(function);
+	
+	return [self sequenceByAddingStage:kSTLazyStageKindTakeWhile function:function count:0];
+}
+
+#pragma mark - Enumeration
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)len
+{
+	if(state->state == 0)
+	{
+		//The enumerator is kept alive by the enclosing autorelease pool for the duration of the loop.
+		__autoreleasing STLazySequenceEnumerator *enumerator = [[STLazySequenceEnumerator alloc] initWithSource:mSource stages:mStages];
+		state->extra[0] = (unsigned long)(__bridge void *)enumerator;
+		state->mutationsPtr = &state->extra[1];
+		state->state = 1;
+	}
+	
+	STLazySequenceEnumerator *enumerator = (__bridge STLazySequenceEnumerator *)(void *)state->extra[0];
+	return [enumerator fillState:state count:len];
+}
+
+#pragma mark - Materializing
+
+- (id)foreach:(id <STFunction>)function
+{
+	for (id object in self)
+	{
+		@try
+		{
+			STFunctionApply(function, [[STList alloc] initWithObject:object]);
+		}
+		@catch (STBreakException *e)
+		{
+			break;
+		}
+		@catch (STContinueException *e)
+		{
+			continue;
+		}
+	}
+	
+	return self;
+}
+
+- (NSArray *)toArray
+{
+	NSMutableArray *objects = [NSMutableArray array];
+	for (id object in self)
+	{
+		[objects addObject:object];
+	}
+	
+	return [objects copy];
+}
+
+- (id)reduce:(id <STFunction>)function
+{
+	NSParameterAssert(function);
+	
+	STLazySequenceEnumerator *enumerator = [[STLazySequenceEnumerator alloc] initWithSource:mSource stages:mStages];
+	id firstObject = [enumerator nextObject];
+	if(!firstObject)
+		return nil;
+	
+	id result = firstObject;
+	for (id object = [enumerator nextObject]; object != nil; object = [enumerator nextObject])
+	{
+		result = STFunctionApply(function, [[STList alloc] initWithObjects:result, object, nil]);
+	}
+	
+	return result;
+}
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	return STEnumerableReduce(self, function, initial);
+}
+
+- (id)sum
+{
+	return STEnumerableSum(self);
+}
+
+- (id)min
+{
+	return STEnumerableMinimum(self);
+}
+
+- (id)max
+{
+	return STEnumerableMaximum(self);
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	return STEnumerableCount(self, function);
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	return STEnumerableGroup(self, function);
+}
+
+#pragma mark - Printing
+
+- (NSString *)prettyDescription
+{
+	return [NSString stringWithFormat:@"<lazy sequence over %@ with %lu stage(s)>", [mSource prettyDescription], (unsigned long)[mStages count]];
+}
+
+@end
@@ -18,11 +18,22 @@ enum STListFlags {
 typedef NSUInteger STListFlags;
 
 ///The STList class is used to represent s-expressions in the Stein language.
+///
+///Lists may share their contents with the lists they were copied or sliced from.
+///Copies, tails, and sublists are created in constant time as views onto the contents
+///of their source list, and a list only makes its own copy of the contents shared
+///with it the first time it is modified.
 @interface STList : NSObject < STEnumerable, NSFastEnumeration, NSCopying, NSCoding >
 {
-	NSMutableArray *mContents;
+	NSArray *mContents;
+	NSUInteger mOffset;
+	NSUInteger mCount;
+	volatile int32_t mSharesContents;
+	unsigned long mMutationCount;
+	
 	STListFlags mFlags;
 	STCreationLocation *mCreationLocation;
+	NSMutableDictionary *mCachedValues;
 }
 #pragma mark Creation
 
@@ -66,6 +77,8 @@ typedef NSUInteger STListFlags;
 ///Get the tail (everything but the first object) of the list.
 ///
 /// \result	The tail of the list; an empty list of the receiver has less than two elements.
+///
+///The tail shares the receiver's contents, and is created in constant time.
 - (STList *)tail;
 
 #pragma mark -
@@ -76,6 +89,8 @@ typedef NSUInteger STListFlags;
 ///Create a new autoreleased sublist with the contents of the receiver in the specified range.
 ///
 ///The list returned by this method inherits the receiver's evaluator, but does not inherit it's quote/do construct status.
+///
+///The sublist shares the receiver's contents, and is created in constant time.
 - (STList *)sublistWithRange:(NSRange)range;
 
 ///Create a new autoreleased sublist with the contents of the receiver from a specified index to the end of the list.
@@ -117,6 +132,22 @@ typedef NSUInteger STListFlags;
 ///Find the location of a specified object using a pointer comparison.
 - (NSUInteger)indexOfObjectIdenticalTo:(id)object;
 
+#pragma mark - Caching
+
+///Returns a value previously cached on the receiver for a specified key; nil if there is none.
+///
+///The interpreter uses the cache to store information derived from a list's
+///contents, so that it need only be computed the first time the list is evaluated.
+- (id)cachedValueForKey:(NSString *)key;
+
+///Caches a value derived from the receiver's contents under a specified key.
+///
+/// \param	value	The value to cache. Passing nil removes any value cached under `key`.
+/// \param	key		The key to cache the value under. May not be nil.
+///
+///All cached values are discarded when the receiver is modified.
+- (void)setCachedValue:(id)value forKey:(NSString *)key;
+
 #pragma mark - Properties
 
 ///Any flags specifying the structure of an STList object.
@@ -133,4 +164,15 @@ typedef NSUInteger STListFlags;
 ///All of the objects in the list in the form of an array.
 @property (readonly) NSArray *allObjects;
 
+#pragma mark - Parallel Enumeration
+
+///A version of `-[STList map:]` that applies a pure function across multiple threads. See `STEnumerableParallelMap`.
+- (STList *)pmap:(id <STFunction>)function;
+
+///A version of `-[STList filter:]` that applies a pure function across multiple threads. See `STEnumerableParallelFilter`.
+- (STList *)pfilter:(id <STFunction>)function;
+
+///Combines the list's objects with a pure, associative function across multiple threads. See `STEnumerableParallelReduce`.
+- (id)preduce:(id <STFunction>)function;
+
 @end
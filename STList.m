@@ -8,12 +8,51 @@
 
 #import "STList.h"
 #import "NSObject+SteinTools.h"
+#import "STOutput.h"
+#import "STAppendableCollections.h"
 #import <stdarg.h>
 #import <objc/message.h>
+#import <libkern/OSAtomic.h>
 
 @implementation STList
 
-#pragma mark Creation
+#pragma mark Storage
+
+///Gives the receiver sole ownership of its contents so that they may be modified, and returns them.
+///
+///This method must be called before any modification of the receiver's contents.
+///Contents shared with other lists are never modified in place.
+- (NSMutableArray *)willModifyContents
+{
+	if(mSharesContents || mOffset != 0 || mCount != [mContents count])
+	{
+		mContents = [[mContents subarrayWithRange:NSMakeRange(mOffset, mCount)] mutableCopy];
+		mOffset = 0;
+		mSharesContents = 0;
+	}
+	
+	mMutationCount++;
+	mCachedValues = nil;
+	
+	return (NSMutableArray *)mContents;
+}
+
+///Updates the receiver's window after its contents have been modified.
+- (void)didModifyContents
+{
+	mCount = [mContents count];
+}
+
+///Returns the receiver's contents as an array, without copying them if possible.
+- (NSArray *)contents
+{
+	if(mOffset == 0 && mCount == [mContents count])
+		return mContents;
+	
+	return [mContents subarrayWithRange:NSMakeRange(mOffset, mCount)];
+}
+
+#pragma mark - Creation
 
 - (id)init
 {
@@ -34,7 +73,8 @@
 	
 	if((self = [self init]))
 	{
-		[mContents setArray:array];
+		mContents = [array mutableCopy];
+		mCount = [mContents count];
 		
 		return self;
 	}
@@ -47,11 +87,21 @@
 {
 	NSParameterAssert(list);
 	
-	if((self = [self init]))
+	if((self = [super init]))
 	{
 		mFlags = list->mFlags;
-		mCreationLocation = list ->mCreationLocation;
-		[mContents setArray:list->mContents];
+		mCreationLocation = list->mCreationLocation;
+		
+		//The list's contents are shared until either list is modified.
+		mContents = list->mContents;
+		mOffset = list->mOffset;
+		mCount = list->mCount;
+		mSharesContents = 1;
+		
+		//Expressions are shared between threads that evaluate them at the same time, so the source
+		//list is marked atomically, and only if it is not already marked, as this is the common case.
+		if(!list->mSharesContents)
+			OSAtomicCompareAndSwap32Barrier(0, 1, &list->mSharesContents);
 		
 		return self;
 	}
@@ -64,7 +114,9 @@
 {
 	if((self = [self init]))
 	{
-		[mContents addObject:object];
+		mContents = [NSMutableArray arrayWithObject:object];
+		mCount = 1;
+		
 		return self;
 	}
 	return nil;
@@ -76,11 +128,14 @@
 	{
 		if(object)
 		{
-			[mContents addObject:object];
+			NSMutableArray *contents = [NSMutableArray arrayWithObject:object];
 			
 			id value = nil;
 			while ((value = va_arg(list, id)) != nil)
-				[mContents addObject:value];
+				[contents addObject:value];
+			
+			mContents = contents;
+			mCount = [mContents count];
 		}
 	}
 	
@@ -112,7 +167,8 @@
 	
 	if((self = [self init]))
 	{
-		mContents = [decoder decodeObjectForKey:@"mContents"];
+		mContents = [[decoder decodeObjectForKey:@"mContents"] mutableCopy] ?: [NSMutableArray new];
+		mCount = [mContents count];
 		mFlags = [decoder decodeIntegerForKey:@"mFlags"];
 		
 		return self;
@@ -124,7 +180,7 @@
 {
 	NSAssert([encoder allowsKeyedCoding], @"Non-keyed coder (%@) given to -[STList encodeWithCoder:].", encoder);
 	
-	[encoder encodeObject:mContents forKey:@"mContents"];
+	[encoder encodeObject:[self contents] forKey:@"mContents"];
 	[encoder encodeInteger:mFlags forKey:@"mFlags"];
 }
 
@@ -132,27 +188,32 @@
 
 - (id)head
 {
-	return ([mContents count] > 0)? [mContents objectAtIndex:0] : nil;
+	return (mCount > 0)? [mContents objectAtIndex:mOffset] : nil;
 }
 
 - (STList *)tail
 {
-	return ([mContents count] > 1)? [self sublistWithRange:NSMakeRange(1, [mContents count] - 1)] : [STList new];
+	return (mCount > 1)? [self sublistWithRange:NSMakeRange(1, mCount - 1)] : [STList new];
 }
 
 #pragma mark -
 
 - (id)objectAtIndex:(NSUInteger)index
 {
-	return [mContents objectAtIndex:index];
+	if(index >= mCount)
+		[NSException raise:NSRangeException format:@"Index %ld beyond bounds {0, %ld}", index, mCount];
+	
+	return [mContents objectAtIndex:mOffset + index];
 }
 
 - (STList *)sublistWithRange:(NSRange)range
 {
-	STList *sublist = [[STList alloc] initWithArray:[mContents subarrayWithRange:range]];
+	if(NSMaxRange(range) > mCount)
+		[NSException raise:NSRangeException format:@"Range %@ beyond bounds {0, %ld}", NSStringFromRange(range), mCount];
 	
-	sublist.creationLocation = mCreationLocation;
-	sublist.flags = mFlags;
+	STList *sublist = [[STList alloc] initWithList:self];
+	sublist->mOffset = mOffset + range.location;
+	sublist->mCount = range.length;
 	
 	return sublist;
 }
@@ -169,34 +230,40 @@
 
 - (void)addObject:(id)object
 {
-	[mContents addObject:object];
+	[[self willModifyContents] addObject:object];
+	[self didModifyContents];
 }
 
 - (void)addObjectsFromArray:(NSArray *)array
 {
-	[mContents addObjectsFromArray:array];
+	[[self willModifyContents] addObjectsFromArray:array];
+	[self didModifyContents];
 }
 
 - (void)insertObject:(id)object atIndex:(NSUInteger)index
 {
-	[mContents insertObject:object atIndex:index];
+	[[self willModifyContents] insertObject:object atIndex:index];
+	[self didModifyContents];
 }
 
 #pragma mark -
 
 - (void)removeObject:(id)object
 {
-	[mContents removeObject:object];
+	[[self willModifyContents] removeObject:object];
+	[self didModifyContents];
 }
 
 - (void)removeObjectsInArray:(NSArray *)array
 {
-	[mContents removeObjectsInArray:array];
+	[[self willModifyContents] removeObjectsInArray:array];
+	[self didModifyContents];
 }
 
 - (void)removeObjectAtIndex:(NSUInteger)index
 {
-	[mContents removeObjectAtIndex:index];
+	[[self willModifyContents] removeObjectAtIndex:index];
+	[self didModifyContents];
 }
 
 #pragma mark -
@@ -205,21 +272,59 @@
 {
 	NSParameterAssert(selector);
 	
+	NSMutableArray *contents = [self willModifyContents];
+	
 	for (NSInteger index = (self.count - 1); index >= 0; index--)
-		[mContents replaceObjectAtIndex:index
-                             withObject:objc_msgSend([mContents objectAtIndex:index], selector)];
+		[contents replaceObjectAtIndex:index
+                            withObject:objc_msgSend([contents objectAtIndex:index], selector)];
+}
+
+#pragma mark - Caching
+
+- (id)cachedValueForKey:(NSString *)key
+{
+	//Most lists never have values cached on them, so the lock is only taken when there may be one.
+	if(!mCachedValues)
+		return nil;
+	
+	@synchronized(self)
+	{
+		return [mCachedValues objectForKey:key];
+	}
+}
+
+- (void)setCachedValue:(id)value forKey:(NSString *)key
+{
+	NSParameterAssert(key);
+	
+	@synchronized(self)
+	{
+		if(value)
+		{
+			if(!mCachedValues)
+				mCachedValues = [NSMutableDictionary new];
+			
+			[mCachedValues setObject:value forKey:key];
+		}
+		else
+		{
+			[mCachedValues removeObjectForKey:key];
+		}
+	}
 }
 
 #pragma mark - Finding Objects
 
 - (NSUInteger)indexOfObject:(id)object
 {
-	return [mContents indexOfObject:object];
+	NSUInteger index = [mContents indexOfObject:object inRange:NSMakeRange(mOffset, mCount)];
+	return (index != NSNotFound)? index - mOffset : NSNotFound;
 }
 
 - (NSUInteger)indexOfObjectIdenticalTo:(id)object
 {
-	return [mContents indexOfObjectIdenticalTo:object];
+	NSUInteger index = [mContents indexOfObjectIdenticalTo:object inRange:NSMakeRange(mOffset, mCount)];
+	return (index != NSNotFound)? index - mOffset : NSNotFound;
 }
 
 #pragma mark - Identity
@@ -227,52 +332,56 @@
 - (BOOL)isEqualTo:(id)object
 {
 	if([object isKindOfClass:[STList class]])
-		return [mContents isEqualToArray:((STList *)object)->mContents];
+		return [[self contents] isEqualToArray:[(STList *)object contents]];
 	else if([object isKindOfClass:[NSArray class]])
-		return [mContents isEqualToArray:object];
+		return [[self contents] isEqualToArray:object];
 	
 	return [super isEqualTo:object];
 }
 
 - (NSString *)description
 {
-	return [NSString stringWithFormat:@"<%@#%p %@(%@)>", [self className], self, ST_FLAG_IS_SET(mFlags, kSTListFlagIsQuoted)? @"'" : @"", [mContents componentsJoinedByString:@" "]];
+	return [NSString stringWithFormat:@"<%@#%p %@(%@)>", [self className], self, ST_FLAG_IS_SET(mFlags, kSTListFlagIsQuoted)? @"'" : @"", [[self contents] componentsJoinedByString:@" "]];
 }
 
 - (NSString *)prettyDescription
+{
+	return [STOutput prettyDescriptionOfObject:self];
+}
+
+- (void)writePrettyDescriptionToOutput:(STOutput *)output
 {
 	//Format: (print "hello, world")
-	NSMutableString *description = [NSMutableString string];
 	
 	//Add the leading quote if we're a quoted string.
 	if(ST_FLAG_IS_SET(mFlags, kSTListFlagIsQuoted))
-		[description appendString:@"'"];
+		[output writeString:@"'"];
 	
 	
 	//Open the expression
 	if(ST_FLAG_IS_SET(mFlags, kSTListFlagIsDefinition))
-		[description appendString:@"{"];
+		[output writeString:@"{"];
 	else
-		[description appendString:@"("];
-	
+		[output writeString:@"("];
 	
-	//Get the pretty description for each element in our contents
-	for (id expression in mContents)
-		[description appendFormat:@"%@ ", [expression prettyDescription]];
 	
-	
-	//Remove the trailing space if we're non-empty
-	if([mContents count] > 0)
-		[description deleteCharactersInRange:NSMakeRange([description length] - 1, 1)];
+	//Write the pretty description for each element in our contents, separated by spaces
+	BOOL isFirstExpression = YES;
+	for (id expression in self)
+	{
+		if(!isFirstExpression)
+			[output writeString:@" "];
+		
+		[expression writePrettyDescriptionToOutput:output];
+		isFirstExpression = NO;
+	}
 	
 	
 	//Close the expression
 	if(ST_FLAG_IS_SET(mFlags, kSTListFlagIsDefinition))
-		[description appendString:@"}"];
+		[output writeString:@"}"];
 	else
-		[description appendString:@")"];
-	
-	return description;
+		[output writeString:@")"];
 }
 
 #pragma mark - Properties
@@ -284,21 +393,27 @@
 
 - (NSUInteger)count
 {
-	return [mContents count];
+	return mCount;
 }
 
 - (NSArray *)allObjects
 {
-	return [NSArray arrayWithArray:mContents];
+	return [NSArray arrayWithArray:[self contents]];
 }
 
 #pragma mark - Operators
 
 - (STList *)operatorAdd:(STList *)rightOperand
 {
+	//The result's contents are an appendable array, which extends the receiver's contents in place
+	//when they are an appendable array ending where the receiver does, and copies them otherwise.
+	//The result shares its contents, so it copies them before it is ever modified.
+	NSArray *contents = [STAppendableArray arrayWithArray:[self contents] byAppendingObjectsFromArray:[rightOperand allObjects]];
+	
 	STList *list = [STList new];
-	[list addObjectsFromArray:mContents];
-	[list addObjectsFromArray:[rightOperand allObjects]];
+	list->mContents = contents;
+	list->mCount = [contents count];
+	list->mSharesContents = 1;
 	return list;
 }
 
@@ -313,7 +428,20 @@
 
 - (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)len
 {
-	return [mContents countByEnumeratingWithState:state objects:buffer count:len];
+	//The window is enumerated in batches rather than with the enumerator of the contents, so that
+	//modifying the receiver, which replaces its contents when they are shared, is always detected.
+	NSUInteger position = state->state;
+	if(position >= mCount)
+		return 0;
+	
+	NSUInteger batchCount = MIN(len, mCount - position);
+	[mContents getObjects:buffer range:NSMakeRange(mOffset + position, batchCount)];
+	
+	state->state = position + batchCount;
+	state->itemsPtr = buffer;
+	state->mutationsPtr = &mMutationCount;
+	
+	return batchCount;
 }
 
 #pragma mark -
@@ -390,4 +518,58 @@
 	return filteredObjects;
 }
 
+#pragma mark - Aggregation
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	return STEnumerableReduce(self, function, initial);
+}
+
+- (id)sum
+{
+	return STEnumerableSum(self);
+}
+
+- (id)min
+{
+	return STEnumerableMinimum(self);
+}
+
+- (id)max
+{
+	return STEnumerableMaximum(self);
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	return STEnumerableCount(self, function);
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	NSMutableDictionary *groups = [NSMutableDictionary dictionary];
+	[STEnumerableGroup(self, function) enumerateKeysAndObjectsUsingBlock:^(id key, NSArray *objects, BOOL *stop) {
+		[groups setObject:[[STList alloc] initWithArray:objects] forKey:key];
+	}];
+	
+	return groups;
+}
+
+#pragma mark - Parallel Enumeration
+
+- (STList *)pmap:(id <STFunction>)function
+{
+	return [[STList alloc] initWithArray:STEnumerableParallelMap(self.allObjects, function)];
+}
+
+- (STList *)pfilter:(id <STFunction>)function
+{
+	return [[STList alloc] initWithArray:STEnumerableParallelFilter(self.allObjects, function)];
+}
+
+- (id)preduce:(id <STFunction>)function
+{
+	return STEnumerableParallelReduce(self.allObjects, function);
+}
+
 @end
@@ -0,0 +1,86 @@
+//
+//  STMacro.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <Stein/STFunction.h>
+
+@class STList, STScope;
+
+///The STMacro class is responsible for representing macros in Stein.
+///
+///A macro is a function that is given the unevaluated arguments of a form, and
+///yields the expression that the form should be replaced with. The first time a
+///form naming a macro is evaluated its expansion is cached on the form, and every
+///later evaluation of the form evaluates the cached expansion directly.
+///
+///Macros are created in Stein with the `defmacro` function.
+@interface STMacro : NSObject <STFunction>
+{
+	NSString *mName;
+	NSObject <STFunction> *mTransformer;
+	
+	NSUInteger mExpansionCount;
+	NSUInteger mCachedExpansionCount;
+}
+
+///Initialize the receiver with a specified name and transformer.
+///
+/// \param		name		The name of the macro. May not be nil.
+/// \param		transformer	The function that is applied to the unevaluated arguments of a form to yield its expansion. May not be nil.
+/// \result		A fully initialized macro.
+///
+///This is the designated initializer of STMacro.
+- (id)initWithName:(NSString *)name transformer:(NSObject <STFunction> *)transformer;
+
+#pragma mark - Properties
+
+///The name of the macro.
+@property (copy) NSString *name;
+
+///The function that yields the expansions of the macro.
+@property (readonly) NSObject <STFunction> *transformer;
+
+#pragma mark - Expansion
+
+///Returns the expansion of a specified form whose head names the receiver,
+///expanding the form and caching the expansion on it if it has not been expanded before.
+///
+/// \param	form	The form to expand. Required.
+/// \param	scope	The scope the form is being evaluated in. Required.
+///
+/// \result	The expression the form should be evaluated as.
+- (id)expansionOfForm:(STList *)form inScope:(STScope *)scope;
+
+#pragma mark - Statistics
+
+///The number of times the receiver has expanded a form.
+@property (readonly) NSUInteger expansionCount;
+
+///The number of times a form has been evaluated using an expansion previously cached by the receiver.
+@property (readonly) NSUInteger cachedExpansionCount;
+
+@end
+
+#pragma mark -
+
+///Returns the expansion previously cached on a form by a macro, or nil if the form has not been expanded.
+ST_EXTERN id STMacroCachedExpansionOfForm(STList *form);
+
+///Returns a dictionary describing the expansions performed by all macros, containing the
+///total number of `expansions`, and the number of evaluations that used `cached-expansions`.
+ST_EXTERN NSDictionary *STMacroExpansionStatistics();
+
+///Instantiates a quasiquote template.
+///
+/// \param	form	The template to instantiate. Required.
+/// \param	scope	The scope to evaluate unquoted expressions in. Required.
+///
+/// \result	A copy of `form` where every `(unquote expression)` form has been replaced with
+///			the value of `expression`, and every `(unquote-splicing expression)` form has been
+///			replaced with the contents of the list or array `expression` evaluates to.
+ST_EXTERN id STQuasiquote(id form, STScope *scope);
@@ -0,0 +1,224 @@
+//
+//  STMacro.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STMacro.h"
+#import "STList.h"
+#import "STSymbol.h"
+#import "STInterpreter.h"
+#import "STScope.h"
+
+///The key under which the expansion of a form is cached.
+static NSString *const kExpansionCacheKey = @"STMacroExpansion";
+
+///The STMacroExpansion class associates a cached expansion with the macro that produced it.
+@interface STMacroExpansion : NSObject
+{
+@public
+	STMacro *macro;
+	id expression;
+}
+
+@end
+
+@implementation STMacroExpansion
+
+@end
+
+#pragma mark -
+
+static volatile int64_t TotalExpansionCount = 0;
+static volatile int64_t TotalCachedExpansionCount = 0;
+
+@interface STMacro ()
+
+///Records that a form was evaluated using an expansion cached by the receiver.
+- (void)noteCachedExpansionUsed;
+
+@end
+
+@implementation STMacro
+
+#pragma mark Initialization
+
+- (id)init
+{
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (id)initWithName:(NSString *)name transformer:(NSObject <STFunction> *)transformer
+{
+	NSParameterAssert(name);
+	NSParameterAssert(transformer);
+	
+	if((self = [super init]))
+	{
+		mName = [name copy];
+		mTransformer = transformer;
+	}
+	
+	return self;
+}
+
+- (NSString *)description
+{
+	return [NSString stringWithFormat:@"<%@:%p %@>", [self className], self, mName];
+}
+
+#pragma mark - Properties
+
+@synthesize name = mName;
+@synthesize transformer = mTransformer;
+
+#pragma mark - Expansion
+
+///Returns a copy of an expansion suitable for evaluation in place of a specified form.
+static id PrepareExpansion(id expansion, STList *form)
+{
+	if(![expansion isKindOfClass:[STList class]])
+		return expansion;
+	
+	//Templates are written as quoted lists, but their expansions are code.
+	STList *list = [expansion copy];
+	if(!ST_FLAG_IS_SET(list.flags, kSTListFlagIsDefinition))
+		list.flags &= ~kSTListFlagIsQuoted;
+	
+	if(!list.creationLocation)
+		list.creationLocation = form.creationLocation;
+	
+	return list;
+}
+
+- (id)expansionOfForm:(STList *)form inScope:(STScope *)scope
+{
+	NSParameterAssert(form);
+	
+	STMacroExpansion *cachedExpansion = [form cachedValueForKey:kExpansionCacheKey];
+	if(cachedExpansion && cachedExpansion->macro == self)
+	{
+		[self noteCachedExpansionUsed];
+		return cachedExpansion->expression;
+	}
+	
+	id expression = PrepareExpansion([mTransformer applyWithArguments:[form tail] inScope:scope], form);
+	__sync_add_and_fetch(&TotalExpansionCount, 1);
+	__sync_add_and_fetch(&mExpansionCount, 1);
+	
+	STMacroExpansion *expansion = [STMacroExpansion new];
+	expansion->macro = self;
+	expansion->expression = expression;
+	[form setCachedValue:expansion forKey:kExpansionCacheKey];
+	
+	return expression;
+}
+
+#pragma mark - Statistics
+
+@synthesize expansionCount = mExpansionCount;
+@synthesize cachedExpansionCount = mCachedExpansionCount;
+
+- (void)noteCachedExpansionUsed
+{
+	__sync_add_and_fetch(&TotalCachedExpansionCount, 1);
+	__sync_add_and_fetch(&mCachedExpansionCount, 1);
+}
+
+#pragma mark - Implementing STFunction
+
+- (STScope *)superscope
+{
+	return [mTransformer superscope];
+}
+
+- (BOOL)evaluatesOwnArguments
+{
+	return YES;
+}
+
+- (id)applyWithArguments:(STList *)arguments inScope:(STScope *)scope
+{
+	//Forms naming a macro are expanded by the interpreter before they are applied,
+	//so this is only reached when a macro is applied indirectly, such as with `apply`.
+	id expansion = PrepareExpansion([mTransformer applyWithArguments:arguments inScope:scope], arguments);
+	__sync_add_and_fetch(&TotalExpansionCount, 1);
+	__sync_add_and_fetch(&mExpansionCount, 1);
+	
+	return STEvaluate(expansion, scope);
+}
+
+@end
+
+#pragma mark -
+
+id STMacroCachedExpansionOfForm(STList *form)
+{
+	STMacroExpansion *cachedExpansion = [form cachedValueForKey:kExpansionCacheKey];
+	if(!cachedExpansion)
+		return nil;
+	
+	[cachedExpansion->macro noteCachedExpansionUsed];
+	return cachedExpansion->expression;
+}
+
+NSDictionary *STMacroExpansionStatistics()
+{
+	return [NSDictionary dictionaryWithObjectsAndKeys:
+			[NSNumber numberWithLongLong:TotalExpansionCount], @"expansions",
+			[NSNumber numberWithLongLong:TotalCachedExpansionCount], @"cached-expansions",
+			nil];
+}
+
+#pragma mark - Quasiquotation
+
+///Returns whether or not an expression is a form whose head is a symbol with a specified name.
+static BOOL IsFormNamed(id expression, NSString *name)
+{
+	if(![expression isKindOfClass:[STList class]] || [expression count] != 2)
+		return NO;
+	
+	id head = [expression head];
+	return [head isKindOfClass:[STSymbol class]] && [[head string] isEqualToString:name];
+}
+
+id STQuasiquote(id form, STScope *scope)
+{
+	NSCParameterAssert(scope);
+	
+	if(![form isKindOfClass:[STList class]])
+		return form;
+	
+	if(IsFormNamed(form, @"unquote"))
+		return STEvaluate([form objectAtIndex:1], scope);
+	
+	//Lists are always copied, as the interpreter modifies definitions the first time they are evaluated.
+	STList *result = [[STList alloc] init];
+	result.flags = [form flags];
+	result.creationLocation = [form creationLocation];
+	for (id expression in form)
+	{
+		if(IsFormNamed(expression, @"unquote-splicing"))
+		{
+			id values = STEvaluate([expression objectAtIndex:1], scope);
+			if([values isKindOfClass:[STList class]] || [values isKindOfClass:[NSArray class]])
+			{
+				for (id value in values)
+					[result addObject:value];
+			}
+			else if(!STIsNull(values))
+			{
+				STRaiseIssue([expression creationLocation], @"Wrong type given for unquote-splicing, got %@, expected STList|NSArray.", [values className]);
+			}
+		}
+		else
+		{
+			[result addObject:STQuasiquote(expression, scope)];
+		}
+	}
+	
+	return result;
+}
@@ -0,0 +1,122 @@
+//
+//  STMemoizedFunction.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <Stein/STFunction.h>
+
+@class STMemoizationCacheEntry;
+
+///The number of results a memoization cache keeps when no capacity is specified.
+ST_EXTERN NSUInteger const kSTMemoizationCacheDefaultCapacity;
+
+#pragma mark -
+
+///The STMemoizationCache class is responsible for storing the results of function
+///calls keyed by their arguments, evicting the least recently used result once
+///a fixed capacity has been reached.
+///
+///Arguments are compared structurally: STLists and NSArrays are equal when their
+///contents are equal, all other objects are compared with `-[NSObject isEqual:]`.
+@interface STMemoizationCache : NSObject
+{
+	NSUInteger mCapacity;
+	NSLock *mLock;
+	
+	NSMutableDictionary *mEntries;
+	STMemoizationCacheEntry *mMostRecentEntry;
+	STMemoizationCacheEntry *mLeastRecentEntry;
+	
+	NSUInteger mHits;
+	NSUInteger mMisses;
+	NSUInteger mEvictions;
+}
+
+///Initialize the receiver with a specified capacity.
+///
+/// \param		capacity		The maximum number of results the cache may hold. Must be greater than zero.
+/// \param		isThreadSafe	Whether or not the cache may be used from multiple threads at once.
+/// \result		A fully initialized, empty cache.
+///
+///This is the designated initializer of STMemoizationCache.
+- (id)initWithCapacity:(NSUInteger)capacity threadSafe:(BOOL)isThreadSafe;
+
+#pragma mark - Properties
+
+///The maximum number of results the receiver may hold.
+@property (readonly) NSUInteger capacity;
+
+///Whether or not the receiver may be used from multiple threads at once.
+@property (readonly) BOOL isThreadSafe;
+
+///The number of results currently held by the receiver.
+@property (readonly) NSUInteger count;
+
+#pragma mark - Results
+
+///Returns the result stored for a specified array of arguments, or nil if there is none.
+///
+///Each call to this method is counted as either a hit or a miss.
+- (id)resultForArguments:(NSArray *)arguments;
+
+///Stores a result for a specified array of arguments, evicting the least recently used result if the receiver is full.
+///
+///The arguments are copied deeply, so changing them afterwards does not affect the stored result.
+- (void)setResult:(id)result forArguments:(NSArray *)arguments;
+
+///Removes all of the results held by the receiver. The receiver's statistics are not reset.
+- (void)removeAllResults;
+
+#pragma mark - Statistics
+
+///The number of lookups that found a result.
+@property (readonly) NSUInteger hits;
+
+///The number of lookups that did not find a result.
+@property (readonly) NSUInteger misses;
+
+///The number of results removed to make room for newer results.
+@property (readonly) NSUInteger evictions;
+
+///A dictionary containing the receiver's `hits`, `misses`, `evictions`, `count`, and `capacity`.
+@property (readonly) NSDictionary *statistics;
+
+@end
+
+#pragma mark -
+
+///The STMemoizedFunction class is responsible for wrapping a function object so
+///that calling it repeatedly with the same arguments only applies it once.
+///
+///A memoized function is only reported as pure when its function is pure and its cache is
+///thread-safe, so that parallel operations never share a cache that is not.
+///
+///Memoized functions are created in Stein with the `memoize` function.
+@interface STMemoizedFunction : NSObject <STFunction>
+{
+	NSObject <STFunction> *mFunction;
+	STMemoizationCache *mCache;
+}
+
+///Initialize the receiver with a function to wrap, and a cache to store its results in.
+///
+/// \param		function	The function to memoize. May not be nil. May not evaluate its own arguments.
+/// \param		cache		The cache to store the results of the function in. May not be nil.
+/// \result		A fully initialized memoized function.
+///
+///This is the designated initializer of STMemoizedFunction.
+- (id)initWithFunction:(NSObject <STFunction> *)function cache:(STMemoizationCache *)cache;
+
+#pragma mark - Properties
+
+///The function whose results the receiver caches.
+@property (readonly) NSObject <STFunction> *function;
+
+///The cache the receiver stores results in.
+@property (readonly) STMemoizationCache *cache;
+
+@end
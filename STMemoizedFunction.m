@@ -0,0 +1,435 @@
+//
+//  STMemoizedFunction.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STMemoizedFunction.h"
+#import "STList.h"
+
+NSUInteger const kSTMemoizationCacheDefaultCapacity = 1024;
+
+#pragma mark Structural Keys
+
+///Returns a copy of a set of arguments that later changes to the arguments cannot affect.
+///
+///Lists and arrays are copied into arrays of copies of their elements, which StructurallyEqual
+///and StructuralHash treat the same. Other objects are copied if they support copying.
+static id FrozenCopy(id object)
+{
+	if([object isKindOfClass:[NSArray class]] || [object isKindOfClass:[STList class]])
+	{
+		NSMutableArray *elements = [NSMutableArray arrayWithCapacity:[object count]];
+		for (id element in object)
+			[elements addObject:FrozenCopy(element)];
+		
+		return [elements copy];
+	}
+	else if([object conformsToProtocol:@protocol(NSCopying)])
+	{
+		return [object copy];
+	}
+	
+	return object;
+}
+
+///Returns a hash for an object that is consistent with StructurallyEqual.
+static NSUInteger StructuralHash(id object)
+{
+	if([object isKindOfClass:[NSArray class]] || [object isKindOfClass:[STList class]])
+	{
+		NSUInteger hash = [object count];
+		for (id element in object)
+			hash = (hash * 31) + StructuralHash(element);
+		
+		return hash;
+	}
+	
+	return [object hash];
+}
+
+///Returns whether or not two objects are equal, comparing lists and arrays by their contents.
+static BOOL StructurallyEqual(id left, id right)
+{
+	if(left == right)
+		return YES;
+	
+	BOOL isLeftCollection = ([left isKindOfClass:[NSArray class]] || [left isKindOfClass:[STList class]]);
+	BOOL isRightCollection = ([right isKindOfClass:[NSArray class]] || [right isKindOfClass:[STList class]]);
+	if(isLeftCollection || isRightCollection)
+	{
+		if(!isLeftCollection || !isRightCollection || [left count] != [right count])
+			return NO;
+		
+		NSUInteger index = 0;
+		for (id element in left)
+		{
+			if(!StructurallyEqual(element, [right objectAtIndex:index++]))
+				return NO;
+		}
+		
+		return YES;
+	}
+	
+	return [left isEqual:right];
+}
+
+///The STMemoizationKey class wraps the arguments of a function call so that
+///they may be used as a key in a dictionary, hashing and comparing collections
+///of arguments by their contents.
+@interface STMemoizationKey : NSObject <NSCopying>
+{
+	NSArray *mArguments;
+	NSUInteger mHash;
+}
+
+///Initialize the receiver with the arguments of a call.
+- (id)initWithArguments:(NSArray *)arguments;
+
+@end
+
+@implementation STMemoizationKey
+
+- (id)initWithArguments:(NSArray *)arguments
+{
+	NSParameterAssert(arguments);
+	
+	if((self = [super init]))
+	{
+		mArguments = arguments;
+		mHash = StructuralHash(arguments);
+	}
+	
+	return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	return self;
+}
+
+- (NSUInteger)hash
+{
+	return mHash;
+}
+
+- (BOOL)isEqual:(id)object
+{
+	if(![object isKindOfClass:[STMemoizationKey class]])
+		return NO;
+	
+	STMemoizationKey *otherKey = object;
+	return (mHash == otherKey->mHash && StructurallyEqual(mArguments, otherKey->mArguments));
+}
+
+@end
+
+#pragma mark - Cache Entries
+
+///The STMemoizationCacheEntry class represents a single result in a memoization
+///cache. Entries are kept in a list ordered from most to least recently used.
+@interface STMemoizationCacheEntry : NSObject
+{
+@public
+	STMemoizationKey *key;
+	id result;
+	
+	__unsafe_unretained STMemoizationCacheEntry *previous;
+	STMemoizationCacheEntry *next;
+}
+
+@end
+
+@implementation STMemoizationCacheEntry
+
+@end
+
+#pragma mark -
+
+@implementation STMemoizationCache
+
+#pragma mark Initialization
+
+- (id)init
+{
+	return [self initWithCapacity:kSTMemoizationCacheDefaultCapacity threadSafe:NO];
+}
+
+- (id)initWithCapacity:(NSUInteger)capacity threadSafe:(BOOL)isThreadSafe
+{
+	NSParameterAssert(capacity > 0);
+	
+	if((self = [super init]))
+	{
+		mCapacity = capacity;
+		if(isThreadSafe)
+			mLock = [NSLock new];
+		
+		mEntries = [NSMutableDictionary new];
+	}
+	
+	return self;
+}
+
+- (NSString *)description
+{
+	return [NSString stringWithFormat:@"<%@:%p %ld of %ld results, %ld hits, %ld misses, %ld evictions>",
+			[self className], self, (long)self.count, (long)mCapacity, (long)self.hits, (long)self.misses, (long)self.evictions];
+}
+
+#pragma mark - Properties
+
+@synthesize capacity = mCapacity;
+
+- (BOOL)isThreadSafe
+{
+	return (mLock != nil);
+}
+
+- (NSUInteger)count
+{
+	[mLock lock];
+	NSUInteger count = mEntries.count;
+	[mLock unlock];
+	
+	return count;
+}
+
+#pragma mark - Recency
+
+///Removes an entry from the receiver's recency list.
+- (void)unlinkEntry:(STMemoizationCacheEntry *)entry
+{
+	if(entry->previous)
+		entry->previous->next = entry->next;
+	else
+		mMostRecentEntry = entry->next;
+	
+	if(entry->next)
+		entry->next->previous = entry->previous;
+	else
+		mLeastRecentEntry = entry->previous;
+	
+	entry->previous = nil;
+	entry->next = nil;
+}
+
+///Places an entry at the front of the receiver's recency list.
+- (void)linkMostRecentEntry:(STMemoizationCacheEntry *)entry
+{
+	entry->previous = nil;
+	entry->next = mMostRecentEntry;
+	if(mMostRecentEntry)
+		mMostRecentEntry->previous = entry;
+	
+	mMostRecentEntry = entry;
+	if(!mLeastRecentEntry)
+		mLeastRecentEntry = entry;
+}
+
+#pragma mark - Results
+
+- (id)resultForArguments:(NSArray *)arguments
+{
+	NSParameterAssert(arguments);
+	
+	STMemoizationKey *key = [[STMemoizationKey alloc] initWithArguments:arguments];
+	
+	[mLock lock];
+	
+	id result = nil;
+	STMemoizationCacheEntry *entry = [mEntries objectForKey:key];
+	if(entry)
+	{
+		if(entry != mMostRecentEntry)
+		{
+			[self unlinkEntry:entry];
+			[self linkMostRecentEntry:entry];
+		}
+		
+		result = entry->result;
+		mHits++;
+	}
+	else
+	{
+		mMisses++;
+	}
+	
+	[mLock unlock];
+	
+	return result;
+}
+
+- (void)setResult:(id)result forArguments:(NSArray *)arguments
+{
+	NSParameterAssert(result);
+	NSParameterAssert(arguments);
+	
+	STMemoizationKey *key = [[STMemoizationKey alloc] initWithArguments:FrozenCopy(arguments)];
+	
+	[mLock lock];
+	
+	STMemoizationCacheEntry *entry = [mEntries objectForKey:key];
+	if(entry)
+	{
+		entry->result = result;
+		[self unlinkEntry:entry];
+	}
+	else
+	{
+		if(mEntries.count >= mCapacity)
+		{
+			STMemoizationCacheEntry *leastRecentEntry = mLeastRecentEntry;
+			[self unlinkEntry:leastRecentEntry];
+			[mEntries removeObjectForKey:leastRecentEntry->key];
+			mEvictions++;
+		}
+		
+		entry = [STMemoizationCacheEntry new];
+		entry->key = key;
+		entry->result = result;
+		[mEntries setObject:entry forKey:key];
+	}
+	
+	[self linkMostRecentEntry:entry];
+	
+	[mLock unlock];
+}
+
+- (void)removeAllResults
+{
+	[mLock lock];
+	
+	//Entries are released one at a time so that clearing a large cache does not recurse through the list.
+	while (mMostRecentEntry)
+		[self unlinkEntry:mMostRecentEntry];
+	
+	[mEntries removeAllObjects];
+	
+	[mLock unlock];
+}
+
+- (void)dealloc
+{
+	while (mMostRecentEntry)
+		[self unlinkEntry:mMostRecentEntry];
+}
+
+#pragma mark - Statistics
+
+- (NSUInteger)hits
+{
+	[mLock lock];
+	NSUInteger hits = mHits;
+	[mLock unlock];
+	
+	return hits;
+}
+
+- (NSUInteger)misses
+{
+	[mLock lock];
+	NSUInteger misses = mMisses;
+	[mLock unlock];
+	
+	return misses;
+}
+
+- (NSUInteger)evictions
+{
+	[mLock lock];
+	NSUInteger evictions = mEvictions;
+	[mLock unlock];
+	
+	return evictions;
+}
+
+- (NSDictionary *)statistics
+{
+	[mLock lock];
+	NSDictionary *statistics = [NSDictionary dictionaryWithObjectsAndKeys:
+								[NSNumber numberWithUnsignedInteger:mHits], @"hits",
+								[NSNumber numberWithUnsignedInteger:mMisses], @"misses",
+								[NSNumber numberWithUnsignedInteger:mEvictions], @"evictions",
+								[NSNumber numberWithUnsignedInteger:mEntries.count], @"count",
+								[NSNumber numberWithUnsignedInteger:mCapacity], @"capacity",
+								nil];
+	[mLock unlock];
+	
+	return statistics;
+}
+
+@end
+
+#pragma mark -
+
+@implementation STMemoizedFunction
+
+#pragma mark Initialization
+
+- (id)init
+{
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (id)initWithFunction:(NSObject <STFunction> *)function cache:(STMemoizationCache *)cache
+{
+	NSParameterAssert(function);
+	NSParameterAssert(![function evaluatesOwnArguments]);
+	NSParameterAssert(cache);
+	
+	if((self = [super init]))
+	{
+		mFunction = function;
+		mCache = cache;
+	}
+	
+	return self;
+}
+
+- (NSString *)description
+{
+	return [NSString stringWithFormat:@"<%@:%p memoizing %@>", [self className], self, mFunction];
+}
+
+#pragma mark - Properties
+
+@synthesize function = mFunction;
+@synthesize cache = mCache;
+
+#pragma mark - Implementing STFunction
+
+- (STScope *)superscope
+{
+	return [mFunction superscope];
+}
+
+- (BOOL)evaluatesOwnArguments
+{
+	return NO;
+}
+
+- (BOOL)isPure
+{
+	//Pure functions may be applied from several threads at once, which only a thread-safe cache allows.
+	return [mCache isThreadSafe] && [mFunction respondsToSelector:@selector(isPure)] && [mFunction isPure];
+}
+
+- (id)applyWithArguments:(STList *)arguments inScope:(STScope *)scope
+{
+	NSArray *argumentObjects = arguments.allObjects;
+	id result = [mCache resultForArguments:argumentObjects];
+	if(!result)
+	{
+		result = [mFunction applyWithArguments:arguments inScope:scope];
+		if(result)
+			[mCache setResult:result forArguments:argumentObjects];
+	}
+	
+	return result;
+}
+
+@end
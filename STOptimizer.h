@@ -0,0 +1,96 @@
+//
+//  STOptimizer.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class STScope;
+
+///The block type used to implement an optimizer pass.
+///
+/// \param	expressions	The expressions to optimize, in the form returned by `STParseString`.
+/// \param	scope		The scope the expressions will be evaluated in. Optional.
+///
+/// \result	The optimized expressions. Passes must not modify the expressions they are given.
+typedef NSArray *(^STOptimizerPass)(NSArray *expressions, STScope *scope);
+
+#pragma mark Built In Passes
+
+///The name of the pass that evaluates arithmetic and comparisons whose operands are all literals.
+ST_EXTERN NSString *const kSTOptimizerPassConstantFolding;
+
+///The name of the pass that replaces references to literals bound with `let` with the literals themselves.
+///
+///Any closure or method could rebind a name with `set!`, so the pass leaves expressions untouched
+///unless they only call pure built in functions, `let`, `set!`, `decide`, and infix arithmetic on literals.
+ST_EXTERN NSString *const kSTOptimizerPassLiteralInlining;
+
+///The name of the pass that removes `decide` branches whose conditions are constant.
+ST_EXTERN NSString *const kSTOptimizerPassDeadBranchElimination;
+
+///The name of the pass that replaces calls to small non-recursive closures with their bodies.
+ST_EXTERN NSString *const kSTOptimizerPassClosureInlining;
+
+///The name of the pass that evaluates repeated calls to pure functions within a statement only once.
+///
+///Statements are only rewritten when they call nothing but pure built in functions, so that no closure or
+///method can rebind a variable between the occurrences. Each repeated call is passed to a closure that
+///evaluates the statement, so its temporary is never bound in the statement's own scope.
+ST_EXTERN NSString *const kSTOptimizerPassCommonSubexpressionElimination;
+
+#pragma mark -
+
+///The STOptimizer class is responsible for rewriting parsed Stein expressions
+///into equivalent expressions that are cheaper to evaluate.
+///
+///An optimizer is a pipeline of named passes that are run in the order they were
+///added. Each pass may be turned on and off individually. Newly created optimizers
+///contain the built in passes in the order: literal inlining, closure inlining,
+///constant folding, dead branch elimination, common subexpression elimination.
+///
+///The built in passes only consider bindings made within the expressions being
+///optimized, and leave expressions that use `eval`, `load`, `include`, `require`,
+///`unset!`, `defmacro`, or `$_here` untouched.
+@interface STOptimizer : NSObject
+{
+	NSMutableArray *mPassNames;
+	NSMutableDictionary *mPasses;
+	NSMutableSet *mDisabledPassNames;
+}
+
+#pragma mark Passes
+
+///Adds a pass to the end of the receiver's pipeline.
+///
+/// \param	name	The name of the pass. May not be nil.
+/// \param	pass	The block implementing the pass. May not be nil.
+///
+///Adding a pass with the name of an existing pass replaces the existing pass in place.
+- (void)addPassNamed:(NSString *)name usingBlock:(STOptimizerPass)pass;
+
+///The names of the passes in the receiver's pipeline, in the order they are run.
+@property (readonly) NSArray *passNames;
+
+#pragma mark -
+
+///Sets whether or not the pass with a specified name is run by the receiver.
+- (void)setEnabled:(BOOL)enabled forPassNamed:(NSString *)name;
+
+///Returns whether or not the pass with a specified name is run by the receiver.
+- (BOOL)isPassNamedEnabled:(NSString *)name;
+
+#pragma mark - Optimizing
+
+///Runs each enabled pass of the receiver over a specified array of expressions.
+///
+/// \param	expressions	The expressions to optimize, as returned by `STParseString`. Required.
+/// \param	scope		The scope the expressions will be evaluated in. Used to resolve built in functions. Optional.
+///
+/// \result	The optimized expressions.
+- (NSArray *)optimizeExpressions:(NSArray *)expressions inScope:(STScope *)scope;
+
+@end
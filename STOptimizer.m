@@ -0,0 +1,1159 @@
+//
+//  STOptimizer.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STOptimizer.h"
+
+#import "STInterpreter.h"
+#import "STBuiltInFunctions.h"
+#import "STScope.h"
+#import "STFunction.h"
+
+#import "STList.h"
+#import "STSymbol.h"
+#import "STStringWithCode.h"
+
+NSString *const kSTOptimizerPassConstantFolding = @"constant-folding";
+NSString *const kSTOptimizerPassLiteralInlining = @"literal-inlining";
+NSString *const kSTOptimizerPassDeadBranchElimination = @"dead-branch-elimination";
+NSString *const kSTOptimizerPassClosureInlining = @"closure-inlining";
+NSString *const kSTOptimizerPassCommonSubexpressionElimination = @"common-subexpression-elimination";
+
+///The largest number of expressions the body of a closure may contain for it to be inlined.
+static NSUInteger const kMaximumInlinedExpressionCount = 16;
+
+#pragma mark Tools
+
+///Returns whether or not an expression evaluates to itself.
+static BOOL IsLiteral(id expression)
+{
+	return ([expression isKindOfClass:[NSNumber class]] || [expression isKindOfClass:[NSString class]]);
+}
+
+///Returns whether or not an expression is an unquoted symbol with a specified name.
+static BOOL IsSymbolNamed(id expression, NSString *name)
+{
+	return ([expression isKindOfClass:[STSymbol class]] && ![expression isQuoted] && [[expression string] isEqualToString:name]);
+}
+
+///Returns whether or not an expression is a plain variable reference.
+static BOOL IsVariableReference(id expression)
+{
+	if(![expression isKindOfClass:[STSymbol class]] || [expression isQuoted])
+		return NO;
+	
+	NSString *name = [expression string];
+	return ([name rangeOfString:@"."].location == NSNotFound && ![name hasSuffix:@":"] && ![name hasPrefix:@"$_"]);
+}
+
+///Returns whether or not an expression is a closure definition.
+static BOOL IsDefinition(id expression)
+{
+	return ([expression isKindOfClass:[STList class]] && ST_FLAG_IS_SET([expression flags], kSTListFlagIsDefinition));
+}
+
+///Returns whether or not the first element of a definition is its parameter list.
+static BOOL DefinitionHasParameters(STList *definition)
+{
+	id head = [definition head];
+	return ([head isKindOfClass:[STList class]] && ST_FLAG_IS_SET([head flags], kSTListFlagIsDefinitionParameters));
+}
+
+///Returns whether or not an expression is a `let name = value` form, providing the name and value if it is.
+static BOOL IsLetBinding(id expression, NSString **outName, id *outValue)
+{
+	if(![expression isKindOfClass:[STList class]] || [expression count] != 4)
+		return NO;
+	
+	if(!IsSymbolNamed([expression head], @"let") || !IsSymbolNamed([expression objectAtIndex:2], @"="))
+		return NO;
+	
+	if(outName) *outName = [[expression objectAtIndex:1] string];
+	if(outValue) *outValue = [expression objectAtIndex:3];
+	
+	return YES;
+}
+
+///Returns a new list with specified contents, taking the flags and creation location of another list.
+static STList *ListWithContents(STList *list, NSArray *contents)
+{
+	STList *newList = [[STList alloc] initWithArray:contents];
+	newList.flags = list.flags;
+	newList.creationLocation = list.creationLocation;
+	
+	return newList;
+}
+
+#pragma mark - Units
+
+///The names whose use prevents the optimizer from reasoning about bindings.
+static NSSet *DynamicScopeNames()
+{
+	static NSSet *dynamicScopeNames = nil;
+	if(!dynamicScopeNames)
+		dynamicScopeNames = [[NSSet alloc] initWithObjects:@"$_here", @"eval", @"load", @"include", @"require", @"unset!", @"defmacro", nil];
+	
+	return dynamicScopeNames;
+}
+
+///Collects the names bound by an expression, returning NO if the expression uses dynamic scope features.
+static BOOL CollectBindings(id expression, NSCountedSet *bindings)
+{
+	if([expression isKindOfClass:[NSArray class]])
+	{
+		for (id subexpression in expression)
+		{
+			if(!CollectBindings(subexpression, bindings))
+				return NO;
+		}
+	}
+	else if([expression isKindOfClass:[STSymbol class]])
+	{
+		if(![expression isQuoted] && [DynamicScopeNames() containsObject:[expression string]])
+			return NO;
+	}
+	else if([expression isKindOfClass:[STStringWithCode class]])
+	{
+		return CollectBindings([expression expressions], bindings);
+	}
+	else if([expression isKindOfClass:[STList class]])
+	{
+		STList *list = expression;
+		if(ST_FLAG_IS_SET(list.flags, kSTListFlagIsQuoted) && !IsDefinition(list))
+			return YES;
+		
+		if(IsDefinition(list) && DefinitionHasParameters(list))
+		{
+			for (id parameter in [list head])
+				[bindings addObject:[parameter string]];
+		}
+		
+		if(list.count >= 2 && (IsSymbolNamed([list head], @"let") || IsSymbolNamed([list head], @"set!")))
+		{
+			NSString *name = [[list objectAtIndex:1] string];
+			NSRange rangeOfDot = [name rangeOfString:@"."];
+			if(rangeOfDot.location != NSNotFound)
+				name = [name substringToIndex:rangeOfDot.location];
+			
+			[bindings addObject:name];
+		}
+		
+		for (id subexpression in list)
+		{
+			if(!CollectBindings(subexpression, bindings))
+				return NO;
+		}
+	}
+	
+	return YES;
+}
+
+///The STOptimizationUnit class describes a complete array of expressions being optimized.
+@interface STOptimizationUnit : NSObject
+{
+	STScope *mScope;
+	NSCountedSet *mBindings;
+	BOOL mIsDynamic;
+}
+
+///Initialize the receiver with the expressions being optimized, and the scope they will be evaluated in.
+- (id)initWithExpressions:(NSArray *)expressions scope:(STScope *)scope;
+
+#pragma mark - Properties
+
+///The scope the unit will be evaluated in.
+@property (readonly) STScope *scope;
+
+///Whether or not the unit uses features that make its bindings impossible to determine ahead of time.
+@property (readonly) BOOL isDynamic;
+
+#pragma mark - Bindings
+
+///Returns whether or not a variable with a specified name is bound or assigned anywhere in the unit.
+- (BOOL)isNameBound:(NSString *)name;
+
+///Returns whether or not a variable with a specified name is bound exactly once and never assigned.
+- (BOOL)isNameBoundOnce:(NSString *)name;
+
+///Returns the built in function a variable with a specified name refers to, or nil if it does not refer to one.
+- (id)builtInFunctionNamed:(NSString *)name;
+
+///Returns the built in function an expression refers to, or nil if it does not refer to one.
+- (id)builtInFunctionForExpression:(id)expression;
+
+///Returns whether or not an expression refers to the built in function with a specified name.
+- (BOOL)isExpression:(id)expression builtInFunctionNamed:(NSString *)name;
+
+@end
+
+@implementation STOptimizationUnit
+
+- (id)initWithExpressions:(NSArray *)expressions scope:(STScope *)scope
+{
+	if((self = [super init]))
+	{
+		mScope = scope;
+		mBindings = [NSCountedSet new];
+		mIsDynamic = !CollectBindings(expressions, mBindings);
+	}
+	
+	return self;
+}
+
+#pragma mark - Properties
+
+@synthesize scope = mScope;
+@synthesize isDynamic = mIsDynamic;
+
+#pragma mark - Bindings
+
+- (BOOL)isNameBound:(NSString *)name
+{
+	return ([mBindings countForObject:name] > 0);
+}
+
+- (BOOL)isNameBoundOnce:(NSString *)name
+{
+	return ([mBindings countForObject:name] == 1);
+}
+
+- (id)builtInFunctionNamed:(NSString *)name
+{
+	if(!mScope || [self isNameBound:name])
+		return nil;
+	
+	id function = [mScope valueForVariableNamed:name searchParentScopes:YES];
+	return STIsBuiltInFunction(function)? function : nil;
+}
+
+- (id)builtInFunctionForExpression:(id)expression
+{
+	if(![expression isKindOfClass:[STSymbol class]] || [expression isQuoted])
+		return nil;
+	
+	return [self builtInFunctionNamed:[expression string]];
+}
+
+- (BOOL)isExpression:(id)expression builtInFunctionNamed:(NSString *)name
+{
+	id function = [self builtInFunctionForExpression:expression];
+	return (function && function == [mScope valueForVariableNamed:name searchParentScopes:YES]);
+}
+
+@end
+
+#pragma mark - Rewriting
+
+///The block type used to rewrite individual expressions.
+///
+/// \param	expression	The expression to rewrite. Its subexpressions have already been rewritten.
+/// \param	environment	The bindings visible to the expression.
+///
+/// \result	The rewritten expression, or `expression` if it is left unchanged.
+typedef id(^Rewriter)(id expression, NSDictionary *environment);
+
+///The block type used to decide which `let` bindings are made visible to the expressions following them.
+typedef BOOL(^BindingFilter)(NSString *name, id value);
+
+///Returns the indexes of the elements of a list that are evaluated as expressions when the list is evaluated.
+///
+///Elements that may be message labels, variable names, or data are never included.
+static NSIndexSet *EvaluatedIndexesOfList(STList *list, NSDictionary *environment, STOptimizationUnit *unit)
+{
+	NSUInteger count = list.count;
+	if(count == 0)
+		return [NSIndexSet indexSet];
+	
+	NSMutableIndexSet *indexes = [NSMutableIndexSet indexSetWithIndex:0];
+	if(count == 1)
+		return indexes;
+	
+	id head = [list head];
+	id function = [unit builtInFunctionForExpression:head];
+	if(function)
+	{
+		if(![function evaluatesOwnArguments])
+			[indexes addIndexesInRange:NSMakeRange(1, count - 1)];
+		else if(IsSymbolNamed(head, @"let") && count >= 4 && IsSymbolNamed([list objectAtIndex:2], @"="))
+			[indexes addIndexesInRange:NSMakeRange(3, count - 3)];
+		else if(IsSymbolNamed(head, @"set!") && count >= 3)
+			[indexes addIndexesInRange:NSMakeRange(2, count - 2)];
+		else if([unit isExpression:head builtInFunctionNamed:@"decide"])
+			[indexes addIndexesInRange:NSMakeRange(1, count - 1)];
+		
+		return indexes;
+	}
+	
+	BOOL isClosureCall = (IsDefinition(head) ||
+						  ([head isKindOfClass:[STSymbol class]] && IsDefinition([environment objectForKey:[head string]])));
+	if(isClosureCall)
+	{
+		[indexes addIndexesInRange:NSMakeRange(1, count - 1)];
+	}
+	else
+	{
+		//Anything else is a message, whose odd elements are labels.
+		for (NSUInteger index = 2; index < count; index += 2)
+			[indexes addIndex:index];
+	}
+	
+	return indexes;
+}
+
+static NSArray *RewriteSequence(NSArray *statements, NSDictionary *environment, STOptimizationUnit *unit, BindingFilter filter, Rewriter rewriter);
+
+///Rewrites an expression from the bottom up, applying a rewriter to every symbol and list in an evaluated position.
+static id RewriteExpression(id expression, NSDictionary *environment, STOptimizationUnit *unit, BindingFilter filter, Rewriter rewriter)
+{
+	if([expression isKindOfClass:[NSArray class]])
+	{
+		return RewriteSequence(expression, environment, unit, filter, rewriter);
+	}
+	else if([expression isKindOfClass:[STSymbol class]])
+	{
+		return rewriter(expression, environment);
+	}
+	else if([expression isKindOfClass:[STList class]])
+	{
+		STList *list = expression;
+		if(IsDefinition(list))
+		{
+			NSArray *contents = [list allObjects];
+			if(DefinitionHasParameters(list))
+			{
+				NSArray *body = RewriteSequence([contents subarrayWithRange:NSMakeRange(1, contents.count - 1)], environment, unit, filter, rewriter);
+				return ListWithContents(list, [[NSArray arrayWithObject:[list head]] arrayByAddingObjectsFromArray:body]);
+			}
+			
+			return ListWithContents(list, RewriteSequence(contents, environment, unit, filter, rewriter));
+		}
+		
+		if(ST_FLAG_IS_SET(list.flags, kSTListFlagIsQuoted))
+			return list;
+		
+		NSMutableArray *contents = nil;
+		NSIndexSet *evaluatedIndexes = EvaluatedIndexesOfList(list, environment, unit);
+		for (NSUInteger index = [evaluatedIndexes firstIndex]; index != NSNotFound; index = [evaluatedIndexes indexGreaterThanIndex:index])
+		{
+			id element = [list objectAtIndex:index];
+			id newElement = RewriteExpression(element, environment, unit, filter, rewriter);
+			if(newElement != element)
+			{
+				if(!contents)
+					contents = [NSMutableArray arrayWithArray:[list allObjects]];
+				
+				[contents replaceObjectAtIndex:index withObject:newElement];
+			}
+		}
+		
+		return rewriter(contents? ListWithContents(list, contents) : list, environment);
+	}
+	
+	return expression;
+}
+
+///Rewrites a sequence of statements, making the `let` bindings of each statement visible to the statements after it.
+static NSArray *RewriteSequence(NSArray *statements, NSDictionary *environment, STOptimizationUnit *unit, BindingFilter filter, Rewriter rewriter)
+{
+	NSMutableDictionary *sequenceEnvironment = [NSMutableDictionary dictionaryWithDictionary:environment];
+	NSMutableArray *newStatements = [NSMutableArray arrayWithCapacity:statements.count];
+	for (id statement in statements)
+	{
+		id newStatement = RewriteExpression(statement, sequenceEnvironment, unit, filter, rewriter);
+		[newStatements addObject:newStatement];
+		
+		NSString *name = nil;
+		id value = nil;
+		if(filter && IsLetBinding(newStatement, &name, &value) && [unit isNameBoundOnce:name] && filter(name, value))
+			[sequenceEnvironment setObject:value forKey:name];
+	}
+	
+	return newStatements;
+}
+
+#pragma mark - Literal Inlining
+
+///Collects the names that are bound exactly once anywhere within an expression, to a literal.
+static void CollectLiteralBindings(id expression, STOptimizationUnit *unit, NSMutableSet *names)
+{
+	if(![expression isKindOfClass:[STList class]] && ![expression isKindOfClass:[NSArray class]])
+		return;
+	
+	NSString *name = nil;
+	id value = nil;
+	if(IsLetBinding(expression, &name, &value) && IsLiteral(value) && [unit isNameBoundOnce:name])
+		[names addObject:name];
+	
+	for (id subexpression in expression)
+		CollectLiteralBindings(subexpression, unit, names);
+}
+
+///Returns whether or not an expression is a literal, or a reference to a name bound to a literal.
+static BOOL IsLiteralOrLiteralReference(id expression, NSSet *literalNames)
+{
+	return IsLiteral(expression) || (IsVariableReference(expression) && [literalNames containsObject:[expression string]]);
+}
+
+///Returns whether or not an expression only ever calls code that cannot rebind variables.
+///
+///Scope is dynamic, so any closure or method that runs between a binding and a use of it could rebind
+///the name with `set!`. The only calls allowed are to pure built in functions, `let`, `set!`, and `decide`,
+///and infix arithmetic on literals and names bound to literals. Closure bodies are checked too.
+static BOOL CallsOnlyBuiltInFunctions(id expression, NSSet *literalNames, STOptimizationUnit *unit)
+{
+	if([expression isKindOfClass:[STStringWithCode class]])
+		return CallsOnlyBuiltInFunctions([expression expressions], literalNames, unit);
+	
+	if([expression isKindOfClass:[NSArray class]])
+	{
+		for (id subexpression in expression)
+		{
+			if(!CallsOnlyBuiltInFunctions(subexpression, literalNames, unit))
+				return NO;
+		}
+		
+		return YES;
+	}
+	
+	if(![expression isKindOfClass:[STList class]] || [expression count] == 0)
+		return YES;
+	
+	STList *list = expression;
+	if(IsDefinition(list))
+	{
+		NSArray *body = list.allObjects;
+		if(DefinitionHasParameters(list))
+			body = [body subarrayWithRange:NSMakeRange(1, body.count - 1)];
+		
+		return CallsOnlyBuiltInFunctions(body, literalNames, unit);
+	}
+	
+	if(ST_FLAG_IS_SET(list.flags, kSTListFlagIsQuoted))
+		return YES;
+	
+	id head = [list head];
+	id function = [unit builtInFunctionForExpression:head];
+	if(function)
+	{
+		BOOL isPureCall = ([function isPure] && ![function evaluatesOwnArguments]);
+		if(!isPureCall &&
+		   ![unit isExpression:head builtInFunctionNamed:@"let"] &&
+		   ![unit isExpression:head builtInFunctionNamed:@"set!"] &&
+		   ![unit isExpression:head builtInFunctionNamed:@"decide"])
+			return NO;
+	}
+	else if((list.count % 2) == 1)
+	{
+		//Infix arithmetic is sent as a message to the left-most operand, which must be a number or string.
+		for (NSUInteger index = 0, count = list.count; index < count; index += 2)
+		{
+			id operand = [list objectAtIndex:index];
+			if(!IsLiteralOrLiteralReference(operand, literalNames) && ![operand isKindOfClass:[STList class]])
+				return NO;
+		}
+		
+		for (NSUInteger index = 1, count = list.count; index < count; index += 2)
+		{
+			id operator = [list objectAtIndex:index];
+			if(![operator isKindOfClass:[STSymbol class]] || [operator isQuoted] || [[operator string] length] != 1 ||
+			   [@"+-*/^" rangeOfString:[operator string]].location == NSNotFound)
+				return NO;
+		}
+	}
+	else
+	{
+		return NO;
+	}
+	
+	for (id element in list)
+	{
+		if(!CallsOnlyBuiltInFunctions(element, literalNames, unit))
+			return NO;
+	}
+	
+	return YES;
+}
+
+static NSArray *InlineLiterals(NSArray *expressions, STScope *scope)
+{
+	STOptimizationUnit *unit = [[STOptimizationUnit alloc] initWithExpressions:expressions scope:scope];
+	if(unit.isDynamic)
+		return expressions;
+	
+	NSMutableSet *literalNames = [NSMutableSet set];
+	CollectLiteralBindings(expressions, unit, literalNames);
+	if(literalNames.count == 0 || !CallsOnlyBuiltInFunctions(expressions, literalNames, unit))
+		return expressions;
+	
+	return RewriteSequence(expressions, [NSDictionary dictionary], unit, ^BOOL(NSString *name, id value) {
+		return IsLiteral(value);
+	}, ^id(id expression, NSDictionary *environment) {
+		if(IsVariableReference(expression))
+			return [environment objectForKey:[expression string]] ?: expression;
+		
+		return expression;
+	});
+}
+
+#pragma mark - Closure Inlining
+
+///Returns whether or not the body of a closure can be substituted for calls to it, counting its expressions.
+static BOOL IsInlinableBody(id expression, NSString *closureName, NSUInteger *ioExpressionCount)
+{
+	if(++(*ioExpressionCount) > kMaximumInlinedExpressionCount)
+		return NO;
+	
+	if([expression isKindOfClass:[STSymbol class]])
+	{
+		if([expression isQuoted])
+			return YES;
+		
+		NSString *name = [expression string];
+		return (![name isEqualToString:closureName] && ![name hasPrefix:@"$_"] && ![name isEqualToString:@"super"]);
+	}
+	else if([expression isKindOfClass:[STList class]])
+	{
+		if(IsDefinition(expression) || IsSymbolNamed([expression head], @"let") || IsSymbolNamed([expression head], @"set!"))
+			return NO;
+		
+		for (id subexpression in expression)
+		{
+			if(!IsInlinableBody(subexpression, closureName, ioExpressionCount))
+				return NO;
+		}
+		
+		return YES;
+	}
+	
+	return IsLiteral(expression);
+}
+
+///Returns whether or not a closure definition bound to a specified name can be inlined.
+static BOOL IsInlinableDefinition(NSString *name, id definition)
+{
+	//Closures without parameters cannot be called with the list syntax, so they are not considered.
+	if(!IsDefinition(definition) || !DefinitionHasParameters(definition) || [definition count] != 2)
+		return NO;
+	
+	NSUInteger expressionCount = 0;
+	return IsInlinableBody([definition objectAtIndex:1], name, &expressionCount);
+}
+
+///Returns whether or not an expression contains an unquoted symbol whose name is in a specified collection.
+static BOOL ContainsVariableNamed(id expression, NSDictionary *names)
+{
+	if([expression isKindOfClass:[STSymbol class]])
+		return (![expression isQuoted] && [names objectForKey:[expression string]] != nil);
+	
+	if([expression isKindOfClass:[STList class]])
+	{
+		for (id subexpression in expression)
+		{
+			if(ContainsVariableNamed(subexpression, names))
+				return YES;
+		}
+	}
+	
+	return NO;
+}
+
+///Replaces the parameters of an inlined closure with the arguments they were given.
+static id SubstituteArguments(id expression, NSDictionary *arguments, STOptimizationUnit *unit, BOOL *outIsComplete)
+{
+	if([expression isKindOfClass:[STSymbol class]])
+		return ([expression isQuoted]? nil : [arguments objectForKey:[expression string]]) ?: expression;
+	
+	if(![expression isKindOfClass:[STList class]] || ST_FLAG_IS_SET([expression flags], kSTListFlagIsQuoted))
+		return expression;
+	
+	STList *list = expression;
+	NSMutableArray *contents = [NSMutableArray arrayWithArray:[list allObjects]];
+	NSIndexSet *evaluatedIndexes = EvaluatedIndexesOfList(list, nil, unit);
+	for (NSUInteger index = 0, count = contents.count; index < count; index++)
+	{
+		id element = [contents objectAtIndex:index];
+		if([evaluatedIndexes containsIndex:index])
+		{
+			[contents replaceObjectAtIndex:index withObject:SubstituteArguments(element, arguments, unit, outIsComplete)];
+		}
+		else if(ContainsVariableNamed(element, arguments))
+		{
+			//A parameter is used somewhere we cannot safely substitute.
+			*outIsComplete = NO;
+		}
+	}
+	
+	return ListWithContents(list, contents);
+}
+
+///Returns the body of a closure with its parameters replaced by the arguments of a specified call; nil if the call cannot be inlined.
+static id InlineCall(STList *call, STList *definition, STOptimizationUnit *unit)
+{
+	STList *parameters = [definition head];
+	if(call.count - 1 != parameters.count)
+		return nil;
+	
+	NSMutableDictionary *arguments = [NSMutableDictionary dictionary];
+	NSUInteger index = 1;
+	for (id parameter in parameters)
+	{
+		//Arguments are substituted once per use, so they must be free of side effects.
+		id argument = [call objectAtIndex:index++];
+		if(!IsLiteral(argument) && !IsVariableReference(argument))
+			return nil;
+		
+		[arguments setObject:argument forKey:[parameter string]];
+	}
+	
+	BOOL isComplete = YES;
+	id body = SubstituteArguments([definition objectAtIndex:1], arguments, unit, &isComplete);
+	
+	return isComplete? body : nil;
+}
+
+static NSArray *InlineClosures(NSArray *expressions, STScope *scope)
+{
+	STOptimizationUnit *unit = [[STOptimizationUnit alloc] initWithExpressions:expressions scope:scope];
+	if(unit.isDynamic)
+		return expressions;
+	
+	return RewriteSequence(expressions, [NSDictionary dictionary], unit, ^BOOL(NSString *name, id value) {
+		return IsInlinableDefinition(name, value);
+	}, ^id(id expression, NSDictionary *environment) {
+		if(![expression isKindOfClass:[STList class]] || [expression count] == 0 || IsDefinition(expression))
+			return expression;
+		
+		id head = [expression head];
+		if(![head isKindOfClass:[STSymbol class]] || [head isQuoted])
+			return expression;
+		
+		STList *definition = [environment objectForKey:[head string]];
+		if(!definition)
+			return expression;
+		
+		return InlineCall(expression, definition, unit) ?: expression;
+	});
+}
+
+#pragma mark - Constant Folding
+
+///Returns whether or not a list is a call to a pure built in function, or an operator message, whose operands are all literals.
+static BOOL IsFoldableList(STList *list, STOptimizationUnit *unit)
+{
+	NSUInteger count = list.count;
+	if(count < 2)
+		return NO;
+	
+	id head = [list head];
+	id function = [unit builtInFunctionForExpression:head];
+	if(function)
+	{
+		if(![function isPure] || [function evaluatesOwnArguments])
+			return NO;
+		
+		for (NSUInteger index = 1; index < count; index++)
+		{
+			if(!IsLiteral([list objectAtIndex:index]))
+				return NO;
+		}
+		
+		return YES;
+	}
+	
+	//Infix arithmetic is sent as a message to the left-most operand.
+	if(IsLiteral(head) && (count % 2) == 1)
+	{
+		NSCharacterSet *operatorCharacters = [NSCharacterSet characterSetWithCharactersInString:@"+-*/^"];
+		for (NSUInteger index = 1; index < count; index++)
+		{
+			id element = [list objectAtIndex:index];
+			if((index % 2) == 1)
+			{
+				if(![element isKindOfClass:[STSymbol class]] || [element isQuoted] || [[element string] length] != 1 ||
+				   ![operatorCharacters characterIsMember:[[element string] characterAtIndex:0]])
+					return NO;
+			}
+			else if(!IsLiteral(element))
+			{
+				return NO;
+			}
+		}
+		
+		return YES;
+	}
+	
+	return NO;
+}
+
+static NSArray *FoldConstants(NSArray *expressions, STScope *scope)
+{
+	STOptimizationUnit *unit = [[STOptimizationUnit alloc] initWithExpressions:expressions scope:scope];
+	if(unit.isDynamic)
+		return expressions;
+	
+	return RewriteSequence(expressions, [NSDictionary dictionary], unit, nil, ^id(id expression, NSDictionary *environment) {
+		if(IsSymbolNamed(expression, @"true") || IsSymbolNamed(expression, @"false"))
+		{
+			if(!scope || [unit isNameBound:[expression string]])
+				return expression;
+			
+			id value = [scope valueForVariableNamed:[expression string] searchParentScopes:YES];
+			return (value == STTrue || value == STFalse)? value : expression;
+		}
+		
+		if(![expression isKindOfClass:[STList class]])
+			return expression;
+		
+		if([expression count] == 1 && IsLiteral([expression head]))
+			return [expression head];
+		
+		if(!IsFoldableList(expression, unit))
+			return expression;
+		
+		//Anything that fails is left to fail when the program is run.
+		id result = nil;
+		@try
+		{
+			result = STEvaluate(expression, scope ?: [STScope new]);
+		}
+		@catch (id exception)
+		{
+			return expression;
+		}
+		
+		return IsLiteral(result)? result : expression;
+	});
+}
+
+#pragma mark - Dead Branch Elimination
+
+static NSArray *EliminateDeadBranches(NSArray *expressions, STScope *scope)
+{
+	STOptimizationUnit *unit = [[STOptimizationUnit alloc] initWithExpressions:expressions scope:scope];
+	if(unit.isDynamic)
+		return expressions;
+	
+	return RewriteSequence(expressions, [NSDictionary dictionary], unit, nil, ^id(id expression, NSDictionary *environment) {
+		if(![expression isKindOfClass:[STList class]])
+			return expression;
+		
+		STList *list = expression;
+		if((list.count != 3 && list.count != 4) ||
+		   ![unit isExpression:[list head] builtInFunctionNamed:@"decide"] ||
+		   !IsLiteral([list objectAtIndex:1]))
+			return expression;
+		
+		id branch = nil;
+		if(STIsTrue([list objectAtIndex:1]))
+			branch = [list objectAtIndex:2];
+		else if(list.count == 4)
+			branch = [list objectAtIndex:3];
+		else
+			return STFalse;
+		
+		//`decide` evaluates the contents of either branch in place when its true-branch is a block.
+		if(IsDefinition([list objectAtIndex:2]) && [branch isKindOfClass:[STList class]])
+		{
+			NSArray *statements = [branch allObjects];
+			if(statements.count == 0)
+				return STNull;
+			else if(statements.count == 1)
+				return [statements objectAtIndex:0];
+			
+			return statements;
+		}
+		
+		return branch;
+	});
+}
+
+#pragma mark - Common Subexpression Elimination
+
+///Returns a string that is equal for two expressions exactly when the expressions are structurally identical.
+static NSString *ExpressionKey(id expression)
+{
+	if([expression isKindOfClass:[STList class]])
+	{
+		NSMutableString *key = [NSMutableString stringWithFormat:@"(%lu", (unsigned long)[expression flags]];
+		for (id subexpression in expression)
+		{
+			[key appendString:@" "];
+			[key appendString:ExpressionKey(subexpression)];
+		}
+		[key appendString:@")"];
+		
+		return key;
+	}
+	else if([expression isKindOfClass:[STSymbol class]])
+	{
+		return [NSString stringWithFormat:@"%@%@", [expression isQuoted]? @"'" : @"", [expression string]];
+	}
+	else if([expression isKindOfClass:[NSString class]])
+	{
+		return [NSString stringWithFormat:@"\"%@\"", [expression stringByReplacingOccurrencesOfString:@"\"" withString:@"\\\""]];
+	}
+	else if([expression isKindOfClass:[NSNumber class]])
+	{
+		return [NSString stringWithFormat:@"#%@", expression];
+	}
+	
+	return [NSString stringWithFormat:@"<%p>", expression];
+}
+
+///Returns whether or not an expression contains a `set!`, `let`, or `unset!` anywhere within it.
+static BOOL ContainsAssignment(id expression)
+{
+	if(![expression isKindOfClass:[STList class]] && ![expression isKindOfClass:[NSArray class]])
+		return IsSymbolNamed(expression, @"set!") || IsSymbolNamed(expression, @"let") || IsSymbolNamed(expression, @"unset!");
+	
+	for (id subexpression in expression)
+	{
+		if(ContainsAssignment(subexpression))
+			return YES;
+	}
+	
+	return NO;
+}
+
+///Returns whether or not evaluating an expression has no side effects and always yields the same result within a statement.
+///
+///Only literals, variable references, and calls to pure built in functions whose arguments are themselves
+///pure are considered. Closures and messages, including infix arithmetic, may be rebound or overridden by
+///the time the expression is evaluated, and are never considered pure.
+static BOOL IsPureSubexpression(id expression, STOptimizationUnit *unit)
+{
+	if(IsLiteral(expression) || IsVariableReference(expression))
+		return YES;
+	
+	if(![expression isKindOfClass:[STList class]] || [expression count] < 2 ||
+	   ST_FLAG_IS_SET([expression flags], kSTListFlagIsQuoted) || IsDefinition(expression))
+		return NO;
+	
+	STList *list = expression;
+	id function = [unit builtInFunctionForExpression:[list head]];
+	if(!function || ![function isPure] || [function evaluatesOwnArguments])
+		return NO;
+	
+	for (NSUInteger index = 1, count = list.count; index < count; index++)
+	{
+		if(!IsPureSubexpression([list objectAtIndex:index], unit))
+			return NO;
+	}
+	
+	return YES;
+}
+
+///Returns the indexes of the elements of a list that are evaluated every time the list is evaluated.
+///
+///Of the built in functions that evaluate their own arguments, only the values of `let` and `set!` and
+///the condition of `decide` are included, so that the branches of conditionals and the bodies of other
+///special forms are never considered.
+static NSIndexSet *UnconditionallyEvaluatedIndexesOfList(STList *list, NSDictionary *environment, STOptimizationUnit *unit)
+{
+	id head = [list head];
+	id function = [unit builtInFunctionForExpression:head];
+	if(!function || ![function evaluatesOwnArguments] || IsSymbolNamed(head, @"let") || IsSymbolNamed(head, @"set!"))
+		return EvaluatedIndexesOfList(list, environment, unit);
+	
+	if([unit isExpression:head builtInFunctionNamed:@"decide"] && list.count >= 2)
+		return [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)];
+	
+	return [NSIndexSet indexSetWithIndex:0];
+}
+
+///Counts the pure calls in the unconditionally evaluated positions of an expression, without descending into closures.
+static void CountPureSubexpressions(id expression, BOOL isRoot, NSDictionary *environment, STOptimizationUnit *unit, NSCountedSet *counts, NSMutableDictionary *occurrences)
+{
+	if(![expression isKindOfClass:[STList class]] || IsDefinition(expression) || ST_FLAG_IS_SET([expression flags], kSTListFlagIsQuoted))
+		return;
+	
+	if(!isRoot && [expression count] >= 2 && IsPureSubexpression(expression, unit))
+	{
+		NSString *key = ExpressionKey(expression);
+		[counts addObject:key];
+		if(![occurrences objectForKey:key])
+			[occurrences setObject:expression forKey:key];
+		
+		return;
+	}
+	
+	NSIndexSet *evaluatedIndexes = UnconditionallyEvaluatedIndexesOfList(expression, environment, unit);
+	for (NSUInteger index = [evaluatedIndexes firstIndex]; index != NSNotFound; index = [evaluatedIndexes indexGreaterThanIndex:index])
+		CountPureSubexpressions([expression objectAtIndex:index], NO, environment, unit, counts, occurrences);
+}
+
+///Replaces every occurrence of a subexpression in the unconditionally evaluated positions of an expression with a specified symbol.
+static id ReplaceSubexpression(id expression, BOOL isRoot, NSString *key, STSymbol *replacement, NSDictionary *environment, STOptimizationUnit *unit)
+{
+	if(![expression isKindOfClass:[STList class]] || IsDefinition(expression) || ST_FLAG_IS_SET([expression flags], kSTListFlagIsQuoted))
+		return expression;
+	
+	if(!isRoot && [ExpressionKey(expression) isEqualToString:key])
+		return replacement;
+	
+	STList *list = expression;
+	NSMutableArray *contents = [NSMutableArray arrayWithArray:list.allObjects];
+	NSIndexSet *evaluatedIndexes = UnconditionallyEvaluatedIndexesOfList(list, environment, unit);
+	for (NSUInteger index = [evaluatedIndexes firstIndex]; index != NSNotFound; index = [evaluatedIndexes indexGreaterThanIndex:index])
+		[contents replaceObjectAtIndex:index withObject:ReplaceSubexpression([contents objectAtIndex:index], NO, key, replacement, environment, unit)];
+	
+	return ListWithContents(list, contents);
+}
+
+static NSArray *EliminateCommonSubexpressionsInSequence(NSArray *statements, NSDictionary *environment, STOptimizationUnit *unit, NSUInteger *ioTemporaryCount);
+
+///Eliminates common subexpressions in the closures nested within an expression.
+static id EliminateCommonSubexpressionsInExpression(id expression, NSDictionary *environment, STOptimizationUnit *unit, NSUInteger *ioTemporaryCount)
+{
+	if([expression isKindOfClass:[NSArray class]])
+		return EliminateCommonSubexpressionsInSequence(expression, environment, unit, ioTemporaryCount);
+	
+	if(![expression isKindOfClass:[STList class]])
+		return expression;
+	
+	STList *list = expression;
+	if(IsDefinition(list))
+	{
+		NSArray *contents = list.allObjects;
+		if(DefinitionHasParameters(list))
+		{
+			NSArray *body = EliminateCommonSubexpressionsInSequence([contents subarrayWithRange:NSMakeRange(1, contents.count - 1)], environment, unit, ioTemporaryCount);
+			return ListWithContents(list, [[NSArray arrayWithObject:[list head]] arrayByAddingObjectsFromArray:body]);
+		}
+		
+		return ListWithContents(list, EliminateCommonSubexpressionsInSequence(contents, environment, unit, ioTemporaryCount));
+	}
+	
+	if(ST_FLAG_IS_SET(list.flags, kSTListFlagIsQuoted))
+		return list;
+	
+	NSMutableArray *contents = [NSMutableArray arrayWithArray:list.allObjects];
+	NSIndexSet *evaluatedIndexes = EvaluatedIndexesOfList(list, environment, unit);
+	for (NSUInteger index = [evaluatedIndexes firstIndex]; index != NSNotFound; index = [evaluatedIndexes indexGreaterThanIndex:index])
+		[contents replaceObjectAtIndex:index withObject:EliminateCommonSubexpressionsInExpression([contents objectAtIndex:index], environment, unit, ioTemporaryCount)];
+	
+	return ListWithContents(list, contents);
+}
+
+///Returns an expression that evaluates a specified expression in a new scope where each
+///of a list of temporaries is bound to the value of the corresponding subexpression.
+///
+///The expression is wrapped in calls to closures whose parameters are the temporaries, so the temporaries
+///are never bound in the scope the statement is evaluated in. Each subexpression is evaluated in the scope
+///of the temporaries before it, in the order the temporaries were created.
+static id BindTemporaries(id expression, NSArray *temporaries, NSArray *subexpressions, STList *locationList)
+{
+	for (NSUInteger index = temporaries.count; index > 0; index--)
+	{
+		STList *parameters = [[STList alloc] initWithObject:[temporaries objectAtIndex:index - 1]];
+		parameters.flags = kSTListFlagIsDefinitionParameters;
+		
+		STList *definition = [[STList alloc] initWithObjects:parameters, expression, nil];
+		definition.flags = kSTListFlagIsDefinition;
+		definition.creationLocation = locationList.creationLocation;
+		
+		STList *call = [[STList alloc] initWithObjects:definition, [subexpressions objectAtIndex:index - 1], nil];
+		call.creationLocation = locationList.creationLocation;
+		
+		expression = call;
+	}
+	
+	return expression;
+}
+
+///Eliminates common subexpressions in a sequence of statements, evaluating each repeated
+///pure subexpression of a statement once and binding it to a temporary that only the statement sees.
+static NSArray *EliminateCommonSubexpressionsInSequence(NSArray *statements, NSDictionary *environment, STOptimizationUnit *unit, NSUInteger *ioTemporaryCount)
+{
+	NSMutableDictionary *sequenceEnvironment = [NSMutableDictionary dictionaryWithDictionary:environment];
+	NSMutableArray *newStatements = [NSMutableArray arrayWithCapacity:statements.count];
+	NSDictionary *argumentNames = [NSDictionary dictionaryWithObject:STTrue forKey:@"$_arguments"];
+	for (id statement in statements)
+	{
+		statement = EliminateCommonSubexpressionsInExpression(statement, sequenceEnvironment, unit, ioTemporaryCount);
+		
+		//Only the value of a `let` is rewritten, so the name it binds stays in the statement's scope.
+		BOOL isLetBinding = IsLetBinding(statement, NULL, NULL);
+		id valueOfStatement = isLetBinding? [statement objectAtIndex:3] : statement;
+		
+		//Assignments within the statement could change the value of a subexpression between its occurrences.
+		//Scope is dynamic, so any closure or message the statement calls could also assign to a variable the
+		//subexpression reads, or observe that it was evaluated early, so the statement may only call pure built
+		//in functions. The temporaries are bound in a new scope, where `$_arguments` would refer to another call.
+		BOOL canHoist = ([valueOfStatement isKindOfClass:[STList class]] &&
+						 !ContainsAssignment(valueOfStatement) &&
+						 CallsOnlyBuiltInFunctions(valueOfStatement, [NSSet set], unit) &&
+						 !ContainsVariableNamed(valueOfStatement, argumentNames));
+		
+		NSMutableArray *temporaries = [NSMutableArray array];
+		NSMutableArray *subexpressions = [NSMutableArray array];
+		while (canHoist)
+		{
+			NSCountedSet *counts = [NSCountedSet set];
+			NSMutableDictionary *occurrences = [NSMutableDictionary dictionary];
+			CountPureSubexpressions(valueOfStatement, YES, sequenceEnvironment, unit, counts, occurrences);
+			
+			//The largest repeated subexpression is bound first, as it subsumes any within it.
+			NSString *repeatedKey = nil;
+			for (NSString *key in counts)
+			{
+				if([counts countForObject:key] > 1 && key.length > repeatedKey.length)
+					repeatedKey = key;
+			}
+			
+			if(!repeatedKey)
+				break;
+			
+			STSymbol *temporary = [[STSymbol alloc] initWithString:[NSString stringWithFormat:@"$cse-%lu", (unsigned long)(*ioTemporaryCount)++]];
+			[temporaries addObject:temporary];
+			[subexpressions addObject:[occurrences objectForKey:repeatedKey]];
+			
+			valueOfStatement = ReplaceSubexpression(valueOfStatement, YES, repeatedKey, temporary, sequenceEnvironment, unit);
+		}
+		
+		if(temporaries.count > 0)
+		{
+			valueOfStatement = BindTemporaries(valueOfStatement, temporaries, subexpressions, statement);
+			if(isLetBinding)
+			{
+				NSMutableArray *contents = [NSMutableArray arrayWithArray:[statement allObjects]];
+				[contents replaceObjectAtIndex:3 withObject:valueOfStatement];
+				statement = ListWithContents(statement, contents);
+			}
+			else
+			{
+				statement = valueOfStatement;
+			}
+		}
+		
+		[newStatements addObject:statement];
+		
+		//Closures are never pure subexpressions, but calls to them evaluate all of their arguments.
+		NSString *name = nil;
+		id value = nil;
+		if(IsLetBinding(statement, &name, &value) && [unit isNameBoundOnce:name] && IsDefinition(value))
+			[sequenceEnvironment setObject:value forKey:name];
+	}
+	
+	return newStatements;
+}
+
+static NSArray *EliminateCommonSubexpressions(NSArray *expressions, STScope *scope)
+{
+	STOptimizationUnit *unit = [[STOptimizationUnit alloc] initWithExpressions:expressions scope:scope];
+	if(unit.isDynamic || [unit isNameBound:@"let"])
+		return expressions;
+	
+	NSUInteger temporaryCount = 0;
+	return EliminateCommonSubexpressionsInSequence(expressions, [NSDictionary dictionary], unit, &temporaryCount);
+}
+
+#pragma mark -
+
+@implementation STOptimizer
+
+#pragma mark Initialization
+
+- (id)init
+{
+	if((self = [super init]))
+	{
+		mPassNames = [NSMutableArray new];
+		mPasses = [NSMutableDictionary new];
+		mDisabledPassNames = [NSMutableSet new];
+		
+		[self addPassNamed:kSTOptimizerPassLiteralInlining usingBlock:^NSArray *(NSArray *expressions, STScope *scope) {
+			return InlineLiterals(expressions, scope);
+		}];
+		[self addPassNamed:kSTOptimizerPassClosureInlining usingBlock:^NSArray *(NSArray *expressions, STScope *scope) {
+			return InlineClosures(expressions, scope);
+		}];
+		[self addPassNamed:kSTOptimizerPassConstantFolding usingBlock:^NSArray *(NSArray *expressions, STScope *scope) {
+			return FoldConstants(expressions, scope);
+		}];
+		[self addPassNamed:kSTOptimizerPassDeadBranchElimination usingBlock:^NSArray *(NSArray *expressions, STScope *scope) {
+			return EliminateDeadBranches(expressions, scope);
+		}];
+		[self addPassNamed:kSTOptimizerPassCommonSubexpressionElimination usingBlock:^NSArray *(NSArray *expressions, STScope *scope) {
+			return EliminateCommonSubexpressions(expressions, scope);
+		}];
+	}
+	
+	return self;
+}
+
+#pragma mark - Passes
+
+- (void)addPassNamed:(NSString *)name usingBlock:(STOptimizerPass)pass
+{
+	NSParameterAssert(name);
+	NSParameterAssert(pass);
+	
+	@synchronized(self)
+	{
+		if(![mPasses objectForKey:name])
+			[mPassNames addObject:name];
+		
+		[mPasses setObject:[pass copy] forKey:name];
+	}
+}
+
+- (NSArray *)passNames
+{
+	@synchronized(self)
+	{
+		return [mPassNames copy];
+	}
+}
+
+#pragma mark -
+
+- (void)setEnabled:(BOOL)enabled forPassNamed:(NSString *)name
+{
+	NSParameterAssert(name);
+	
+	@synchronized(self)
+	{
+		if(enabled)
+			[mDisabledPassNames removeObject:name];
+		else
+			[mDisabledPassNames addObject:name];
+	}
+}
+
+- (BOOL)isPassNamedEnabled:(NSString *)name
+{
+	@synchronized(self)
+	{
+		return ([mPasses objectForKey:name] != nil && ![mDisabledPassNames containsObject:name]);
+	}
+}
+
+#pragma mark - Optimizing
+
+- (NSArray *)optimizeExpressions:(NSArray *)expressions inScope:(STScope *)scope
+{
+	NSParameterAssert(expressions);
+	
+	for (NSString *name in self.passNames)
+	{
+		if(![self isPassNamedEnabled:name])
+			continue;
+		
+		STOptimizerPass pass = nil;
+		@synchronized(self)
+		{
+			pass = [mPasses objectForKey:name];
+		}
+		
+		expressions = pass(expressions, scope);
+	}
+	
+	return expressions;
+}
+
+@end
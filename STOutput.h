@@ -0,0 +1,88 @@
+//
+//  STOutput.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <pthread.h>
+
+///The STOutput class is a buffered sink that text is written to, either a file descriptor or a mutable string.
+///
+///Text written to a file descriptor is encoded as UTF-8 directly into a buffer, which is only written
+///out when it fills up, when `-[STOutput flush]` is called, or, for outputs attached to a terminal and
+///for standard error, when a line is finished with `-[STOutput finishLine]`. The standard outputs are
+///flushed when the process exits, and the REPL flushes standard output before it reads each line.
+///
+///Writes from multiple threads are serialized. A sequence of writes that should not be interleaved
+///with writes from other threads can be grouped between `-[STOutput lock]` and `-[STOutput unlock]`.
+@interface STOutput : NSObject < NSLocking >
+{
+	int mFileDescriptor;
+	BOOL mFlushesAfterEachLine;
+	
+	char *mBuffer;
+	NSUInteger mBufferLength;
+	
+	NSMutableString *mString;
+	
+	pthread_mutex_t mLock;
+}
+
+#pragma mark Shared Outputs
+
+///Returns the output that writes to standard output.
++ (STOutput *)standardOutput;
+
+///Returns the output that writes to standard error. Standard error is flushed after each line.
++ (STOutput *)standardError;
+
+///Write out any text that has been buffered by the standard outputs.
+///
+///Bridged native functions may write to the standard outputs through stdio, so the standard outputs are
+///flushed before each one is called. Likewise, stdio's buffers are flushed before an output writes to
+///standard output or standard error, so text is written in the order it was produced.
++ (void)flushStandardOutputs;
+
+#pragma mark - Initialization
+
+///Initialize the receiver to write to a specified open file descriptor, which the receiver does not close.
+- (id)initWithFileDescriptor:(int)fileDescriptor;
+
+///Initialize the receiver to append everything written to it to a specified mutable string.
+- (id)initWithMutableString:(NSMutableString *)string;
+
+#pragma mark - Writing
+
+///Write a specified string to the receiver.
+- (void)writeString:(NSString *)string;
+
+///Write a specified range of the characters of a string to the receiver.
+- (void)writeString:(NSString *)string range:(NSRange)range;
+
+///Write a specified number of UTF-8 encoded bytes to the receiver.
+- (void)writeBytes:(const char *)bytes length:(NSUInteger)length;
+
+///Write a string created from a specified format and arguments to the receiver.
+- (void)writeFormat:(NSString *)format, ... NS_FORMAT_FUNCTION(1, 2);
+
+///Write the pretty description of a specified object to the receiver.
+///
+///Collections write the pretty descriptions of their contents one after the other
+///without building a string for each nested collection.
+- (void)writePrettyDescriptionOfObject:(id)object;
+
+///Write a newline to the receiver, flushing it if it writes to a terminal or to standard error.
+- (void)finishLine;
+
+///Write out any text that has been buffered by the receiver.
+- (void)flush;
+
+#pragma mark - Pretty Descriptions
+
+///Returns the pretty description of a specified object, written into a single string.
++ (NSString *)prettyDescriptionOfObject:(id)object;
+
+@end
@@ -0,0 +1,329 @@
+//
+//  STOutput.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STOutput.h"
+#import "NSObject+SteinTools.h"
+#import <unistd.h>
+
+///The number of bytes an output buffers before writing them to its file descriptor.
+#define BUFFER_SIZE	(64 * 1024)
+
+static STOutput *gStandardOutput = nil;
+static STOutput *gStandardError = nil;
+
+///Flushes the standard outputs. Registered with atexit when the standard outputs are created.
+static void FlushStandardOutputs(void)
+{
+	[gStandardOutput flush];
+	[gStandardError flush];
+}
+
+///Writes a specified number of bytes to a file descriptor, retrying after partial writes and interruptions.
+static void WriteFully(int fileDescriptor, const char *bytes, NSUInteger length)
+{
+	while (length > 0)
+	{
+		ssize_t writtenLength = write(fileDescriptor, bytes, length);
+		if(writtenLength == -1)
+		{
+			if(errno == EINTR)
+				continue;
+			
+			//Like stdio, output that cannot be written is dropped rather than raised.
+			return;
+		}
+		
+		bytes += writtenLength;
+		length -= writtenLength;
+	}
+}
+
+@implementation STOutput
+
+#pragma mark Shared Outputs
+
++ (void)initialize
+{
+	if(self == [STOutput class])
+	{
+		gStandardOutput = [[STOutput alloc] initWithFileDescriptor:STDOUT_FILENO];
+		
+		gStandardError = [[STOutput alloc] initWithFileDescriptor:STDERR_FILENO];
+		gStandardError->mFlushesAfterEachLine = YES;
+		
+		atexit(&FlushStandardOutputs);
+	}
+}
+
++ (STOutput *)standardOutput
+{
+	return gStandardOutput;
+}
+
++ (STOutput *)standardError
+{
+	return gStandardError;
+}
+
++ (void)flushStandardOutputs
+{
+	FlushStandardOutputs();
+}
+
+#pragma mark - Initialization
+
+- (void)dealloc
+{
+	[self flush];
+	
+	if(mBuffer)
+		free(mBuffer);
+	
+	pthread_mutex_destroy(&mLock);
+}
+
+///Initialize the receiver's lock. Locks are recursive so grouped writes may be nested.
+- (void)initializeLock
+{
+	pthread_mutexattr_t attributes;
+	pthread_mutexattr_init(&attributes);
+	pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&mLock, &attributes);
+	pthread_mutexattr_destroy(&attributes);
+}
+
+- (id)initWithFileDescriptor:(int)fileDescriptor
+{
+	NSParameterAssert(fileDescriptor >= 0);
+	
+	if((self = [super init]))
+	{
+		mFileDescriptor = fileDescriptor;
+		mFlushesAfterEachLine = isatty(fileDescriptor);
+		
+		mBuffer = malloc(BUFFER_SIZE);
+		NSAssert(mBuffer != NULL, @"Could not allocate output buffer.");
+		
+		[self initializeLock];
+	}
+	
+	return self;
+}
+
+- (id)initWithMutableString:(NSMutableString *)string
+{
+	NSParameterAssert(string);
+	
+	if((self = [super init]))
+	{
+		mFileDescriptor = -1;
+		mString = string;
+		
+		[self initializeLock];
+	}
+	
+	return self;
+}
+
+#pragma mark - Locking
+
+- (void)lock
+{
+	pthread_mutex_lock(&mLock);
+}
+
+- (void)unlock
+{
+	pthread_mutex_unlock(&mLock);
+}
+
+#pragma mark - Writing
+
+///Write out the receiver's buffer. The receiver must be locked.
+- (void)writeBuffer
+{
+	//Text written through stdio by native functions is written out first, so that it keeps its place.
+	if(mFileDescriptor == STDOUT_FILENO)
+		fflush(stdout);
+	else if(mFileDescriptor == STDERR_FILENO)
+		fflush(stderr);
+	
+	if(mBufferLength == 0)
+		return;
+	
+	WriteFully(mFileDescriptor, mBuffer, mBufferLength);
+	mBufferLength = 0;
+}
+
+- (void)writeString:(NSString *)string
+{
+	if(!string)
+		return;
+	
+	if(mString)
+	{
+		[self lock];
+		[mString appendString:string];
+		[self unlock];
+		
+		return;
+	}
+	
+	//Strings that are stored as ASCII are already valid UTF-8, and are copied into the buffer as they are.
+	const char *ASCIIString = CFStringGetCStringPtr((__bridge CFStringRef)string, kCFStringEncodingASCII);
+	if(ASCIIString)
+	{
+		[self writeBytes:ASCIIString length:[string length]];
+		return;
+	}
+	
+	[self writeString:string range:NSMakeRange(0, [string length])];
+}
+
+- (void)writeString:(NSString *)string range:(NSRange)range
+{
+	NSParameterAssert(string);
+	
+	[self lock];
+	@try
+	{
+		if(mString)
+		{
+			[mString appendString:[string substringWithRange:range]];
+			return;
+		}
+		
+		//Characters are encoded straight into the buffer, which is written out each time it fills up.
+		while (range.length > 0)
+		{
+			NSUInteger usedLength = 0;
+			NSRange remainingRange = range;
+			if(![string getBytes:mBuffer + mBufferLength
+					   maxLength:BUFFER_SIZE - mBufferLength
+					  usedLength:&usedLength
+						encoding:NSUTF8StringEncoding
+						 options:NSStringEncodingConversionAllowLossy
+						   range:range
+				  remainingRange:&remainingRange])
+			{
+				usedLength = 0;
+				remainingRange = range;
+			}
+			
+			mBufferLength += usedLength;
+			range = remainingRange;
+			
+			if(range.length > 0)
+				[self writeBuffer];
+		}
+	}
+	@finally
+	{
+		[self unlock];
+	}
+}
+
+- (void)writeBytes:(const char *)bytes length:(NSUInteger)length
+{
+	NSParameterAssert(bytes);
+	
+	[self lock];
+	if(mString)
+	{
+		NSString *string = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+		if(string)
+			[mString appendString:string];
+	}
+	else if(length <= BUFFER_SIZE - mBufferLength)
+	{
+		memcpy(mBuffer + mBufferLength, bytes, length);
+		mBufferLength += length;
+	}
+	else
+	{
+		[self writeBuffer];
+		
+		//Writes larger than the buffer bypass it.
+		if(length >= BUFFER_SIZE)
+		{
+			WriteFully(mFileDescriptor, bytes, length);
+		}
+		else
+		{
+			memcpy(mBuffer, bytes, length);
+			mBufferLength = length;
+		}
+	}
+	[self unlock];
+}
+
+- (void)writeFormat:(NSString *)format, ...
+{
+	NSParameterAssert(format);
+	
+	va_list arguments;
+	va_start(arguments, format);
+	NSString *string = [[NSString alloc] initWithFormat:format arguments:arguments];
+	va_end(arguments);
+	
+	[self writeString:string];
+}
+
+- (void)writePrettyDescriptionOfObject:(id)object
+{
+	[self lock];
+	@try
+	{
+		[object writePrettyDescriptionToOutput:self];
+	}
+	@finally
+	{
+		[self unlock];
+	}
+}
+
+- (void)finishLine
+{
+	[self lock];
+	[self writeBytes:"\n" length:1];
+	if(mFlushesAfterEachLine)
+		[self writeBuffer];
+	[self unlock];
+}
+
+- (void)flush
+{
+	if(mString)
+		return;
+	
+	[self lock];
+	[self writeBuffer];
+	[self unlock];
+}
+
+#pragma mark - Pretty Descriptions
+
++ (NSString *)prettyDescriptionOfObject:(id)object
+{
+	//Strings without quotes and numbers are described directly, without creating an output.
+	if([object isKindOfClass:[NSString class]])
+	{
+		if([object rangeOfString:@"\"" options:NSLiteralSearch].location == NSNotFound)
+			return [NSString stringWithFormat:@"\"%@\"", object];
+	}
+	else if([object isKindOfClass:[NSNumber class]])
+	{
+		return [object prettyDescription];
+	}
+	
+	NSMutableString *prettyDescription = [NSMutableString string];
+	[[[STOutput alloc] initWithMutableString:prettyDescription] writePrettyDescriptionOfObject:object];
+	return prettyDescription;
+}
+
+@end
@@ -288,13 +288,11 @@ static id GetStringAt(STParserState *parserState)
 		else if(character == '%' && SafelyGetCharacterAtIndex(parserState.string, index + 1) == '(')
 		{
 			//Find the closing bracket.
-			NSRange codeRange = NSMakeRange(index - 1, 0);
+			NSRange codeRange = NSMakeRange(index + 2, 0);
 			NSUInteger numberOfNestedParentheses = 0;
 			for (NSUInteger parentheseSearchIndex = index; parentheseSearchIndex < parserState.stringLength; parentheseSearchIndex++)
 			{
 				unichar innerCharacter = [parserState.string characterAtIndex:parentheseSearchIndex];
-				[resultString appendFormat:@"%C", innerCharacter];
-				
 				if(innerCharacter == '(')
 				{
 					numberOfNestedParentheses++;
@@ -314,29 +312,31 @@ static id GetStringAt(STParserState *parserState)
 				STParserStateUpdateCreationLocation(parserState, innerCharacter);
 			}
 			
-			NSString *expressionString = [parserState.string substringWithRange:NSMakeRange(codeRange.location + 3, 
-																							 codeRange.length - 3)];
+			NSString *expressionString = [parserState.string substringWithRange:codeRange];
 			STParserState *expressionState = [[STParserState alloc] initWithString:expressionString file:@"imaginary"];
 			id expression = GetExpressionAt(expressionState, NO, YES);
 			if(!resultStringWithCode)
 				resultStringWithCode = [STStringWithCode new];
 			
-			[resultStringWithCode addExpression:expression 
-										inRange:NSMakeRange([resultString length] - [expressionString length] - 3, [expressionString length] + 3)];
+			//The literal text before the expression becomes its own segment.
+			[resultStringWithCode addLiteral:resultString];
+			[resultStringWithCode addExpression:expression withSource:expressionString];
+			[resultString setString:@""];
 		}
 		else
 		{
-			[resultString appendFormat:@"%C", character];
+			CFStringAppendCharacters((__bridge CFMutableStringRef)resultString, &character, 1);
 		}
 	}
 	
 	if(resultStringWithCode)
 	{
-		resultStringWithCode.string = resultString;
+		[resultStringWithCode addLiteral:resultString];
 		return resultStringWithCode;
 	}
 	
-	return resultString;
+	//String literals are immutable so that evaluating them never requires a copy.
+	return [resultString copy];
 }
 
 static STSymbol *GetIdentifierAt(STParserState *parserState, NSCharacterSet *extraInvalidCharacters)
@@ -9,7 +9,36 @@
 #import <Foundation/Foundation.h>
 #import <Stein/STEnumerable.h>
 
+///The different ways the bytes of an STPointer may be stored.
+typedef enum STPointerStorage {
+	///The bytes are allocated on the heap, aligned to 64 bytes.
+	kSTPointerStorageAligned = 0,
+	
+	///The bytes are an anonymous memory mapping whose pages are zeroed when they are first touched.
+	kSTPointerStorageAnonymousMapping,
+	
+	///The bytes are a memory mapping of a file.
+	kSTPointerStorageFileMapping,
+	
+	///The bytes belong to another object that the pointer is a view of, or were lent to the pointer by native code.
+	kSTPointerStorageView,
+} STPointerStorage;
+
+///The ways a file may be mapped into a pointer.
+typedef enum STPointerMappingMode {
+	///The pointer may not be written to.
+	kSTPointerMappingModeReadOnly = 0,
+	
+	///Writes to the pointer are private to it, and never reach the file.
+	kSTPointerMappingModeCopyOnWrite,
+} STPointerMappingMode;
+
 ///The STPointer class is used to represent pointers in the Stein programming language.
+///
+///Small pointers are allocated on the heap aligned to 64 bytes, so their contents are always
+///suitable for vector loads. Pointers of a megabyte or more are allocated as anonymous memory
+///mappings, which cost nothing until their pages are touched. Pointer arrays may also be mapped
+///from files, and sliced into views that share the storage of the pointer they came from.
 @interface STPointer : NSObject < STEnumerable, NSCopying >
 {
 	BOOL mIsArray;
@@ -17,6 +46,15 @@
 	size_t mLength;
 	void *mBytes;
 	char *mType;
+	
+	STPointerStorage mStorage;
+	BOOL mIsReadOnly;
+	
+	//The object whose bytes a view refers to.
+	id mOwner;
+	
+	//The number of views and data objects referring to the receiver's bytes.
+	volatile int32_t mViewCount;
 }
 #pragma mark Creation
 
@@ -35,6 +73,52 @@
 /// \result	A new pointer object ready for use as an array.
 + (STPointer *)arrayPointerOfLength:(NSUInteger)length type:(const char *)type;
 
+///Create a new pointer array whose contents are mapped from a file.
+///
+/// \param	path	The path of the file to map. Required.
+/// \param	type	The type of the values in the file. Required.
+/// \param	mode	Whether the pointer is read-only, or may be written to without affecting the file.
+/// \param	error	On return, the error that occurred if the file could not be mapped.
+///
+/// \result	A new pointer array containing as many whole values as the file holds, or nil if the file could not be mapped.
++ (STPointer *)arrayPointerMappingFileAtPath:(NSString *)path type:(const char *)type mode:(STPointerMappingMode)mode error:(NSError **)error;
+
+///Create a new pointer array containing the values of a specified collection.
+///
+/// \param	values	A collection of objects that can be converted to `type`. Must contain at least one value.
+/// \param	type	The type of the values to store in the pointer.
+///
+/// \result	A new pointer array. Numbers are converted directly into primitive
+///			types in a single loop, rather than through the type bridge one at a time.
++ (STPointer *)arrayPointerWithValues:(id <NSFastEnumeration>)values type:(const char *)type;
+
+#pragma mark - Borrowing
+
+///Create a new pointer to a single value that refers to a buffer it does not own.
+///
+/// \param	bytes	The buffer to refer to. Required.
+/// \param	type	The type of the value in the buffer. Required.
+/// \param	owner	An object that keeps the buffer alive, which the pointer will retain. Optional.
+///
+/// \result	A new pointer whose bytes are `bytes`. The bytes are not copied, and are never freed by the pointer.
++ (STPointer *)pointerBorrowingBytes:(void *)bytes type:(const char *)type owner:(id)owner;
+
+///Create a new pointer array that refers to a buffer it does not own.
+///
+/// \param	bytes	The buffer to refer to. Required.
+/// \param	count	The number of values in the buffer. Must be greater than 0.
+/// \param	type	The type of the values in the buffer. Required.
+/// \param	owner	An object that keeps the buffer alive, which the pointer will retain. Optional.
+///
+/// \result	A new pointer array whose bytes are `bytes`. The bytes are not copied, and are never freed by the pointer.
++ (STPointer *)arrayPointerBorrowingBytes:(void *)bytes count:(NSUInteger)count type:(const char *)type owner:(id)owner;
+
+///Create a new pointer array that refers to the contents of a data object without copying them.
+///
+///Pointers created from immutable data are read-only. Pointers created from mutable data
+///may be written to, and the data must not change length for the lifetime of the pointer.
++ (STPointer *)arrayPointerWithData:(NSData *)data type:(const char *)type;
+
 #pragma mark - Properties
 
 ///The raw bytes of the pointer.
@@ -46,11 +130,28 @@
 ///The type of the pointer's value.
 @property (readonly) const char *type;
 
+///Whether or not the pointer represents an array of values.
+@property (readonly) BOOL isArray;
+
 #pragma mark -
 
 ///The length of the pointer in bytes.
 @property (readonly) size_t length;
 
+///How the bytes of the pointer are stored.
+@property (readonly) STPointerStorage storage;
+
+///Whether or not the pointer's contents may be changed.
+@property (readonly, getter=isReadOnly) BOOL readOnly;
+
+///The object that owns the bytes of the pointer if it is a view, or nil.
+@property (readonly) id owner;
+
+///A data object whose contents are the bytes of the pointer, without copying them.
+///
+///The data keeps the pointer alive, and reflects any later changes to the pointer's contents.
+@property (readonly) NSData *data;
+
 ///The value of the pointer, as an object.
 ///
 ///This property is unavailable for array pointers.
@@ -68,11 +169,77 @@
 ///This method is unavailable for non-array pointers.
 - (id)valueAtIndex:(NSUInteger)index;
 
+///Returns the values of the receiver as an array of objects, converting numbers in a single loop.
+///
+///This method is unavailable for non-array pointers.
+- (NSArray *)values;
+
 #pragma mark -
 
 ///The number of values within the pointer.
 ///
-///This property is unavailable for non-array pointers.
+///This property is unavailable for non-array pointers. Only pointers that own their bytes
+///may have their count changed, and only while no slices or data objects refer to them.
 @property (nonatomic) NSUInteger count;
 
+///Returns a pointer array whose contents are a range of the receiver's values.
+///
+///The slice shares the receiver's storage, so changes to either are visible through the other.
+///This method is unavailable for non-array pointers.
+- (STPointer *)sliceWithRange:(NSRange)range;
+
+///Returns a pointer array of the receiver's type that refers to a specified number of values starting at the receiver's bytes.
+///
+///This method is used to give an explicit length to pointers borrowed from native functions,
+///which only refer to a single value. The caller is responsible for ensuring the receiver's
+///bytes contain at least `count` values.
+- (STPointer *)arrayPointerOfCount:(NSUInteger)count;
+
+#pragma mark - Numeric Arrays
+
+///Whether or not the receiver is an array pointer of int, long, float, or double values.
+///
+///Numeric arrays support the `+`, `-`, `*`, and `/` operators element-wise against another numeric
+///array of the same type and count, or against a number which is applied to every value. Arithmetic,
+///`sum`, and `dot:` are performed on several values at a time using the processor's vector unit,
+///and none of the numeric array methods box the values of the receiver.
+@property (readonly) BOOL isNumericArray;
+
+///Returns an int pointer array containing 1 where the receiver's values are less than
+///the corresponding values of an operand, and 0 elsewhere. The operand may be a number.
+- (STPointer *)lessThan:(id)operand;
+
+///Returns an int pointer array containing 1 where the receiver's values are greater than
+///the corresponding values of an operand, and 0 elsewhere. The operand may be a number.
+- (STPointer *)greaterThan:(id)operand;
+
+///Returns an int pointer array containing 1 where the receiver's values are equal to
+///the corresponding values of an operand, and 0 elsewhere. The operand may be a number.
+- (STPointer *)equalTo:(id)operand;
+
+///Returns the sum of the products of the receiver's values and the values of a numeric array of the same type and count.
+- (NSNumber *)dot:(STPointer *)pointer;
+
+///Returns a pointer array of the receiver's type whose values are the running totals of the receiver's values.
+- (STPointer *)scan;
+
+#pragma mark - Parallel Enumeration
+
+///Maps the values of an array pointer across multiple threads into a new array pointer of the same type.
+///
+///This method is unavailable for non-array pointers. The function must be pure.
+///Returns nil if the function returns nil for every value.
+- (STPointer *)pmap:(id <STFunction>)function;
+
+///Filters the values of an array pointer across multiple threads into a new array pointer of the same type.
+///
+///This method is unavailable for non-array pointers. The function must be pure.
+///Returns nil if no values match, as pointer arrays cannot be empty.
+- (STPointer *)pfilter:(id <STFunction>)function;
+
+///Combines the values of an array pointer using a pure, associative function across multiple threads.
+///
+///This method is unavailable for non-array pointers.
+- (id)preduce:(id <STFunction>)function;
+
 @end
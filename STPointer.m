@@ -9,42 +9,331 @@
 #import "STPointer.h"
 #import "STTypeBridge.h"
 #import "NSObject+SteinTools.h"
+#import "STOutput.h"
+#import "NSObject+SteinInternalSupport.h"
 #import "STList.h"
+#import <libkern/OSAtomic.h>
+#import <objc/runtime.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <fcntl.h>
+
+#pragma mark Numeric Kernels
+
+typedef enum STNumericType {
+	kSTNumericTypeNone = 0,
+	kSTNumericTypeInt32,
+	kSTNumericTypeInt64,
+	kSTNumericTypeFloat,
+	kSTNumericTypeDouble,
+} STNumericType;
+
+typedef enum STNumericOperation {
+	kSTNumericOperationAdd = 0,
+	kSTNumericOperationSubtract,
+	kSTNumericOperationMultiply,
+	kSTNumericOperationDivide,
+} STNumericOperation;
+
+typedef enum STNumericComparison {
+	kSTNumericComparisonLessThan = 0,
+	kSTNumericComparisonGreaterThan,
+	kSTNumericComparisonEqualTo,
+} STNumericComparison;
+
+///The width in bytes of the vectors used by the numeric kernels. The vector
+///types below are compiled to SSE instructions on Intel, and NEON on ARM.
+#define VECTOR_WIDTH	16
+
+///Defines the numeric kernels for a specified element type.
+///
+///Element-wise arithmetic, sums and dot products are performed a vector at a time, followed by
+///the remaining elements one at a time. Sums and dot products of integers are accumulated one
+///element at a time into a wider type so that they do not overflow. Loads and stores go through
+///memcpy, as pointer arrays are only guaranteed to be aligned to their element type.
+#define DEFINE_NUMERIC_KERNELS(Name, Type, AccumulatorType, IsFloatingPoint, BoxSelector) \
+typedef Type Name##Vector __attribute__((vector_size(VECTOR_WIDTH))); \
+\
+static void Name##Apply(STNumericOperation operation, const void *leftValues, const void *rightValues, BOOL isRightScalar, void *resultValues, NSUInteger count) \
+{ \
+	const Type *left = leftValues, *right = rightValues; \
+	Type *result = resultValues; \
+	const NSUInteger lanes = sizeof(Name##Vector) / sizeof(Type); \
+	\
+	Name##Vector rightVector; \
+	for (NSUInteger lane = 0; lane < lanes; lane++) \
+		rightVector[lane] = right[0]; \
+	\
+	NSUInteger index = 0; \
+	for (; index + lanes <= count; index += lanes) \
+	{ \
+		Name##Vector leftVector; \
+		memcpy(&leftVector, left + index, sizeof(leftVector)); \
+		if(!isRightScalar) \
+			memcpy(&rightVector, right + index, sizeof(rightVector)); \
+		\
+		switch (operation) \
+		{ \
+			case kSTNumericOperationAdd: leftVector = leftVector + rightVector; break; \
+			case kSTNumericOperationSubtract: leftVector = leftVector - rightVector; break; \
+			case kSTNumericOperationMultiply: leftVector = leftVector * rightVector; break; \
+			case kSTNumericOperationDivide: leftVector = leftVector / rightVector; break; \
+		} \
+		\
+		memcpy(result + index, &leftVector, sizeof(leftVector)); \
+	} \
+	\
+	for (; index < count; index++) \
+	{ \
+		Type rightValue = isRightScalar? right[0] : right[index]; \
+		switch (operation) \
+		{ \
+			case kSTNumericOperationAdd: result[index] = left[index] + rightValue; break; \
+			case kSTNumericOperationSubtract: result[index] = left[index] - rightValue; break; \
+			case kSTNumericOperationMultiply: result[index] = left[index] * rightValue; break; \
+			case kSTNumericOperationDivide: result[index] = left[index] / rightValue; break; \
+		} \
+	} \
+} \
+\
+static BOOL Name##ContainsZero(const void *values, NSUInteger count) \
+{ \
+	const Type *typedValues = values; \
+	for (NSUInteger index = 0; index < count; index++) \
+	{ \
+		if(typedValues[index] == 0) \
+			return YES; \
+	} \
+	\
+	return NO; \
+} \
+\
+static void Name##Compare(STNumericComparison comparison, const void *leftValues, const void *rightValues, BOOL isRightScalar, int *result, NSUInteger count) \
+{ \
+	const Type *left = leftValues, *right = rightValues; \
+	for (NSUInteger index = 0; index < count; index++) \
+	{ \
+		Type rightValue = isRightScalar? right[0] : right[index]; \
+		switch (comparison) \
+		{ \
+			case kSTNumericComparisonLessThan: result[index] = (left[index] < rightValue); break; \
+			case kSTNumericComparisonGreaterThan: result[index] = (left[index] > rightValue); break; \
+			case kSTNumericComparisonEqualTo: result[index] = (left[index] == rightValue); break; \
+		} \
+	} \
+} \
+\
+/* The sum of the left values is returned when there are no right values. */ \
+static NSNumber *Name##Dot(const void *leftValues, const void *rightValues, NSUInteger count) \
+{ \
+	const Type *left = leftValues, *right = rightValues; \
+	const NSUInteger lanes = sizeof(Name##Vector) / sizeof(Type); \
+	\
+	AccumulatorType total = 0; \
+	NSUInteger index = 0; \
+	if(IsFloatingPoint) \
+	{ \
+		Name##Vector totalVector = {0}; \
+		for (; index + lanes <= count; index += lanes) \
+		{ \
+			Name##Vector leftVector; \
+			memcpy(&leftVector, left + index, sizeof(leftVector)); \
+			if(right) \
+			{ \
+				Name##Vector rightVector; \
+				memcpy(&rightVector, right + index, sizeof(rightVector)); \
+				leftVector = leftVector * rightVector; \
+			} \
+			\
+			totalVector = totalVector + leftVector; \
+		} \
+		\
+		for (NSUInteger lane = 0; lane < lanes; lane++) \
+			total += totalVector[lane]; \
+	} \
+	\
+	for (; index < count; index++) \
+		total += right? (AccumulatorType)left[index] * right[index] : left[index]; \
+	\
+	return [NSNumber BoxSelector:total]; \
+} \
+\
+static NSUInteger Name##IndexOfExtremum(const void *values, NSUInteger count, BOOL findMaximum) \
+{ \
+	const Type *typedValues = values; \
+	NSUInteger extremumIndex = 0; \
+	for (NSUInteger index = 1; index < count; index++) \
+	{ \
+		if(findMaximum? (typedValues[index] > typedValues[extremumIndex]) : (typedValues[index] < typedValues[extremumIndex])) \
+			extremumIndex = index; \
+	} \
+	\
+	return extremumIndex; \
+} \
+\
+static void Name##Scan(const void *values, void *resultValues, NSUInteger count) \
+{ \
+	const Type *typedValues = values; \
+	Type *result = resultValues; \
+	Type total = 0; \
+	for (NSUInteger index = 0; index < count; index++) \
+	{ \
+		total += typedValues[index]; \
+		result[index] = total; \
+	} \
+}
+
+DEFINE_NUMERIC_KERNELS(Int32, int32_t, long long, NO, numberWithLongLong)
+DEFINE_NUMERIC_KERNELS(Int64, int64_t, long long, NO, numberWithLongLong)
+DEFINE_NUMERIC_KERNELS(Float, float, double, YES, numberWithDouble)
+DEFINE_NUMERIC_KERNELS(Double, double, double, YES, numberWithDouble)
+
+///Invokes the kernel of a specified name for a specified numeric type.
+#define DISPATCH_NUMERIC_KERNEL(numericType, Kernel, ...) \
+	switch (numericType) \
+	{ \
+		case kSTNumericTypeInt32: Int32##Kernel(__VA_ARGS__); break; \
+		case kSTNumericTypeInt64: Int64##Kernel(__VA_ARGS__); break; \
+		case kSTNumericTypeFloat: Float##Kernel(__VA_ARGS__); break; \
+		case kSTNumericTypeDouble: Double##Kernel(__VA_ARGS__); break; \
+		case kSTNumericTypeNone: break; \
+	}
+
+///Returns the result of the kernel of a specified name for a specified numeric type.
+#define NUMERIC_KERNEL_RESULT(numericType, Kernel, ...) \
+	((numericType) == kSTNumericTypeInt32? Int32##Kernel(__VA_ARGS__) : \
+	 (numericType) == kSTNumericTypeInt64? Int64##Kernel(__VA_ARGS__) : \
+	 (numericType) == kSTNumericTypeFloat? Float##Kernel(__VA_ARGS__) : \
+	 Double##Kernel(__VA_ARGS__))
+
+#pragma mark - Bulk Conversion
+
+///Invokes a macro with the type character, C type, NSNumber getter, and NSNumber
+///constructor of each primitive type whose values can be converted in bulk.
+#define FOR_EACH_BULK_CONVERTIBLE_TYPE(X) \
+	X('c', char, charValue, numberWithChar) \
+	X('C', unsigned char, unsignedCharValue, numberWithUnsignedChar) \
+	X('s', short, shortValue, numberWithShort) \
+	X('S', unsigned short, unsignedShortValue, numberWithUnsignedShort) \
+	X('i', int, intValue, numberWithInt) \
+	X('I', unsigned int, unsignedIntValue, numberWithUnsignedInt) \
+	X('q', long long, longLongValue, numberWithLongLong) \
+	X('Q', unsigned long long, unsignedLongLongValue, numberWithUnsignedLongLong) \
+	X('f', float, floatValue, numberWithFloat) \
+	X('d', double, doubleValue, numberWithDouble) \
+	X('B', bool, boolValue, numberWithBool)
+
+#pragma mark - Allocation
+
+///The alignment of the bytes of pointers allocated on the heap, chosen to suit the widest vector loads and cache lines.
+#define POINTER_ALIGNMENT		64
+
+///The size at and above which pointers are allocated as anonymous memory mappings.
+#define LARGE_POINTER_SIZE		(1024 * 1024)
+
+///Allocates a zeroed buffer of a specified size.
+///
+/// \param	size		The size of the buffer to allocate. Must be greater than 0.
+/// \param	outStorage	On return, how the buffer was allocated.
+///
+/// \result	The new buffer, or NULL if it could not be allocated.
+static void *AllocateBytes(size_t size, STPointerStorage *outStorage)
+{
+	if(size >= LARGE_POINTER_SIZE)
+	{
+		//The pages of an anonymous mapping are zeroed by the kernel the first time they are touched.
+		void *bytes = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0);
+		if(bytes != MAP_FAILED)
+		{
+			*outStorage = kSTPointerStorageAnonymousMapping;
+			return bytes;
+		}
+	}
+	
+	void *bytes = NULL;
+	if(posix_memalign(&bytes, POINTER_ALIGNMENT, size) != 0)
+		return NULL;
+	
+	bzero(bytes, size);
+	*outStorage = kSTPointerStorageAligned;
+	return bytes;
+}
+
+///Releases a buffer of a specified size allocated with a specified storage.
+static void FreeBytes(void *bytes, size_t size, STPointerStorage storage)
+{
+	switch (storage)
+	{
+		case kSTPointerStorageAligned:
+			free(bytes);
+			break;
+			
+		case kSTPointerStorageAnonymousMapping:
+		case kSTPointerStorageFileMapping:
+			munmap(bytes, size);
+			break;
+			
+		case kSTPointerStorageView:
+			break;
+	}
+}
+
+#pragma mark -
+
+@interface STPointer ()
+
+///The numeric type of the values of the receiver, or kSTNumericTypeNone if the receiver is not an array of numbers.
+@property (readonly) STNumericType numericType;
+
+///Initialize the receiver with a specified buffer.
+- (id)initWithBytes:(void *)bytes length:(size_t)length type:(const char *)type isArray:(BOOL)isArray storage:(STPointerStorage)storage;
+
+///Records that a view or data object has begun referring to the receiver's bytes.
+- (void)addView;
+
+///Records that a view or data object has stopped referring to the receiver's bytes.
+- (void)removeView;
+
+@end
 
 @implementation STPointer
 
 #pragma mark Initialization
 
-///Initialize the receiver with a specified size and a specified type.
-///
-/// \param		size	The size of the pointer's buffer. Must be greater than 0.
-/// \param		type	The type of the value that will be stored in the pointer's buffer. May not be NULL.
+- (void)dealloc
+{
+	if(mStorage == kSTPointerStorageView && [mOwner isKindOfClass:[STPointer class]])
+		[mOwner removeView];
+	
+	FreeBytes(mBytes, mLength, mStorage);
+	free(mType);
+}
+
+///Initialize the receiver with a specified buffer.
 ///
-/// \result		A fully initialized pointer with a buffer to hold the value described.
+/// \param		bytes		The buffer of the pointer. Required.
+/// \param		length		The size of the buffer.
+/// \param		type		The type of the value that will be stored in the pointer's buffer. May not be NULL.
+/// \param		isArray		Whether or not the pointer is an array pointer.
+/// \param		storage		How the buffer was allocated. The receiver takes ownership of the buffer unless it is a view.
 ///
-///You do not generally use this initializer to create a pointer object. Rather, it is
-///recommended that you use `pointerWithType:` or `arrayPointerOfLength:type:` to create
-///your pointer objects.
-- (id)initWithSize:(size_t)size type:(const char *)type isArray:(BOOL)isArray
+/// \result		A fully initialized pointer.
+- (id)initWithBytes:(void *)bytes length:(size_t)length type:(const char *)type isArray:(BOOL)isArray storage:(STPointerStorage)storage
 {
-	NSAssert((size > 0), @"Size is 0. You cannot create an empty pointer.");
+	NSParameterAssert(bytes);
 	NSParameterAssert(type);
 	
 	if((self = [super init]))
 	{
-		mType = NSAllocateCollectable(strlen(type) + 1, 0);
+		mType = malloc(strlen(type) + 1);
 		NSAssert((mType != NULL), @"Could not allocate type buffer for pointer of type %s.", type);
 		
 		strcpy(mType, type);
 		
 		
-		mBytes = NSAllocateCollectable(size, 0);
-		NSAssert((mBytes != NULL), @"Could not allocate pointer storage of size %ld.", size);
-		
-		bzero(mBytes, size);
-		
-		
-		mLength = size;
+		mBytes = bytes;
+		mLength = length;
+		mStorage = storage;
 		
 		mIsArray = isArray;
 		
@@ -53,6 +342,28 @@
 	return nil;
 }
 
+///Initialize the receiver with a specified size and a specified type.
+///
+/// \param		size	The size of the pointer's buffer. Must be greater than 0.
+/// \param		type	The type of the value that will be stored in the pointer's buffer. May not be NULL.
+///
+/// \result		A fully initialized pointer with a zeroed buffer to hold the value described.
+///
+///You do not generally use this initializer to create a pointer object. Rather, it is
+///recommended that you use `pointerWithType:` or `arrayPointerOfLength:type:` to create
+///your pointer objects.
+- (id)initWithSize:(size_t)size type:(const char *)type isArray:(BOOL)isArray
+{
+	NSAssert((size > 0), @"Size is 0. You cannot create an empty pointer.");
+	NSParameterAssert(type);
+	
+	STPointerStorage storage = kSTPointerStorageAligned;
+	void *bytes = AllocateBytes(size, &storage);
+	NSAssert((bytes != NULL), @"Could not allocate pointer storage of size %ld.", size);
+	
+	return [self initWithBytes:bytes length:size type:type isArray:isArray storage:storage];
+}
+
 ///Initialize the receiver as a pointer suitable to hold a single object.
 - (id)init
 {
@@ -75,10 +386,157 @@
 	return [[self alloc] initWithSize:(sizeOfType * length) type:type isArray:YES];
 }
 
++ (STPointer *)arrayPointerMappingFileAtPath:(NSString *)path type:(const char *)type mode:(STPointerMappingMode)mode error:(NSError **)error
+{
+	NSParameterAssert(path);
+	NSParameterAssert(type);
+	
+	int fileDescriptor = open([path fileSystemRepresentation], O_RDONLY);
+	if(fileDescriptor == -1)
+	{
+		if(error)
+			*error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+		return nil;
+	}
+	
+	struct stat fileInfo;
+	if(fstat(fileDescriptor, &fileInfo) == -1)
+	{
+		if(error)
+			*error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+		close(fileDescriptor);
+		return nil;
+	}
+	
+	//Files larger than the address space, which is possible on 32-bit systems, cannot be mapped whole.
+	if((uintmax_t)fileInfo.st_size > (uintmax_t)SIZE_MAX)
+	{
+		if(error)
+			*error = [NSError errorWithDomain:NSPOSIXErrorDomain code:EFBIG userInfo:nil];
+		close(fileDescriptor);
+		return nil;
+	}
+	
+	size_t length = (size_t)fileInfo.st_size;
+	if(length < STTypeBridgeGetSizeOfObjCType(type))
+	{
+		if(error)
+			*error = [NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:nil];
+		close(fileDescriptor);
+		return nil;
+	}
+	
+	//Private mappings of a file opened for reading can still be written to, with the pages
+	//that are written to being copied by the kernel rather than being written back to the file.
+	int protection = (mode == kSTPointerMappingModeCopyOnWrite)? (PROT_READ | PROT_WRITE) : PROT_READ;
+	void *bytes = mmap(NULL, length, protection, MAP_PRIVATE, fileDescriptor, 0);
+	int mappingError = errno;
+	close(fileDescriptor);
+	
+	if(bytes == MAP_FAILED)
+	{
+		if(error)
+			*error = [NSError errorWithDomain:NSPOSIXErrorDomain code:mappingError userInfo:nil];
+		return nil;
+	}
+	
+	STPointer *pointer = [[self alloc] initWithBytes:bytes length:length type:type isArray:YES storage:kSTPointerStorageFileMapping];
+	pointer->mIsReadOnly = (mode == kSTPointerMappingModeReadOnly);
+	return pointer;
+}
+
++ (STPointer *)arrayPointerWithValues:(id <NSFastEnumeration>)values type:(const char *)type
+{
+	NSParameterAssert(values);
+	NSParameterAssert(type);
+	
+	NSUInteger count = [(NSArray *)values count];
+	STPointer *pointer = [self arrayPointerOfLength:count type:type];
+	void *bytes = pointer->mBytes;
+	NSUInteger index = 0;
+	
+	//The type is only examined once, rather than once per value as `setValue:atIndex:` does.
+	switch (type[0])
+	{
+#define UNBOX_VALUES(typeCharacter, CType, getter, constructor) \
+		case typeCharacter: \
+			for (id value in values) \
+			{ \
+				if(index == count) \
+					break; \
+				\
+				((CType *)bytes)[index++] = [value getter]; \
+			} \
+			break;
+			
+		FOR_EACH_BULK_CONVERTIBLE_TYPE(UNBOX_VALUES)
+#undef UNBOX_VALUES
+			
+		default: {
+			size_t sizeOfType = STTypeBridgeGetSizeOfObjCType(type);
+			for (id value in values)
+			{
+				if(index == count)
+					break;
+				
+				STTypeBridgeConvertObjectIntoType(value, type, (void **)((Byte *)bytes + (sizeOfType * index++)));
+			}
+			break;
+		}
+	}
+	
+	return pointer;
+}
+
+#pragma mark - Borrowing
+
++ (STPointer *)pointerBorrowingBytes:(void *)bytes type:(const char *)type owner:(id)owner
+{
+	STPointer *pointer = [[self alloc] initWithBytes:bytes length:STTypeBridgeGetSizeOfObjCType(type) type:type isArray:NO storage:kSTPointerStorageView];
+	pointer->mOwner = owner;
+	if([owner isKindOfClass:[STPointer class]])
+		[owner addView];
+	
+	return pointer;
+}
+
++ (STPointer *)arrayPointerBorrowingBytes:(void *)bytes count:(NSUInteger)count type:(const char *)type owner:(id)owner
+{
+	NSAssert((count > 0), @"Count is 0. You cannot create an empty pointer array.");
+	
+	size_t sizeOfType = STTypeBridgeGetSizeOfObjCType(type);
+	STPointer *pointer = [[self alloc] initWithBytes:bytes length:(sizeOfType * count) type:type isArray:YES storage:kSTPointerStorageView];
+	pointer->mOwner = owner;
+	if([owner isKindOfClass:[STPointer class]])
+		[owner addView];
+	
+	return pointer;
+}
+
++ (STPointer *)arrayPointerWithData:(NSData *)data type:(const char *)type
+{
+	NSParameterAssert(data);
+	NSParameterAssert(type);
+	
+	size_t sizeOfType = STTypeBridgeGetSizeOfObjCType(type);
+	NSAssert(([data length] >= sizeOfType), @"Data of length %ld is too short to hold a value of type %s.", [data length], type);
+	
+	if([data isKindOfClass:[NSMutableData class]])
+		return [self arrayPointerBorrowingBytes:[(NSMutableData *)data mutableBytes] count:([data length] / sizeOfType) type:type owner:data];
+	
+	STPointer *pointer = [self arrayPointerBorrowingBytes:(void *)[data bytes] count:([data length] / sizeOfType) type:type owner:data];
+	pointer->mIsReadOnly = YES;
+	return pointer;
+}
+
 #pragma mark - Copying
 
 - (id)copyWithZone:(NSZone *)zone
 {
+	//Read-only pointers can never change, so they do not need to be copied.
+	if(mIsReadOnly)
+		return self;
+	
 	STPointer *pointer = [[STPointer allocWithZone:zone] initWithSize:mLength type:mType isArray:mIsArray];
 	memcpy(pointer.bytes, mBytes, mLength);
 	
@@ -106,37 +564,64 @@
 }
 
 - (NSString *)prettyDescription
+{
+	return [STOutput prettyDescriptionOfObject:self];
+}
+
+- (void)writePrettyDescriptionToOutput:(STOutput *)output
 {
 	if(mIsArray)
 	{
-		NSMutableString *description = [NSMutableString stringWithString:@"ref {\n"];
+		[output writeString:@"ref {\n"];
 		
 		NSUInteger pointerCount = self.count;
 		for (NSUInteger index = 0; index < pointerCount; index++)
 		{
-			[description appendFormat:@"\t%@,\n", [[self valueAtIndex:index] prettyDescription]];
+			[output writeString:@"\t"];
+			[[self valueAtIndex:index] writePrettyDescriptionToOutput:output];
+			[output writeString:@",\n"];
 		}
 		
-		[description appendString:@"}"];
-		
-		return description;
+		[output writeString:@"}"];
+	}
+	else
+	{
+		[output writeString:@"ref "];
+		[self.value writePrettyDescriptionToOutput:output];
 	}
-	
-	return [NSString stringWithFormat:@"ref %@", [self.value prettyDescription]];
 }
 
 #pragma mark - Properties
 
 @synthesize bytes = mBytes;
 @synthesize type = mType;
+@synthesize isArray = mIsArray;
 
 #pragma mark -
 
 @synthesize length = mLength;
+@synthesize storage = mStorage;
+@synthesize readOnly = mIsReadOnly;
+@synthesize owner = mOwner;
+
+///The key under which data objects created by `-[STPointer data]` are associated with a view of the pointer's bytes.
+static NSString *const kSTPointerDataViewKey = @"STPointerDataView";
+
+- (NSData *)data
+{
+	//The data is associated with a view of the receiver's bytes, which keeps their owner alive for as long as the data.
+	id owner = (mStorage == kSTPointerStorageView && mOwner)? mOwner : self;
+	STPointer *view = [STPointer arrayPointerBorrowingBytes:mBytes count:mLength type:@encode(unsigned char) owner:owner];
+	
+	NSData *data = [NSData dataWithBytesNoCopy:mBytes length:mLength freeWhenDone:NO];
+	objc_setAssociatedObject(data, (__bridge const void *)(kSTPointerDataViewKey), view, OBJC_ASSOCIATION_RETAIN);
+	return data;
+}
 
 - (void)setValue:(id)value
 {
 	NSAssert(!mIsArray, @"You cannot mutate the contents of a pointer array through the value property.");
+	NSAssert(!mIsReadOnly, @"You cannot mutate the contents of a read-only pointer.");
 	
 	NSParameterAssert(value);
 	
@@ -150,14 +635,42 @@
 	return STTypeBridgeConvertValueOfTypeIntoObject(mBytes, mType);
 }
 
+#pragma mark - Views
+
+- (void)addView
+{
+	OSAtomicIncrement32Barrier(&mViewCount);
+}
+
+- (void)removeView
+{
+	OSAtomicDecrement32Barrier(&mViewCount);
+}
+
 #pragma mark - Array Pointers
 
 - (void)setCount:(NSUInteger)count
 {
 	NSAssert(mIsArray, @"count is not available for non-array pointers.");
+	NSAssert((mStorage == kSTPointerStorageAligned || mStorage == kSTPointerStorageAnonymousMapping), @"Only pointers that own their bytes may be resized.");
+	NSAssert((count > 0), @"Count is 0. You cannot create an empty pointer array.");
+	
+	//Freeing the bytes out from under a view would leave it referring to released memory.
+	if(mViewCount > 0)
+		[NSException raise:NSInternalInconsistencyException format:@"You cannot resize a pointer array while slices or data objects refer to its bytes."];
+	
+	//realloc does not preserve alignment, so the values are moved into a new buffer.
+	size_t length = STTypeBridgeGetSizeOfObjCType(mType) * count;
+	STPointerStorage storage = kSTPointerStorageAligned;
+	void *bytes = AllocateBytes(length, &storage);
+	NSAssert((bytes != NULL), @"Could not resize pointer of type %s to count %ld.", mType, count);
 	
-	NSAssert(NSReallocateCollectable(mBytes, (STTypeBridgeGetSizeOfObjCType(mType) * count), 0),
-			 @"Could not resize pointer of type %s to count %ld.", mType, count);
+	memcpy(bytes, mBytes, MIN(length, mLength));
+	FreeBytes(mBytes, mLength, mStorage);
+	
+	mBytes = bytes;
+	mLength = length;
+	mStorage = storage;
 }
 
 - (NSUInteger)count
@@ -167,11 +680,37 @@
 	return (mLength / STTypeBridgeGetSizeOfObjCType(mType));
 }
 
+- (STPointer *)sliceWithRange:(NSRange)range
+{
+	NSAssert(mIsArray, @"You cannot slice a non-array pointer.");
+	NSAssert((NSMaxRange(range) <= self.count), @"Range %@ is beyond pointer bounds %ld.", NSStringFromRange(range), self.count);
+	
+	//Slices of views refer to the object that owns the storage directly.
+	size_t sizeOfType = STTypeBridgeGetSizeOfObjCType(mType);
+	STPointer *slice = [STPointer arrayPointerBorrowingBytes:((Byte *)mBytes + (range.location * sizeOfType))
+													   count:range.length
+														type:mType
+													   owner:(mStorage == kSTPointerStorageView)? mOwner : self];
+	slice->mIsReadOnly = mIsReadOnly;
+	return slice;
+}
+
+- (STPointer *)arrayPointerOfCount:(NSUInteger)count
+{
+	STPointer *pointer = [STPointer arrayPointerBorrowingBytes:mBytes
+														 count:count
+														  type:mType
+														 owner:(mStorage == kSTPointerStorageView)? mOwner : self];
+	pointer->mIsReadOnly = mIsReadOnly;
+	return pointer;
+}
+
 #pragma mark -
 
 - (void)setValue:(id)value atIndex:(NSUInteger)index
 {
 	NSAssert(mIsArray, @"You cannot mutate the contents of a non-pointer array through setValue:atIndex:");
+	NSAssert(!mIsReadOnly, @"You cannot mutate the contents of a read-only pointer.");
 	
 	NSParameterAssert(value);
 	NSAssert((index < self.count), @"Index %ld is beyond pointer bounds %ld.", index, self.count);
@@ -241,4 +780,275 @@
 	return filteredPointerArray;
 }
 
+#pragma mark - Aggregation
+
+- (NSArray *)values
+{
+	NSAssert(mIsArray, @"You cannot convert the values of a non-array pointer.");
+	
+	NSUInteger valueCount = self.count;
+	NSMutableArray *values = [NSMutableArray arrayWithCapacity:valueCount];
+	switch (mType[0])
+	{
+#define BOX_VALUES(typeCharacter, CType, getter, constructor) \
+		case typeCharacter: \
+			for (NSUInteger index = 0; index < valueCount; index++) \
+				[values addObject:[NSNumber constructor:((CType *)mBytes)[index]]]; \
+			break;
+			
+		FOR_EACH_BULK_CONVERTIBLE_TYPE(BOX_VALUES)
+#undef BOX_VALUES
+			
+		default:
+			for (NSUInteger index = 0; index < valueCount; index++)
+			{
+				[values addObject:[self valueAtIndex:index]];
+			}
+			break;
+	}
+	
+	return values;
+}
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	return STEnumerableReduce([self values], function, initial);
+}
+
+- (id)sum
+{
+	STNumericType numericType = self.numericType;
+	if(numericType != kSTNumericTypeNone)
+		return NUMERIC_KERNEL_RESULT(numericType, Dot, mBytes, NULL, self.count);
+	
+	return STEnumerableSum([self values]);
+}
+
+- (id)min
+{
+	STNumericType numericType = self.numericType;
+	if(numericType != kSTNumericTypeNone)
+		return [self valueAtIndex:NUMERIC_KERNEL_RESULT(numericType, IndexOfExtremum, mBytes, self.count, NO)];
+	
+	return STEnumerableMinimum([self values]);
+}
+
+- (id)max
+{
+	STNumericType numericType = self.numericType;
+	if(numericType != kSTNumericTypeNone)
+		return [self valueAtIndex:NUMERIC_KERNEL_RESULT(numericType, IndexOfExtremum, mBytes, self.count, YES)];
+	
+	return STEnumerableMaximum([self values]);
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	return STEnumerableCount([self values], function);
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	return STEnumerableGroup([self values], function);
+}
+
+#pragma mark - Numeric Arrays
+
+- (STNumericType)numericType
+{
+	if(!mIsArray)
+		return kSTNumericTypeNone;
+	
+	switch (mType[0])
+	{
+		case 'i':
+			return kSTNumericTypeInt32;
+			
+		case 'l':
+		case 'q':
+			return (STTypeBridgeGetSizeOfObjCType(mType) == sizeof(int64_t))? kSTNumericTypeInt64 : kSTNumericTypeInt32;
+			
+		case 'f':
+			return kSTNumericTypeFloat;
+			
+		case 'd':
+			return kSTNumericTypeDouble;
+			
+		default:
+			return kSTNumericTypeNone;
+	}
+}
+
+- (BOOL)isNumericArray
+{
+	return (self.numericType != kSTNumericTypeNone);
+}
+
+///Returns the values of an operand for a numeric kernel applied to the receiver.
+///
+/// \param	operand			A pointer array with the same type and count as the receiver, or a number. Required.
+/// \param	scalarBuffer	A buffer to convert `operand` into when it is a number. Must be at least 8 bytes.
+/// \param	outIsScalar		On return, whether or not `operand` was a number.
+///
+/// \result	The values of `operand`.
+- (const void *)valuesOfOperand:(id)operand scalarBuffer:(void *)scalarBuffer isScalar:(BOOL *)outIsScalar
+{
+	NSAssert(self.numericType != kSTNumericTypeNone, @"Numeric operations are only available for arrays of int, long, float, and double values.");
+	
+	if([operand isKindOfClass:[STPointer class]])
+	{
+		STPointer *pointer = operand;
+		if(pointer.numericType != self.numericType || pointer.count != self.count)
+		{
+			[NSException raise:NSInvalidArgumentException 
+						format:@"Cannot combine pointer array %s[%lu] with %s[%lu].", mType, (unsigned long)self.count, pointer.type, (unsigned long)(pointer->mIsArray? pointer.count : 0)];
+		}
+		
+		*outIsScalar = NO;
+		return pointer.bytes;
+	}
+	
+	STTypeBridgeConvertObjectIntoType(operand, mType, (void **)scalarBuffer);
+	*outIsScalar = YES;
+	return scalarBuffer;
+}
+
+///Returns a pointer array of the receiver's type containing the result of applying an operation to each value of the receiver.
+- (STPointer *)pointerByApplyingOperation:(STNumericOperation)operation withOperand:(id)operand
+{
+	int64_t scalarBuffer = 0;
+	BOOL isRightScalar = NO;
+	const void *rightValues = [self valuesOfOperand:operand scalarBuffer:&scalarBuffer isScalar:&isRightScalar];
+	
+	STNumericType numericType = self.numericType;
+	NSUInteger count = self.count;
+	if(operation == kSTNumericOperationDivide && (numericType == kSTNumericTypeInt32 || numericType == kSTNumericTypeInt64))
+	{
+		if(NUMERIC_KERNEL_RESULT(numericType, ContainsZero, rightValues, isRightScalar? 1 : count))
+			[NSException raise:NSInvalidArgumentException format:@"Cannot divide pointer array %s[%lu] by zero.", mType, (unsigned long)count];
+	}
+	
+	STPointer *result = [STPointer arrayPointerOfLength:count type:mType];
+	DISPATCH_NUMERIC_KERNEL(numericType, Apply, operation, mBytes, rightValues, isRightScalar, result.bytes, count);
+	
+	return result;
+}
+
+///Returns an int pointer array containing 1 for each value of the receiver that satisfies a comparison, and 0 for the rest.
+- (STPointer *)pointerByComparing:(STNumericComparison)comparison withOperand:(id)operand
+{
+	int64_t scalarBuffer = 0;
+	BOOL isRightScalar = NO;
+	const void *rightValues = [self valuesOfOperand:operand scalarBuffer:&scalarBuffer isScalar:&isRightScalar];
+	
+	NSUInteger count = self.count;
+	STPointer *mask = [STPointer arrayPointerOfLength:count type:@encode(int)];
+	DISPATCH_NUMERIC_KERNEL(self.numericType, Compare, comparison, mBytes, rightValues, isRightScalar, mask.bytes, count);
+	
+	return mask;
+}
+
+#pragma mark -
+
+- (id)operatorAdd:(id)rightOperand
+{
+	if(!self.isNumericArray)
+		return [super operatorAdd:rightOperand];
+	
+	return [self pointerByApplyingOperation:kSTNumericOperationAdd withOperand:rightOperand];
+}
+
+- (id)operatorSubtract:(id)rightOperand
+{
+	if(!self.isNumericArray)
+		return [super operatorSubtract:rightOperand];
+	
+	return [self pointerByApplyingOperation:kSTNumericOperationSubtract withOperand:rightOperand];
+}
+
+- (id)operatorMultiply:(id)rightOperand
+{
+	if(!self.isNumericArray)
+		return [super operatorMultiply:rightOperand];
+	
+	return [self pointerByApplyingOperation:kSTNumericOperationMultiply withOperand:rightOperand];
+}
+
+- (id)operatorDivide:(id)rightOperand
+{
+	if(!self.isNumericArray)
+		return [super operatorDivide:rightOperand];
+	
+	return [self pointerByApplyingOperation:kSTNumericOperationDivide withOperand:rightOperand];
+}
+
+#pragma mark -
+
+- (STPointer *)lessThan:(id)operand
+{
+	return [self pointerByComparing:kSTNumericComparisonLessThan withOperand:operand];
+}
+
+- (STPointer *)greaterThan:(id)operand
+{
+	return [self pointerByComparing:kSTNumericComparisonGreaterThan withOperand:operand];
+}
+
+- (STPointer *)equalTo:(id)operand
+{
+	return [self pointerByComparing:kSTNumericComparisonEqualTo withOperand:operand];
+}
+
+#pragma mark -
+
+- (NSNumber *)dot:(STPointer *)pointer
+{
+	NSParameterAssert(pointer);
+	
+	int64_t scalarBuffer = 0;
+	BOOL isScalar = NO;
+	const void *values = [self valuesOfOperand:pointer scalarBuffer:&scalarBuffer isScalar:&isScalar];
+	NSAssert(!isScalar, @"dot: requires a pointer array, not a number.");
+	
+	return NUMERIC_KERNEL_RESULT(self.numericType, Dot, mBytes, values, self.count);
+}
+
+- (STPointer *)scan
+{
+	NSAssert(self.isNumericArray, @"scan is only available for arrays of int, long, float, and double values.");
+	
+	NSUInteger count = self.count;
+	STPointer *result = [STPointer arrayPointerOfLength:count type:mType];
+	DISPATCH_NUMERIC_KERNEL(self.numericType, Scan, mBytes, result.bytes, count);
+	
+	return result;
+}
+
+#pragma mark - Parallel Enumeration
+
+///Returns a pointer array of the receiver's type containing the objects of a specified array, or nil if the array is empty.
+- (STPointer *)pointerWithValues:(NSArray *)values
+{
+	//Pointer arrays cannot be empty.
+	if([values count] == 0)
+		return nil;
+	
+	return [STPointer arrayPointerWithValues:values type:mType];
+}
+
+- (STPointer *)pmap:(id <STFunction>)function
+{
+	return [self pointerWithValues:STEnumerableParallelMap([self values], function)];
+}
+
+- (STPointer *)pfilter:(id <STFunction>)function
+{
+	return [self pointerWithValues:STEnumerableParallelFilter([self values], function)];
+}
+
+- (id)preduce:(id <STFunction>)function
+{
+	return STEnumerableParallelReduce([self values], function);
+}
+
 @end
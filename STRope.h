@@ -0,0 +1,51 @@
+//
+//  STRope.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+///The STRope class is an immutable string built from a tree of other strings that can be concatenated in constant time.
+///
+///Concatenating a rope with `+` or `-[STRope ropeByAppendingString:]` creates a new node referring to
+///both operands rather than copying their characters. The characters of a rope are only gathered into
+///a single string the first time they are needed by a method inherited from NSString, after which the
+///flattened string is kept for the lifetime of the rope. Writing a rope to a file handle or printing it
+///writes each of its pieces in turn, and never flattens it.
+///
+///Ropes are created in Stein with the `rope` function.
+@interface STRope : NSString
+{
+	NSString *mLeft;
+	NSString *mRight;
+	NSUInteger mLength;
+	NSUInteger mDepth;
+	
+	NSString *mFlattenedString;
+}
+
+#pragma mark Creation
+
+///Returns the empty rope.
++ (STRope *)rope;
+
+///Returns a rope containing a specified string. If the string is already a rope it is returned as-is.
++ (STRope *)ropeWithString:(NSString *)string;
+
+#pragma mark - Concatenation
+
+///Returns a rope containing the receiver followed by a specified string.
+- (STRope *)ropeByAppendingString:(NSString *)string;
+
+#pragma mark - Pieces
+
+///Enumerate the strings the receiver is built from in order, without flattening the receiver.
+- (void)enumeratePiecesUsingBlock:(void (^)(NSString *piece, BOOL *stop))block;
+
+///Write the contents of the receiver to a specified file handle as UTF-8, one piece at a time.
+- (void)writeToFileHandle:(NSFileHandle *)fileHandle;
+
+@end
@@ -0,0 +1,263 @@
+//
+//  STRope.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STRope.h"
+#import "STAppendableCollections.h"
+#import "STOutput.h"
+
+///Pieces shorter than this are merged into the piece before them when appended.
+#define SHORT_PIECE_LENGTH		256
+
+///The longest piece that short pieces will be merged into.
+#define MAXIMUM_MERGED_LENGTH	4096
+
+///The depth past which a rope's tree is rebuilt to be balanced.
+#define MAXIMUM_DEPTH			64
+
+@interface STRope ()
+
+///Returns the characters of the receiver as a single string, creating it if needed.
+- (NSString *)flattenedString;
+
+@end
+
+#pragma mark - Nodes
+
+///Returns the depth of the tree of a specified piece.
+ST_INLINE NSUInteger Depth(NSString *piece)
+{
+	return [piece isKindOfClass:[STRope class]]? ((STRope *)piece)->mDepth : 0;
+}
+
+///Returns the string contained in a rope without any children, or the piece itself otherwise.
+ST_INLINE NSString *Unwrap(NSString *piece)
+{
+	if([piece isKindOfClass:[STRope class]] && ((STRope *)piece)->mRight == nil)
+		return ((STRope *)piece)->mLeft;
+	
+	return piece;
+}
+
+///Returns a new rope whose children are two specified pieces.
+static STRope *NewNode(NSString *left, NSString *right)
+{
+	STRope *node = [STRope new];
+	node->mLeft = left;
+	node->mRight = right;
+	node->mLength = [left length] + [right length];
+	node->mDepth = MAX(Depth(left), Depth(right)) + 1;
+	return node;
+}
+
+///Returns a piece containing one piece followed by another.
+///
+///Appending to a node whose right subtree is shallower than its left descends into the right
+///subtree, so that ropes built by appending remain balanced like the digits of a binary counter.
+static NSString *Concatenate(NSString *left, NSString *right)
+{
+	left = Unwrap(left);
+	right = Unwrap(right);
+	
+	if(Depth(left) == 0 && [right length] < SHORT_PIECE_LENGTH && [left length] + [right length] <= MAXIMUM_MERGED_LENGTH)
+		return [STAppendableString stringWithString:left byAppendingString:right];
+	
+	if(Depth(left) > 0)
+	{
+		STRope *node = (STRope *)left;
+		if(Depth(node->mRight) < Depth(node->mLeft))
+			return NewNode(node->mLeft, Concatenate(node->mRight, right));
+	}
+	
+	return NewNode(left, right);
+}
+
+///Enumerates the pieces of a specified string in order. Returns NO if the enumeration was stopped.
+static BOOL EnumeratePieces(NSString *string, void (^block)(NSString *piece, BOOL *stop))
+{
+	if([string isKindOfClass:[STRope class]])
+	{
+		STRope *rope = (STRope *)string;
+		NSString *flattenedString = nil;
+		@synchronized(rope)
+		{
+			flattenedString = rope->mFlattenedString;
+		}
+		
+		if(flattenedString)
+			return EnumeratePieces(flattenedString, block);
+		
+		if(!EnumeratePieces(rope->mLeft, block))
+			return NO;
+		
+		return rope->mRight? EnumeratePieces(rope->mRight, block) : YES;
+	}
+	
+	if([string length] == 0)
+		return YES;
+	
+	BOOL stop = NO;
+	block(string, &stop);
+	return !stop;
+}
+
+///Returns a balanced tree built from a specified range of an array of pieces.
+static NSString *BuildBalancedTree(NSArray *pieces, NSRange range)
+{
+	if(range.length == 1)
+		return [pieces objectAtIndex:range.location];
+	
+	NSUInteger half = range.length / 2;
+	return NewNode(BuildBalancedTree(pieces, NSMakeRange(range.location, half)),
+				   BuildBalancedTree(pieces, NSMakeRange(range.location + half, range.length - half)));
+}
+
+#pragma mark -
+
+@implementation STRope
+
+#pragma mark Creation
+
++ (STRope *)rope
+{
+	static STRope *emptyRope = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		emptyRope = [STRope new];
+		emptyRope->mLeft = @"";
+	});
+	
+	return emptyRope;
+}
+
++ (STRope *)ropeWithString:(NSString *)string
+{
+	NSParameterAssert(string);
+	
+	if([string isKindOfClass:[STRope class]])
+		return (STRope *)string;
+	
+	if([string length] == 0)
+		return [self rope];
+	
+	STRope *rope = [STRope new];
+	rope->mLeft = [string copy];
+	rope->mLength = [string length];
+	return rope;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	return self;
+}
+
+#pragma mark - Concatenation
+
+- (STRope *)ropeByAppendingString:(NSString *)string
+{
+	NSParameterAssert(string);
+	
+	if([string length] == 0)
+		return self;
+	
+	if(mLength == 0)
+		return [STRope ropeWithString:string];
+	
+	NSString *result = Concatenate(self, [string copy]);
+	if(Depth(result) > MAXIMUM_DEPTH)
+	{
+		//Ropes built by prepending are not kept balanced as they are built, so they are rebuilt when they become too deep.
+		NSMutableArray *pieces = [NSMutableArray array];
+		EnumeratePieces(result, ^(NSString *piece, BOOL *stop) {
+			[pieces addObject:piece];
+		});
+		
+		result = BuildBalancedTree(pieces, NSMakeRange(0, [pieces count]));
+	}
+	
+	return [STRope ropeWithString:result];
+}
+
+- (id)operatorAdd:(id)rightOperand
+{
+	return [self ropeByAppendingString:[rightOperand string]];
+}
+
+#pragma mark - Pieces
+
+- (void)enumeratePiecesUsingBlock:(void (^)(NSString *piece, BOOL *stop))block
+{
+	NSParameterAssert(block);
+	
+	EnumeratePieces(self, block);
+}
+
+- (void)writeToFileHandle:(NSFileHandle *)fileHandle
+{
+	NSParameterAssert(fileHandle);
+	
+	EnumeratePieces(self, ^(NSString *piece, BOOL *stop) {
+		[fileHandle writeData:[piece dataUsingEncoding:NSUTF8StringEncoding]];
+	});
+}
+
+- (NSString *)print
+{
+	STOutput *output = [STOutput standardOutput];
+	[output lock];
+	EnumeratePieces(self, ^(NSString *piece, BOOL *stop) {
+		[output writeString:piece];
+	});
+	[output finishLine];
+	[output unlock];
+	
+	return self;
+}
+
+#pragma mark - Primitive Methods
+
+- (NSString *)flattenedString
+{
+	@synchronized(self)
+	{
+		if(!mFlattenedString)
+		{
+			if(mRight)
+			{
+				NSMutableString *flattenedString = [NSMutableString stringWithCapacity:mLength];
+				EnumeratePieces(self, ^(NSString *piece, BOOL *stop) {
+					[flattenedString appendString:piece];
+				});
+				
+				mFlattenedString = [flattenedString copy];
+			}
+			else
+			{
+				mFlattenedString = mLeft;
+			}
+		}
+		
+		return mFlattenedString;
+	}
+}
+
+- (NSUInteger)length
+{
+	return mLength;
+}
+
+- (unichar)characterAtIndex:(NSUInteger)index
+{
+	return [[self flattenedString] characterAtIndex:index];
+}
+
+- (void)getCharacters:(unichar *)buffer range:(NSRange)range
+{
+	[[self flattenedString] getCharacters:buffer range:range];
+}
+
+@end
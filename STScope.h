@@ -44,6 +44,19 @@
 ///The scope that precedes this scope in the lookup chain.
 @property STScope *parentScope;
 
+///	Returns a scope containing only the specified variables of the receiver's transient scope chain.
+///
+/// \param		names	The names of the variables to capture. Required.
+/// \result	A new scope whose parent is the nearest long-lived scope in the receiver's chain, or
+///				the receiver itself if the receiver is long-lived.
+///
+///The variables of the returned scope share their storage with the scopes they were captured
+///from, so assignments made through either are visible to both. Names that are not yet bound
+///anywhere in the chain are reserved in the receiver so that later bindings are still captured.
+///
+///This method is used to keep closures from retaining every scope enclosing their definition.
+- (STScope *)scopeByCapturingVariablesNamed:(NSSet *)names;
+
 #pragma mark - Variables
 
 ///	Adds values for all of the variables in a specified scope.
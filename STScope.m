@@ -7,6 +7,22 @@
 //
 
 #import "STScope.h"
+#import "STModule.h"
+
+///The STScopeBox class is a mutable cell that holds the value of a scope node once
+///the node has been captured by a closure. Every node sharing a box sees the same value.
+@interface STScopeBox : NSObject
+
+///The value of the box.
+@property id value;
+
+@end
+
+@implementation STScopeBox
+
+@end
+
+#pragma mark -
 
 ///The STScopeNode class is a linked list of key-value pairs
 ///used to implement the thread-safe STScope storage class.
@@ -14,6 +30,9 @@
 {
     NSString *_key;
     BOOL _readonly;
+    
+    id _value;
+    STScopeBox *_box;
 }
 
 ///Initialized the receiver with a given key and whether or not it is readonly.
@@ -24,6 +43,15 @@
 /// \param A fully initialized scope node.
 - (id)initWithKey:(NSString *)key readonly:(BOOL)readonly;
 
+///Initialized the receiver with a given key, and a box whose value it is to share.
+///
+/// \param  key         The key. Required.
+/// \param  box         The box holding the node's value. Required.
+/// \param  readonly    Whether or not the node is readonly.
+///
+/// \param A fully initialized scope node.
+- (id)initWithKey:(NSString *)key box:(STScopeBox *)box readonly:(BOOL)readonly;
+
 #pragma mark - Properties
 
 ///The previous scope node in the chain.
@@ -41,6 +69,12 @@
 ///The value of the scope node.
 @property id value;
 
+///The box holding the value of the scope node.
+///
+///Nodes store their values inline until this property is first
+///accessed, after which the value lives in the returned box.
+@property (readonly) STScopeBox *box;
+
 #pragma mark - Identity
 
 ///Returns a boolean indicating whether or not the receiver is equal to another scope node.
@@ -66,11 +100,57 @@
     return self;
 }
 
+- (id)initWithKey:(NSString *)key box:(STScopeBox *)box readonly:(BOOL)readonly
+{
+    NSParameterAssert(box);
+    
+    if((self = [self initWithKey:key readonly:readonly]))
+    {
+        _box = box;
+    }
+    
+    return self;
+}
+
 #pragma mark - Properties
 
 @synthesize key = _key;
 @synthesize readonly = _readonly;
 
+- (void)setValue:(id)value
+{
+    STScopeBox *box = _box;
+    if(box)
+        box.value = value;
+    else
+        _value = value;
+}
+
+- (id)value
+{
+    STScopeBox *box = _box;
+    if(box)
+        return box.value;
+    
+    return _value;
+}
+
+- (STScopeBox *)box
+{
+    @synchronized(self)
+    {
+        if(!_box)
+        {
+            STScopeBox *box = [STScopeBox new];
+            box.value = _value;
+            _value = nil;
+            _box = box;
+        }
+        
+        return _box;
+    }
+}
+
 #pragma mark - Identity
 
 - (BOOL)isEqual:(id)object
@@ -108,7 +188,12 @@ static void EnumerateScopeNodeChain(STScopeNode *me, void(^callback)(STScopeNode
 	BOOL stop = NO;
 	for (STScopeNode *node = me; node != nil; node = node.next)
 	{
-		callback(node, node.key, node.value, &stop);
+		//Nodes reserved for closures that have not been bound yet have no value.
+		id value = node.value;
+		if(!value)
+			continue;
+		
+		callback(node, node.key, value, &stop);
 		if(stop)
 			break;
 	}
@@ -154,6 +239,63 @@ static void EnumerateScopeNodeChain(STScopeNode *me, void(^callback)(STScopeNode
 	}
 }
 
+#pragma mark -
+
+///Returns whether or not a scope outlives the function calls made beneath it. Modules,
+///named scopes, and the root of a scope chain are all considered to be long-lived.
+static BOOL IsScopeLongLived(STScope *scope)
+{
+	return (scope.parentScope == nil || scope.name != nil || [scope isKindOfClass:[STModule class]]);
+}
+
+- (STScope *)scopeByCapturingVariablesNamed:(NSSet *)names
+{
+	NSParameterAssert(names);
+	
+	STScope *boundary = self;
+	while (!IsScopeLongLived(boundary))
+		boundary = boundary.parentScope;
+	
+	if(boundary == self)
+		return self;
+	
+	STScope *captureScope = [[STScope alloc] initWithParentScope:boundary];
+	for (NSString *name in names)
+	{
+		STScopeNode *capturedNode = nil;
+		for (STScope *scope = self; scope != boundary; scope = scope.parentScope)
+		{
+			capturedNode = [scope firstNodeWithKey:name];
+			if(capturedNode)
+				break;
+		}
+		
+		if(!capturedNode)
+		{
+			//Names resolvable from the boundary are looked up through the capture scope's parent.
+			if([boundary valueForVariableNamed:name searchParentScopes:YES] || NSClassFromString(name))
+				continue;
+			
+			//The variable may be bound after the closure is created, so a
+			//valueless node is reserved for it in the receiver.
+			@synchronized(self)
+			{
+				capturedNode = [self firstNodeWithKey:name];
+				if(!capturedNode)
+				{
+					capturedNode = [[STScopeNode alloc] initWithKey:name readonly:NO];
+					[self appendNode:capturedNode];
+				}
+			}
+		}
+		
+		STScopeNode *aliasNode = [[STScopeNode alloc] initWithKey:name box:capturedNode.box readonly:capturedNode.readonly];
+		[captureScope appendNode:aliasNode];
+	}
+	
+	return captureScope;
+}
+
 #pragma mark - Identity
 
 - (NSString *)description
@@ -217,16 +359,25 @@ static void EnumerateScopeNodeChain(STScopeNode *me, void(^callback)(STScopeNode
 
 - (STScopeNode *)firstNodeWithKey:(NSString *)name
 {
-	__block STScopeNode *firstMatchingNode = nil;
-	EnumerateScopeNodeChain(mHead, ^(STScopeNode *node, NSString *key, id value, BOOL *stop) {
-		if([key isEqualToString:name])
-		{
-			firstMatchingNode = node;
-			*stop = YES;
-		}
-	});
+	//Unlike EnumerateScopeNodeChain, this includes reserved nodes without values.
+	for (STScopeNode *node = mHead; node != nil; node = node.next)
+	{
+		if([node.key isEqualToString:name])
+			return node;
+	}
 	
-	return firstMatchingNode;
+	return nil;
+}
+
+- (void)appendNode:(STScopeNode *)newNode
+{
+	newNode.previous = mLast;
+	if(mLast)
+		mLast.next = newNode;
+	
+	mLast = newNode;
+	if(!mHead)
+		mHead = newNode;
 }
 
 #pragma mark -
@@ -263,7 +414,7 @@ static void EnumerateScopeNodeChain(STScopeNode *me, void(^callback)(STScopeNode
 			STScope *parentScope = self.parentScope;
 			do {
 				matchingNode = [parentScope firstNodeWithKey:name];
-				if(matchingNode && !matchingNode.readonly)
+				if(matchingNode && !matchingNode.readonly && matchingNode.value)
 				{
 					matchingNode.value = value;
 					return;
@@ -275,13 +426,7 @@ static void EnumerateScopeNodeChain(STScopeNode *me, void(^callback)(STScopeNode
 		
         STScopeNode *newNode = [[STScopeNode alloc] initWithKey:name readonly:NO];
 		newNode.value = value;
-        newNode.previous = mLast;
-		if(mLast)
-			mLast.next = newNode;
-		
-		mLast = newNode;
-		if(!mHead)
-			mHead = newNode;
+		[self appendNode:newNode];
 	}
 	
 	[self didChangeValueForKey:name];
@@ -304,13 +449,7 @@ static void EnumerateScopeNodeChain(STScopeNode *me, void(^callback)(STScopeNode
 	{
 		STScopeNode *newNode = [[STScopeNode alloc] initWithKey:name readonly:NO];
 		newNode.value = value;
-        newNode.previous = mLast;
-		if(mLast)
-			mLast.next = newNode;
-		
-		mLast = newNode;
-		if(!mHead)
-			mHead = newNode;
+		[self appendNode:newNode];
 	}
 	
 	[self didChangeValueForKey:name];
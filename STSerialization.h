@@ -0,0 +1,61 @@
+//
+//  STSerialization.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#ifndef STSerialization_h
+#define STSerialization_h 1
+
+#import <Foundation/Foundation.h>
+
+///Stein values are serialized into a compact tagged binary format.
+///
+///Every value is written as a one byte tag followed by its contents. Integers and lengths are written
+///as variable length integers, and short strings, symbol names, and decimal numbers are only written once,
+///with later occurrences referring back to them. Only the first few thousand such strings are remembered,
+///so serializing a long sequence does not hold every string it contains in memory.
+///
+///Numbers, strings, symbols, lists, arrays, vectors, dictionaries, sets, and numeric pointer arrays are
+///supported. Strings with interpolated code, and the creation locations of lists and symbols, are also
+///written, so parsed expressions can be serialized and still report where their errors occur. Enumerable
+///collections of unknown length, such as lazy sequences, are written one element at a time and deserialized
+///as arrays.
+///
+///Doubles and the contents of pointer arrays are written in the byte order of the host, so serialized
+///values are intended for caches and for transfer between processes on the same machine.
+
+///Returns the serialized form of a specified value.
+///
+///This function raises an exception if the value contains an object that cannot be serialized.
+ST_EXTERN NSData *STSerializeObject(id object);
+
+///Serialize a specified value into the file at a specified path, replacing its contents.
+///
+/// \param	object	The value to serialize. May be nil.
+/// \param	path	The path of the file to write. Required.
+/// \param	error	On return, if the file could not be written, contains an error in NSPOSIXErrorDomain describing why.
+///
+/// \result	YES if the value was serialized; NO otherwise.
+///
+///The value is written to the file as it is serialized, and is never held in memory as a whole.
+ST_EXTERN BOOL STSerializeObjectToFileAtPath(id object, NSString *path, NSError **error);
+
+///Returns the value serialized in a specified data object.
+///
+///This function raises an exception if the data is not a serialized value.
+ST_EXTERN id STDeserializeData(NSData *data);
+
+///Returns the value serialized in the file at a specified path.
+///
+/// \param	path	The path of the file to read. Required.
+/// \param	error	On return, if the file could not be read, contains an error in NSPOSIXErrorDomain describing why.
+///
+/// \result	The value serialized in the file, or nil if the file could not be read.
+///
+///The file is read a block at a time as the value is deserialized.
+ST_EXTERN id STDeserializeFileAtPath(NSString *path, NSError **error);
+
+#endif /* STSerialization_h */
@@ -0,0 +1,979 @@
+//
+//  STSerialization.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STSerialization.h"
+#import "STSymbol.h"
+#import "STList.h"
+#import "STVector.h"
+#import "STHashMap.h"
+#import "STPointer.h"
+#import "STStringWithCode.h"
+#import "STTypeBridge.h"
+#import "NSObject+SteinTools.h"
+#import <fcntl.h>
+#import <unistd.h>
+
+///The number of bytes buffered before they are written to a file, and read from a file at a time.
+#define BLOCK_SIZE	(64 * 1024)
+
+///The deepest that collections may be nested in a serialized value.
+#define MAXIMUM_DEPTH	512
+
+///The most strings that are remembered to be referred back to. Later strings are written in full each time.
+#define MAXIMUM_SHARED_STRING_COUNT	4096
+
+///The longest string, in UTF-8 bytes, that is remembered to be referred back to.
+#define MAXIMUM_SHARED_STRING_LENGTH	256
+
+///The bytes every serialized value begins with. The last byte is the version of the format.
+static const Byte kSerializationHeader[4] = { 'S', 'T', 'B', 2 };
+
+///The scalar types whose pointer arrays can be serialized.
+static const char *const kSerializablePointerTypes = "cCsSiIlLqQfdB";
+
+///The tags that precede each serialized value.
+typedef enum STSerializationTag {
+	///The end of a sequence. Has no contents.
+	kSTSerializationTagEnd = 0,
+	
+	///NSNull or nil. Has no contents.
+	kSTSerializationTagNull,
+	
+	///True. Has no contents.
+	kSTSerializationTagTrue,
+	
+	///False, which is also Stein's null. Has no contents.
+	kSTSerializationTagFalse,
+	
+	///A signed integer, written as a zig-zag encoded variable length integer.
+	kSTSerializationTagInteger,
+	
+	///An unsigned integer too large to be written as a signed integer, written as a variable length integer.
+	kSTSerializationTagUnsignedInteger,
+	
+	///A double, written as eight bytes.
+	kSTSerializationTagDouble,
+	
+	///A decimal number, written as a reference to its string value.
+	kSTSerializationTagDecimalNumber,
+	
+	///A string, written as a string reference.
+	kSTSerializationTagString,
+	
+	///A symbol, written as a reference to its name.
+	kSTSerializationTagSymbol,
+	
+	///A quoted symbol, written as a reference to its name.
+	kSTSerializationTagQuotedSymbol,
+	
+	///A list, written as its flags, its count, and each of its values.
+	kSTSerializationTagList,
+	
+	///An array, written as its count and each of its values.
+	kSTSerializationTagArray,
+	
+	///A vector, written like an array.
+	kSTSerializationTagVector,
+	
+	///A dictionary, written as its count and each of its keys followed by its value.
+	kSTSerializationTagDictionary,
+	
+	///A hash map, written like a dictionary.
+	kSTSerializationTagHashMap,
+	
+	///A set, written like an array.
+	kSTSerializationTagSet,
+	
+	///A hash set, written like an array.
+	kSTSerializationTagHashSet,
+	
+	///A pointer array, written as a reference to its type, its count, and its bytes.
+	kSTSerializationTagPointerArray,
+	
+	///A collection of unknown length, written as each of its values followed by an end tag.
+	kSTSerializationTagSequence,
+	
+	///A string with code, written as a reference to its source, the count of its expressions,
+	///and its literal segments as string references interleaved with its expressions.
+	kSTSerializationTagStringWithCode,
+	
+	///A creation location, written as a reference to its file, its line, and its column,
+	///followed by the list or symbol it belongs to.
+	kSTSerializationTagCreationLocation,
+} STSerializationTag;
+
+#pragma mark Encoding
+
+///The STSerializationEncoder class accumulates the bytes of a value as it is serialized.
+@interface STSerializationEncoder : NSObject
+{
+@public
+	//The file bytes are written to as the buffer fills, or -1 to accumulate every byte in the buffer.
+	int mFileDescriptor;
+	int mWriteError;
+	
+	Byte *mBuffer;
+	NSUInteger mLength;
+	NSUInteger mCapacity;
+	
+	//The index of each short string that has been written, up to MAXIMUM_SHARED_STRING_COUNT.
+	NSMutableDictionary *mStringIndexes;
+}
+
+///Initialize the receiver to write to a specified file descriptor, or to memory if the descriptor is -1.
+- (id)initWithFileDescriptor:(int)fileDescriptor;
+
+@end
+
+@implementation STSerializationEncoder
+
+- (void)dealloc
+{
+	free(mBuffer);
+}
+
+- (id)initWithFileDescriptor:(int)fileDescriptor
+{
+	if((self = [super init]))
+	{
+		mFileDescriptor = fileDescriptor;
+		
+		mCapacity = BLOCK_SIZE;
+		mBuffer = malloc(mCapacity);
+		NSAssert(mBuffer != NULL, @"Could not allocate serialization buffer.");
+		
+		mStringIndexes = [NSMutableDictionary dictionary];
+	}
+	
+	return self;
+}
+
+@end
+
+///Write a specified number of bytes to an encoder's file. Once a write fails, later bytes are discarded.
+static void WriteBytesToFile(STSerializationEncoder *encoder, const Byte *bytes, NSUInteger length)
+{
+	while (length > 0 && encoder->mWriteError == 0)
+	{
+		ssize_t writtenLength = write(encoder->mFileDescriptor, bytes, length);
+		if(writtenLength == -1)
+		{
+			if(errno != EINTR)
+				encoder->mWriteError = errno;
+			
+			continue;
+		}
+		
+		bytes += writtenLength;
+		length -= writtenLength;
+	}
+}
+
+///Write out the buffered bytes of an encoder that writes to a file.
+static void FlushEncoder(STSerializationEncoder *encoder)
+{
+	if(encoder->mFileDescriptor == -1)
+		return;
+	
+	WriteBytesToFile(encoder, encoder->mBuffer, encoder->mLength);
+	encoder->mLength = 0;
+}
+
+///Make room in an encoder's buffer for a specified number of bytes.
+static void EnsureEncoderCapacity(STSerializationEncoder *encoder, NSUInteger length)
+{
+	if(encoder->mLength + length <= encoder->mCapacity)
+		return;
+	
+	FlushEncoder(encoder);
+	if(encoder->mLength + length <= encoder->mCapacity)
+		return;
+	
+	NSUInteger capacity = MAX(encoder->mCapacity * 2, encoder->mLength + length);
+	Byte *buffer = realloc(encoder->mBuffer, capacity);
+	if(!buffer)
+		[NSException raise:NSMallocException format:@"Could not allocate %lu bytes to serialize value.", (unsigned long)capacity];
+	
+	encoder->mBuffer = buffer;
+	encoder->mCapacity = capacity;
+}
+
+ST_INLINE void WriteByte(STSerializationEncoder *encoder, Byte byte)
+{
+	EnsureEncoderCapacity(encoder, 1);
+	encoder->mBuffer[encoder->mLength++] = byte;
+}
+
+static void WriteBytes(STSerializationEncoder *encoder, const void *bytes, NSUInteger length)
+{
+	//Runs of bytes larger than a block are written to files directly.
+	if(encoder->mFileDescriptor != -1 && length > BLOCK_SIZE)
+	{
+		FlushEncoder(encoder);
+		WriteBytesToFile(encoder, bytes, length);
+		return;
+	}
+	
+	EnsureEncoderCapacity(encoder, length);
+	memcpy(encoder->mBuffer + encoder->mLength, bytes, length);
+	encoder->mLength += length;
+}
+
+static void WriteVarint(STSerializationEncoder *encoder, uint64_t value)
+{
+	EnsureEncoderCapacity(encoder, 10);
+	while (value >= 0x80)
+	{
+		encoder->mBuffer[encoder->mLength++] = (Byte)(value | 0x80);
+		value >>= 7;
+	}
+	encoder->mBuffer[encoder->mLength++] = (Byte)value;
+}
+
+///Returns whether a string of a specified length in UTF-8 bytes is remembered to be referred back to,
+///given the number of strings that are already remembered. Encoders and decoders must agree on this.
+ST_INLINE BOOL IsStringShared(NSUInteger length, NSUInteger sharedStringCount)
+{
+	return (length <= MAXIMUM_SHARED_STRING_LENGTH && sharedStringCount < MAXIMUM_SHARED_STRING_COUNT);
+}
+
+///Write a reference to a specified string, writing the string itself the first time it is referenced.
+///
+///Only short strings are remembered, and only up to a fixed number of them, so that serializing a long
+///sequence does not keep every string it has written alive. Other strings are written in full each time.
+static void WriteStringReference(STSerializationEncoder *encoder, NSString *string)
+{
+	NSNumber *index = [encoder->mStringIndexes objectForKey:string];
+	if(index)
+	{
+		WriteVarint(encoder, [index unsignedLongLongValue] + 1);
+		return;
+	}
+	
+	WriteVarint(encoder, 0);
+	
+	//Strings that are stored as ASCII are already valid UTF-8.
+	const char *ASCIIString = CFStringGetCStringPtr((__bridge CFStringRef)string, kCFStringEncodingASCII);
+	NSUInteger length = ASCIIString? [string length] : [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+	NSData *lossyData = nil;
+	if(!ASCIIString && length == 0 && [string length] > 0)
+	{
+		//Strings with unpaired surrogates cannot be converted exactly.
+		lossyData = [string dataUsingEncoding:NSUTF8StringEncoding allowLossyConversion:YES];
+		length = [lossyData length];
+	}
+	
+	NSUInteger sharedStringCount = [encoder->mStringIndexes count];
+	if(IsStringShared(length, sharedStringCount))
+		[encoder->mStringIndexes setObject:[NSNumber numberWithUnsignedInteger:sharedStringCount] forKey:string];
+	
+	WriteVarint(encoder, length);
+	
+	if(ASCIIString)
+	{
+		WriteBytes(encoder, ASCIIString, length);
+		return;
+	}
+	else if(lossyData)
+	{
+		WriteBytes(encoder, [lossyData bytes], length);
+		return;
+	}
+	
+	EnsureEncoderCapacity(encoder, length);
+	
+	NSUInteger usedLength = 0;
+	[string getBytes:encoder->mBuffer + encoder->mLength
+		   maxLength:length
+		  usedLength:&usedLength
+			encoding:NSUTF8StringEncoding
+			 options:0
+			   range:NSMakeRange(0, [string length])
+	  remainingRange:NULL];
+	encoder->mLength += usedLength;
+}
+
+static void WriteValue(STSerializationEncoder *encoder, id object);
+
+///Write the count and values of a collection with a known count.
+static void WriteCollection(STSerializationEncoder *encoder, STSerializationTag tag, id <NSFastEnumeration> collection, NSUInteger count)
+{
+	WriteByte(encoder, tag);
+	WriteVarint(encoder, count);
+	
+	NSUInteger writtenCount = 0;
+	for (id object in collection)
+	{
+		WriteValue(encoder, object);
+		writtenCount++;
+	}
+	
+	NSCAssert((writtenCount == count), @"Collection yielded %lu objects, expected %lu.", (unsigned long)writtenCount, (unsigned long)count);
+}
+
+static void WriteDictionary(STSerializationEncoder *encoder, STSerializationTag tag, NSDictionary *dictionary)
+{
+	WriteByte(encoder, tag);
+	WriteVarint(encoder, [dictionary count]);
+	
+	[dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+		WriteValue(encoder, key);
+		WriteValue(encoder, value);
+	}];
+}
+
+static void WriteNumber(STSerializationEncoder *encoder, NSNumber *number)
+{
+	if(number == STTrue)
+	{
+		WriteByte(encoder, kSTSerializationTagTrue);
+		return;
+	}
+	else if(number == STFalse)
+	{
+		WriteByte(encoder, kSTSerializationTagFalse);
+		return;
+	}
+	
+	if([number isKindOfClass:[NSDecimalNumber class]])
+	{
+		WriteByte(encoder, kSTSerializationTagDecimalNumber);
+		WriteStringReference(encoder, [number stringValue]);
+		return;
+	}
+	
+	char type = *[number objCType];
+	if(type == 'f' || type == 'd')
+	{
+		double value = [number doubleValue];
+		WriteByte(encoder, kSTSerializationTagDouble);
+		WriteBytes(encoder, &value, sizeof(value));
+	}
+	else if((type == 'Q' || type == 'L') && [number unsignedLongLongValue] > INT64_MAX)
+	{
+		WriteByte(encoder, kSTSerializationTagUnsignedInteger);
+		WriteVarint(encoder, [number unsignedLongLongValue]);
+	}
+	else
+	{
+		int64_t value = [number longLongValue];
+		WriteByte(encoder, kSTSerializationTagInteger);
+		WriteVarint(encoder, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+	}
+}
+
+static void WritePointer(STSerializationEncoder *encoder, STPointer *pointer)
+{
+	const char *type = pointer.type;
+	if(!pointer.isArray || strlen(type) != 1 || !strchr(kSerializablePointerTypes, type[0]))
+		[NSException raise:NSInvalidArgumentException format:@"%@ cannot be serialized. Only arrays of numbers can be serialized.", [pointer prettyDescription]];
+	
+	NSUInteger count = pointer.count;
+	WriteByte(encoder, kSTSerializationTagPointerArray);
+	WriteStringReference(encoder, [NSString stringWithUTF8String:type]);
+	WriteVarint(encoder, count);
+	WriteBytes(encoder, pointer.bytes, count * STTypeBridgeGetSizeOfObjCType(type));
+}
+
+///Write the creation location of a list or symbol, if it has one.
+static void WriteCreationLocation(STSerializationEncoder *encoder, STCreationLocation *location)
+{
+	if(!location)
+		return;
+	
+	WriteByte(encoder, kSTSerializationTagCreationLocation);
+	WriteStringReference(encoder, location.file ?: @"");
+	WriteVarint(encoder, location.line);
+	WriteVarint(encoder, location.column);
+}
+
+static void WriteStringWithCode(STSerializationEncoder *encoder, STStringWithCode *stringWithCode)
+{
+	NSArray *segments = stringWithCode.segments;
+	NSArray *expressions = stringWithCode.expressions;
+	
+	WriteByte(encoder, kSTSerializationTagStringWithCode);
+	WriteStringReference(encoder, stringWithCode.string);
+	WriteVarint(encoder, [expressions count]);
+	
+	NSUInteger expressionCount = [expressions count];
+	for (NSUInteger index = 0; index < expressionCount; index++)
+	{
+		WriteStringReference(encoder, [segments objectAtIndex:index]);
+		WriteValue(encoder, [expressions objectAtIndex:index]);
+	}
+	WriteStringReference(encoder, [segments objectAtIndex:expressionCount]);
+}
+
+static void WriteValue(STSerializationEncoder *encoder, id object)
+{
+	if(!object || object == [NSNull null])
+	{
+		WriteByte(encoder, kSTSerializationTagNull);
+	}
+	else if([object isKindOfClass:[NSNumber class]])
+	{
+		WriteNumber(encoder, object);
+	}
+	else if([object isKindOfClass:[NSString class]])
+	{
+		WriteByte(encoder, kSTSerializationTagString);
+		WriteStringReference(encoder, object);
+	}
+	else if([object isKindOfClass:[STSymbol class]])
+	{
+		WriteCreationLocation(encoder, [(STSymbol *)object creationLocation]);
+		WriteByte(encoder, [object isQuoted]? kSTSerializationTagQuotedSymbol : kSTSerializationTagSymbol);
+		WriteStringReference(encoder, [object string]);
+	}
+	else if([object isKindOfClass:[STList class]])
+	{
+		WriteCreationLocation(encoder, [(STList *)object creationLocation]);
+		WriteByte(encoder, kSTSerializationTagList);
+		WriteVarint(encoder, [(STList *)object flags]);
+		WriteVarint(encoder, [object count]);
+		
+		for (id value in object)
+			WriteValue(encoder, value);
+	}
+	else if([object isKindOfClass:[STStringWithCode class]])
+	{
+		WriteStringWithCode(encoder, object);
+	}
+	else if([object isKindOfClass:[STPointer class]])
+	{
+		WritePointer(encoder, object);
+	}
+	else if([object isKindOfClass:[STHashMap class]])
+	{
+		WriteDictionary(encoder, kSTSerializationTagHashMap, object);
+	}
+	else if([object isKindOfClass:[NSDictionary class]])
+	{
+		WriteDictionary(encoder, kSTSerializationTagDictionary, object);
+	}
+	else if([object isKindOfClass:[STHashSet class]])
+	{
+		WriteCollection(encoder, kSTSerializationTagHashSet, object, [object count]);
+	}
+	else if([object isKindOfClass:[NSSet class]])
+	{
+		WriteCollection(encoder, kSTSerializationTagSet, object, [object count]);
+	}
+	else if([object isKindOfClass:[STVector class]])
+	{
+		WriteCollection(encoder, kSTSerializationTagVector, object, [object count]);
+	}
+	else if([object isKindOfClass:[NSArray class]])
+	{
+		WriteCollection(encoder, kSTSerializationTagArray, object, [object count]);
+	}
+	else if([object conformsToProtocol:@protocol(NSFastEnumeration)])
+	{
+		WriteByte(encoder, kSTSerializationTagSequence);
+		for (id value in object)
+			WriteValue(encoder, value);
+		
+		WriteByte(encoder, kSTSerializationTagEnd);
+	}
+	else
+	{
+		[NSException raise:NSInvalidArgumentException format:@"%@ cannot be serialized.", [object prettyDescription]];
+	}
+}
+
+///Write the header and contents of a specified value.
+static void WriteSerializedValue(STSerializationEncoder *encoder, id object)
+{
+	WriteBytes(encoder, kSerializationHeader, sizeof(kSerializationHeader));
+	WriteValue(encoder, object);
+}
+
+NSData *STSerializeObject(id object)
+{
+	STSerializationEncoder *encoder = [[STSerializationEncoder alloc] initWithFileDescriptor:-1];
+	WriteSerializedValue(encoder, object);
+	
+	//The data takes ownership of the encoder's buffer.
+	NSData *data = [NSData dataWithBytesNoCopy:encoder->mBuffer length:encoder->mLength freeWhenDone:YES];
+	encoder->mBuffer = NULL;
+	
+	return data;
+}
+
+BOOL STSerializeObjectToFileAtPath(id object, NSString *path, NSError **error)
+{
+	NSCParameterAssert(path);
+	
+	int fileDescriptor = open([path fileSystemRepresentation], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(fileDescriptor == -1)
+	{
+		if(error)
+			*error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+		return NO;
+	}
+	
+	STSerializationEncoder *encoder = [[STSerializationEncoder alloc] initWithFileDescriptor:fileDescriptor];
+	@try
+	{
+		WriteSerializedValue(encoder, object);
+		FlushEncoder(encoder);
+	}
+	@finally
+	{
+		close(fileDescriptor);
+	}
+	
+	if(encoder->mWriteError != 0)
+	{
+		if(error)
+			*error = [NSError errorWithDomain:NSPOSIXErrorDomain code:encoder->mWriteError userInfo:nil];
+		return NO;
+	}
+	
+	return YES;
+}
+
+#pragma mark - Decoding
+
+///The STSerializationDecoder class tracks the position of a value as it is deserialized.
+@interface STSerializationDecoder : NSObject
+{
+@public
+	//The data being read when deserializing from memory.
+	NSData *mData;
+	
+	//The file being read, or -1 when deserializing from memory.
+	int mFileDescriptor;
+	Byte *mBlock;
+	unsigned long long mBlockPosition;
+	
+	//The bytes currently being read, either the contents of the data or the current block of the file.
+	const Byte *mBytes;
+	NSUInteger mLength;
+	NSUInteger mOffset;
+	
+	//Room for strings that span blocks of the file.
+	char *mScratch;
+	NSUInteger mScratchCapacity;
+	
+	//Every shared string read so far, in the order it was first written.
+	NSMutableArray *mStrings;
+}
+
+///Initialize the receiver to read from a specified data object.
+- (id)initWithData:(NSData *)data;
+
+///Initialize the receiver to read from a specified file descriptor, which the receiver does not close.
+- (id)initWithFileDescriptor:(int)fileDescriptor;
+
+@end
+
+@implementation STSerializationDecoder
+
+- (void)dealloc
+{
+	free(mBlock);
+	free(mScratch);
+}
+
+- (id)initWithData:(NSData *)data
+{
+	NSParameterAssert(data);
+	
+	if((self = [super init]))
+	{
+		mData = data;
+		mFileDescriptor = -1;
+		
+		mBytes = [data bytes];
+		mLength = [data length];
+		
+		mStrings = [NSMutableArray array];
+	}
+	
+	return self;
+}
+
+- (id)initWithFileDescriptor:(int)fileDescriptor
+{
+	if((self = [super init]))
+	{
+		mFileDescriptor = fileDescriptor;
+		
+		mBlock = malloc(BLOCK_SIZE);
+		NSAssert(mBlock != NULL, @"Could not allocate serialization buffer.");
+		mBytes = mBlock;
+		
+		mStrings = [NSMutableArray array];
+	}
+	
+	return self;
+}
+
+@end
+
+static void RaiseMalformedValue(STSerializationDecoder *decoder, NSString *problem) __attribute__((noreturn));
+static void RaiseMalformedValue(STSerializationDecoder *decoder, NSString *problem)
+{
+	unsigned long long position = decoder->mBlockPosition + decoder->mOffset;
+	@throw [NSException exceptionWithName:NSInvalidArgumentException
+								   reason:[NSString stringWithFormat:@"Malformed serialized value at byte %llu, %@.", position, problem]
+								 userInfo:nil];
+}
+
+///Read the next block of a decoder's file, raising if the end of the file has been reached.
+static void ReadNextBlock(STSerializationDecoder *decoder)
+{
+	if(decoder->mFileDescriptor == -1)
+		RaiseMalformedValue(decoder, @"unexpected end of data");
+	
+	ssize_t readLength;
+	do {
+		readLength = read(decoder->mFileDescriptor, decoder->mBlock, BLOCK_SIZE);
+	} while (readLength == -1 && errno == EINTR);
+	
+	if(readLength == -1)
+		[NSException raise:NSGenericException format:@"Could not read serialized value. Got error «%s».", strerror(errno)];
+	
+	decoder->mBlockPosition += decoder->mLength;
+	decoder->mLength = readLength;
+	decoder->mOffset = 0;
+	
+	if(readLength == 0)
+		RaiseMalformedValue(decoder, @"unexpected end of file");
+}
+
+ST_INLINE Byte ReadByte(STSerializationDecoder *decoder)
+{
+	if(decoder->mOffset == decoder->mLength)
+		ReadNextBlock(decoder);
+	
+	return decoder->mBytes[decoder->mOffset++];
+}
+
+static void ReadBytes(STSerializationDecoder *decoder, void *buffer, NSUInteger length)
+{
+	Byte *destination = buffer;
+	while (length > 0)
+	{
+		if(decoder->mOffset == decoder->mLength)
+			ReadNextBlock(decoder);
+		
+		NSUInteger availableLength = MIN(length, decoder->mLength - decoder->mOffset);
+		memcpy(destination, decoder->mBytes + decoder->mOffset, availableLength);
+		
+		decoder->mOffset += availableLength;
+		destination += availableLength;
+		length -= availableLength;
+	}
+}
+
+static uint64_t ReadVarint(STSerializationDecoder *decoder)
+{
+	uint64_t value = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7)
+	{
+		Byte byte = ReadByte(decoder);
+		value |= (uint64_t)(byte & 0x7F) << shift;
+		if(!(byte & 0x80))
+			return value;
+	}
+	
+	RaiseMalformedValue(decoder, @"variable length integer is too long");
+}
+
+///Read a count, raising if it is larger than a specified maximum.
+static NSUInteger ReadCount(STSerializationDecoder *decoder, uint64_t maximumCount)
+{
+	uint64_t count = ReadVarint(decoder);
+	if(count > maximumCount)
+		RaiseMalformedValue(decoder, [NSString stringWithFormat:@"count %llu is too large", count]);
+	
+	return (NSUInteger)count;
+}
+
+static NSString *ReadStringReference(STSerializationDecoder *decoder)
+{
+	uint64_t reference = ReadVarint(decoder);
+	if(reference > 0)
+	{
+		if(reference > [decoder->mStrings count])
+			RaiseMalformedValue(decoder, [NSString stringWithFormat:@"string reference %llu is undefined", reference]);
+		
+		return [decoder->mStrings objectAtIndex:(NSUInteger)(reference - 1)];
+	}
+	
+	NSUInteger length = ReadCount(decoder, NSUIntegerMax);
+	NSString *string = nil;
+	if(decoder->mLength - decoder->mOffset >= length)
+	{
+		//Strings within the current block are created straight from it.
+		string = [[NSString alloc] initWithBytes:decoder->mBytes + decoder->mOffset length:length encoding:NSUTF8StringEncoding];
+		decoder->mOffset += length;
+	}
+	else
+	{
+		if(decoder->mFileDescriptor == -1)
+			RaiseMalformedValue(decoder, @"string is longer than the data");
+		
+		if(length > decoder->mScratchCapacity)
+		{
+			char *scratch = realloc(decoder->mScratch, length);
+			if(!scratch)
+				[NSException raise:NSMallocException format:@"Could not allocate %lu bytes to deserialize value.", (unsigned long)length];
+			
+			decoder->mScratch = scratch;
+			decoder->mScratchCapacity = length;
+		}
+		
+		ReadBytes(decoder, decoder->mScratch, length);
+		string = [[NSString alloc] initWithBytes:decoder->mScratch length:length encoding:NSUTF8StringEncoding];
+	}
+	
+	if(!string)
+		RaiseMalformedValue(decoder, @"string is not valid UTF-8");
+	
+	if(IsStringShared(length, [decoder->mStrings count]))
+		[decoder->mStrings addObject:string];
+	
+	return string;
+}
+
+static id ReadValueWithTag(STSerializationDecoder *decoder, Byte tag, NSUInteger depth);
+
+ST_INLINE id ReadValue(STSerializationDecoder *decoder, NSUInteger depth)
+{
+	return ReadValueWithTag(decoder, ReadByte(decoder), depth);
+}
+
+///Read the values of a collection with a specified count into an array.
+static NSMutableArray *ReadValues(STSerializationDecoder *decoder, NSUInteger count, NSUInteger depth)
+{
+	//Counts are not trusted for preallocation, as a malformed count could be arbitrarily large.
+	NSMutableArray *values = [NSMutableArray arrayWithCapacity:MIN(count, BLOCK_SIZE)];
+	for (NSUInteger index = 0; index < count; index++)
+		[values addObject:ReadValue(decoder, depth + 1)];
+	
+	return values;
+}
+
+static NSMutableDictionary *ReadDictionary(STSerializationDecoder *decoder, NSUInteger depth)
+{
+	NSUInteger count = ReadCount(decoder, NSUIntegerMax);
+	NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:MIN(count, BLOCK_SIZE)];
+	for (NSUInteger index = 0; index < count; index++)
+	{
+		id key = ReadValue(decoder, depth + 1);
+		id value = ReadValue(decoder, depth + 1);
+		[dictionary setObject:value forKey:key];
+	}
+	
+	return dictionary;
+}
+
+static STPointer *ReadPointerArray(STSerializationDecoder *decoder)
+{
+	NSString *typeString = ReadStringReference(decoder);
+	const char *type = [typeString UTF8String];
+	if(strlen(type) != 1 || !strchr(kSerializablePointerTypes, type[0]))
+		RaiseMalformedValue(decoder, [NSString stringWithFormat:@"pointer type %@ cannot be deserialized", typeString]);
+	
+	size_t sizeOfType = STTypeBridgeGetSizeOfObjCType(type);
+	NSUInteger count = ReadCount(decoder, NSUIntegerMax / sizeOfType);
+	if(count == 0)
+		RaiseMalformedValue(decoder, @"pointer array is empty");
+	
+	//In memory, the bytes must be present before the pointer is allocated.
+	if(decoder->mFileDescriptor == -1 && decoder->mLength - decoder->mOffset < count * sizeOfType)
+		RaiseMalformedValue(decoder, @"pointer array is longer than the data");
+	
+	STPointer *pointer = [STPointer arrayPointerOfLength:count type:STTypeBridgeInternType(type)];
+	ReadBytes(decoder, pointer.bytes, count * sizeOfType);
+	
+	return pointer;
+}
+
+static STStringWithCode *ReadStringWithCode(STSerializationDecoder *decoder, NSUInteger depth)
+{
+	NSString *string = ReadStringReference(decoder);
+	NSUInteger expressionCount = ReadCount(decoder, NSUIntegerMax - 1);
+	
+	NSMutableArray *segments = [NSMutableArray arrayWithCapacity:MIN(expressionCount + 1, BLOCK_SIZE)];
+	NSMutableArray *expressions = [NSMutableArray arrayWithCapacity:MIN(expressionCount, BLOCK_SIZE)];
+	for (NSUInteger index = 0; index < expressionCount; index++)
+	{
+		[segments addObject:ReadStringReference(decoder)];
+		[expressions addObject:ReadValue(decoder, depth + 1)];
+	}
+	[segments addObject:ReadStringReference(decoder)];
+	
+	return [[STStringWithCode alloc] initWithString:string segments:segments expressions:expressions];
+}
+
+///Read a creation location and the list or symbol it belongs to.
+static id ReadValueWithCreationLocation(STSerializationDecoder *decoder, NSUInteger depth)
+{
+	STCreationLocation *location = [[STCreationLocation alloc] initWithFile:ReadStringReference(decoder)];
+	location.line = (NSUInteger)ReadVarint(decoder);
+	location.column = (NSUInteger)ReadVarint(decoder);
+	
+	Byte tag = ReadByte(decoder);
+	if(tag == kSTSerializationTagSymbol)
+	{
+		//Symbols with locations are not shared, like the symbols created by the parser.
+		STSymbol *symbol = [[STSymbol alloc] initWithString:ReadStringReference(decoder)];
+		symbol.creationLocation = location;
+		return symbol;
+	}
+	else if(tag == kSTSerializationTagQuotedSymbol || tag == kSTSerializationTagList)
+	{
+		id value = ReadValueWithTag(decoder, tag, depth);
+		[value setCreationLocation:location];
+		return value;
+	}
+	
+	RaiseMalformedValue(decoder, [NSString stringWithFormat:@"creation location precedes tag %d", tag]);
+}
+
+static id ReadValueWithTag(STSerializationDecoder *decoder, Byte tag, NSUInteger depth)
+{
+	if(depth > MAXIMUM_DEPTH)
+		RaiseMalformedValue(decoder, [NSString stringWithFormat:@"values are nested more than %d levels deep", MAXIMUM_DEPTH]);
+	
+	switch (tag)
+	{
+		case kSTSerializationTagNull:
+			return [NSNull null];
+		
+		case kSTSerializationTagTrue:
+			return STTrue;
+		
+		case kSTSerializationTagFalse:
+			return STFalse;
+		
+		case kSTSerializationTagInteger: {
+			uint64_t encodedValue = ReadVarint(decoder);
+			int64_t value = (int64_t)(encodedValue >> 1) ^ -(int64_t)(encodedValue & 1);
+			return [NSNumber numberWithLongLong:value];
+		}
+		
+		case kSTSerializationTagUnsignedInteger:
+			return [NSNumber numberWithUnsignedLongLong:ReadVarint(decoder)];
+		
+		case kSTSerializationTagDouble: {
+			double value;
+			ReadBytes(decoder, &value, sizeof(value));
+			return [NSNumber numberWithDouble:value];
+		}
+		
+		case kSTSerializationTagDecimalNumber:
+			return [NSDecimalNumber decimalNumberWithString:ReadStringReference(decoder)];
+		
+		case kSTSerializationTagString:
+			return ReadStringReference(decoder);
+		
+		case kSTSerializationTagSymbol:
+			return ST_SYM(ReadStringReference(decoder));
+		
+		case kSTSerializationTagQuotedSymbol: {
+			STSymbol *symbol = [[STSymbol alloc] initWithString:ReadStringReference(decoder)];
+			symbol.isQuoted = YES;
+			return symbol;
+		}
+		
+		case kSTSerializationTagList: {
+			STListFlags flags = (STListFlags)ReadVarint(decoder);
+			NSUInteger count = ReadCount(decoder, NSUIntegerMax);
+			
+			STList *list = [[STList alloc] initWithArray:ReadValues(decoder, count, depth)];
+			list.flags = flags;
+			return list;
+		}
+		
+		case kSTSerializationTagArray:
+			return ReadValues(decoder, ReadCount(decoder, NSUIntegerMax), depth);
+		
+		case kSTSerializationTagVector:
+			return [STVector vectorWithObjectsFromCollection:ReadValues(decoder, ReadCount(decoder, NSUIntegerMax), depth)];
+		
+		case kSTSerializationTagDictionary:
+			return ReadDictionary(decoder, depth);
+		
+		case kSTSerializationTagHashMap:
+			return [STHashMap mapWithDictionary:ReadDictionary(decoder, depth)];
+		
+		case kSTSerializationTagSet:
+			return [NSSet setWithArray:ReadValues(decoder, ReadCount(decoder, NSUIntegerMax), depth)];
+		
+		case kSTSerializationTagHashSet:
+			return [STHashSet hashSetWithObjectsFromCollection:ReadValues(decoder, ReadCount(decoder, NSUIntegerMax), depth)];
+		
+		case kSTSerializationTagPointerArray:
+			return ReadPointerArray(decoder);
+		
+		case kSTSerializationTagSequence: {
+			NSMutableArray *values = [NSMutableArray array];
+			for (Byte elementTag = ReadByte(decoder); elementTag != kSTSerializationTagEnd; elementTag = ReadByte(decoder))
+				[values addObject:ReadValueWithTag(decoder, elementTag, depth + 1)];
+			
+			return values;
+		}
+		
+		case kSTSerializationTagStringWithCode:
+			return ReadStringWithCode(decoder, depth);
+		
+		case kSTSerializationTagCreationLocation:
+			return ReadValueWithCreationLocation(decoder, depth);
+		
+		default:
+			RaiseMalformedValue(decoder, [NSString stringWithFormat:@"unknown tag %d", tag]);
+	}
+}
+
+///Read the header and contents of a serialized value.
+static id ReadSerializedValue(STSerializationDecoder *decoder)
+{
+	Byte header[sizeof(kSerializationHeader)];
+	ReadBytes(decoder, header, sizeof(header));
+	if(memcmp(header, kSerializationHeader, sizeof(header)) != 0)
+		RaiseMalformedValue(decoder, @"data is not a serialized value of a supported version");
+	
+	return ReadValue(decoder, 0);
+}
+
+id STDeserializeData(NSData *data)
+{
+	NSCParameterAssert(data);
+	
+	STSerializationDecoder *decoder = [[STSerializationDecoder alloc] initWithData:data];
+	return ReadSerializedValue(decoder);
+}
+
+id STDeserializeFileAtPath(NSString *path, NSError **error)
+{
+	NSCParameterAssert(path);
+	
+	int fileDescriptor = open([path fileSystemRepresentation], O_RDONLY);
+	if(fileDescriptor == -1)
+	{
+		if(error)
+			*error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+		return nil;
+	}
+	
+	@try
+	{
+		STSerializationDecoder *decoder = [[STSerializationDecoder alloc] initWithFileDescriptor:fileDescriptor];
+		return ReadSerializedValue(decoder);
+	}
+	@finally
+	{
+		close(fileDescriptor);
+	}
+}
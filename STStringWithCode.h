@@ -12,25 +12,56 @@
 
 ///The STStringWithCode class is used to represent a string that has code
 ///interpolated within its contents in the Stein programming language.
+///
+///A string with code is compiled by the parser into the literal segments of the string
+///and the expressions between them. Applying it evaluates each expression in turn and
+///appends the segments and results to a single result string.
 
 @interface STStringWithCode : NSObject
 {
+	NSMutableArray *mSegments;
 	NSMutableArray *mCodeExpressions;
-	NSMutableArray *mCodeRanges;
-	NSString *mString;
+	NSMutableString *mString;
+	
+	//The combined length of the literal segments, and the length of the most recent result.
+	//The expected length is shared by every thread that applies the string, and is updated atomically.
+	NSUInteger mLiteralLength;
+	volatile long mExpectedLength;
 }
-#pragma mark Properties
+#pragma mark Creation
+
+///Initialize the receiver with the parts of a string with code.
+///
+/// \param	string		The source of the string, with each expression in its interpolated form. May not be nil.
+/// \param	segments	The literal segments of the string. Must contain one more segment than there are expressions.
+/// \param	expressions	The expressions interpolated between the segments. May not be nil.
+///
+///This initializer is used to recreate strings with code that have been serialized.
+- (id)initWithString:(NSString *)string segments:(NSArray *)segments expressions:(NSArray *)expressions;
+
+#pragma mark - Properties
 
-///The string.
-@property (copy) NSString *string;
+///The source of the string, with each expression in its interpolated form.
+@property (readonly) NSString *string;
 
-#pragma mark - Adding Ranges
+///The expressions interpolated into the string.
+@property (readonly) NSArray *expressions;
+
+///The literal segments of the string, which surround its expressions.
+@property (readonly) NSArray *segments;
+
+#pragma mark - Building
+
+///Append a specified literal string to the receiver.
+///
+/// \param	literal	The literal string to append. May not be nil.
+- (void)addLiteral:(NSString *)literal;
 
-///Add a specified expression value to be substituted for a specified range.
+///Append a specified expression to be interpolated into the receiver.
 ///
 /// \param	expression	The expression to be substituted. May not be nil.
-/// \param	range		The range to substitute the expression into.
-- (void)addExpression:(id)expression inRange:(NSRange)range;
+/// \param	source		The source code the expression was parsed from. Used for descriptions.
+- (void)addExpression:(id)expression withSource:(NSString *)source;
 
 #pragma mark - Application
 
@@ -10,6 +10,7 @@
 
 #import "STList.h"
 #import "STInterpreter.h"
+#import <libkern/OSAtomic.h>
 
 @implementation STStringWithCode
 
@@ -19,8 +20,31 @@
 {
 	if((self = [super init]))
 	{
-		mCodeRanges = [NSMutableArray new];
+		mSegments = [NSMutableArray arrayWithObject:@""];
 		mCodeExpressions = [NSMutableArray new];
+		mString = [NSMutableString new];
+		
+		return self;
+	}
+	return nil;
+}
+
+- (id)initWithString:(NSString *)string segments:(NSArray *)segments expressions:(NSArray *)expressions
+{
+	NSParameterAssert(string);
+	NSParameterAssert(segments);
+	NSParameterAssert(expressions);
+	NSAssert(([segments count] == [expressions count] + 1), 
+			 @"Expected %lu segments for %lu expressions, got %lu.", [expressions count] + 1, [expressions count], [segments count]);
+	
+	if((self = [super init]))
+	{
+		mSegments = [segments mutableCopy];
+		mCodeExpressions = [expressions mutableCopy];
+		mString = [string mutableCopy];
+		
+		for (NSString *segment in segments)
+			mLiteralLength += [segment length];
 		
 		return self;
 	}
@@ -29,7 +53,20 @@
 
 #pragma mark - Properties
 
-@synthesize string = mString;
+- (NSString *)string
+{
+	return [mString copy];
+}
+
+- (NSArray *)expressions
+{
+	return [mCodeExpressions copy];
+}
+
+- (NSArray *)segments
+{
+	return [mSegments copy];
+}
 
 #pragma mark - Identity
 
@@ -39,7 +76,6 @@
 	{
 		STStringWithCode *otherStringWithCode = object;
 		return ([mString isEqualTo:otherStringWithCode->mString] && 
-				[mCodeRanges isEqualTo:otherStringWithCode->mCodeRanges] && 
 				[mCodeExpressions isEqualTo:otherStringWithCode->mCodeExpressions]);
 	}
 	else if([object isKindOfClass:[NSString class]])
@@ -57,38 +93,53 @@
 
 - (NSString *)prettyDescription
 {
-	return mString;
+	return [mString copy];
 }
 
-#pragma mark - Adding Ranges
+#pragma mark - Building
+
+- (void)addLiteral:(NSString *)literal
+{
+	NSParameterAssert(literal);
+	
+	NSUInteger lastIndex = [mSegments count] - 1;
+	[mSegments replaceObjectAtIndex:lastIndex withObject:[[mSegments objectAtIndex:lastIndex] stringByAppendingString:literal]];
+	[mString appendString:literal];
+	mLiteralLength += [literal length];
+}
 
-- (void)addExpression:(id)expression inRange:(NSRange)range
+- (void)addExpression:(id)expression withSource:(NSString *)source
 {
 	NSParameterAssert(expression);
+	NSParameterAssert(source);
 	
 	[mCodeExpressions addObject:expression];
-	[mCodeRanges addObject:[NSValue valueWithRange:range]];
+	[mSegments addObject:@""];
+	[mString appendFormat:@"%%(%@)", source];
 }
 
 #pragma mark - Application
 
 - (id)applyInScope:(STScope *)scope
 {
-	STScope *expressionEvaluationScope = [STScope scopeWithParentScope:scope];
+	//The result is sized to the previous result, which is exact for
+	//strings whose interpolated values do not change much in length.
+	long expectedLength = mExpectedLength;
+	NSMutableString *resultString = [NSMutableString stringWithCapacity:MAX(mLiteralLength, (NSUInteger)expectedLength)];
 	
-	NSMutableArray *evaluatedExpressionStrings = [NSMutableArray array];
-	for (id expression in mCodeExpressions)
+	NSUInteger expressionCount = [mCodeExpressions count];
+	for (NSUInteger index = 0; index < expressionCount; index++)
 	{
-		id resultOfExpression = STEvaluate(expression, expressionEvaluationScope);
-		[evaluatedExpressionStrings addObject:[resultOfExpression description]];
+		[resultString appendString:[mSegments objectAtIndex:index]];
+		
+		id resultOfExpression = STEvaluate([mCodeExpressions objectAtIndex:index], scope);
+		if(resultOfExpression)
+			[resultString appendString:[resultOfExpression description]];
 	}
+	[resultString appendString:[mSegments objectAtIndex:expressionCount]];
 	
-	NSMutableString *resultString = [NSMutableString stringWithString:mString];
-	[mCodeRanges enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(NSValue *value, NSUInteger index, BOOL *stop) {
-		NSRange range = [value rangeValue];
-		[resultString replaceCharactersInRange:range 
-									withString:[evaluatedExpressionStrings objectAtIndex:index]];
-	}];
+	//The length is only a hint, so if another thread has updated it since it was read, its update is kept.
+	OSAtomicCompareAndSwapLongBarrier(expectedLength, (long)[resultString length], &mExpectedLength);
 	
 	return resultString;
 }
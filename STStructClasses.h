@@ -8,14 +8,21 @@
 
 #import <Foundation/Foundation.h>
 #import <Stein/STTypeBridge.h>
+#import <Stein/STEnumerable.h>
 
 #ifndef STStructClasses_h
 #define STStructClasses_h 1
 
 ///The STRange class is used to describe NSRange and CFRange structs in the Stein programming language.
-@interface STRange : NSObject <STPrimitiveValueWrapper>
+///
+///Ranges may also be enumerated as integers. As it always has, enumeration counts from 0 up to the
+///end of the range, `location + length`, visiting every `step`-th integer, or counts down from the end
+///of the range to 0 if the step is negative. Integers are given to functions as shared number objects
+///where possible. `map:` yields an array, and `filter:` yields an index set.
+@interface STRange : NSObject <STPrimitiveValueWrapper, STEnumerable>
 {
 	NSRange mRange;
+	NSInteger mStep;
 }
 
 #pragma mark Initialization
@@ -26,6 +33,16 @@
 ///Initialize the receiver with a specified location, and a specified length.
 - (id)initWithLocation:(NSUInteger)location length:(NSUInteger)length;
 
+///Initialize the receiver with a specified location, length, and step.
+///
+/// \param		location	The first integer in the range.
+/// \param		length		The number of integers covered by the range.
+/// \param		step		The distance between integers visited by enumeration. Negative steps enumerate in reverse. May not be 0.
+/// \result		A fully initialized range.
+///
+///This is the designated initializer of STRange.
+- (id)initWithLocation:(NSUInteger)location length:(NSUInteger)length step:(NSInteger)step;
+
 #pragma mark - Properties
 
 ///The location of the range.
@@ -34,11 +51,30 @@
 ///The length of the range.
 @property NSUInteger length;
 
+///The distance between the integers visited when enumerating the range. Negative steps enumerate in reverse.
+@property NSInteger step;
+
 #pragma mark -
 
 ///The primitive value of the range.
 @property (readonly) NSRange rangeValue;
 
+///Returns a range covering the same integers as the receiver that is enumerated in the opposite direction.
+- (STRange *)reverse;
+
+#pragma mark - Enumeration
+
+///Invoke a block with each integer visited when enumerating the receiver, in order.
+- (void)enumerateIndexesUsingBlock:(void (^)(NSUInteger index, BOOL *stop))block;
+
+///Returns an index set containing the results of applying a function to each integer visited when enumerating the receiver.
+///
+/// \param		function	The function to apply. Must yield non-negative integers, or null to skip an integer. May not be nil.
+/// \result		An index set of the function's results.
+///
+///Unlike `map:`, the order of the results and any duplicates among them are not preserved.
+- (NSIndexSet *)indexSetByMapping:(id <STFunction>)function;
+
 @end
 
 ///The descriptor for the range struct wrapper.
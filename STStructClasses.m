@@ -10,6 +10,7 @@
 #import "STFunction.h"
 #import "STEnumerable.h"
 #import "STList.h"
+#import "NSObject+SteinTools.h"
 
 static BOOL _CStringHasPrefix(const char *string, const char *prefix)
 {
@@ -46,10 +47,18 @@ static BOOL _CStringHasPrefix(const char *string, const char *prefix)
 
 - (id)initWithLocation:(NSUInteger)location length:(NSUInteger)length
 {
+	return [self initWithLocation:location length:length step:1];
+}
+
+- (id)initWithLocation:(NSUInteger)location length:(NSUInteger)length step:(NSInteger)step
+{
+	NSParameterAssert(step != 0);
+	
 	if((self = [super init]))
 	{
 		mRange.location = location;
 		mRange.length = length;
+		mStep = step;
 		
 		return self;
 	}
@@ -94,6 +103,26 @@ static BOOL _CStringHasPrefix(const char *string, const char *prefix)
 
 #pragma mark -
 
+- (void)setStep:(NSInteger)step
+{
+	NSParameterAssert(step != 0);
+	
+	@synchronized(self)
+	{
+		mStep = step;
+	}
+}
+
+- (NSInteger)step
+{
+	@synchronized(self)
+	{
+		return mStep;
+	}
+}
+
+#pragma mark -
+
 - (NSRange)rangeValue
 {
 	@synchronized(self)
@@ -102,30 +131,287 @@ static BOOL _CStringHasPrefix(const char *string, const char *prefix)
 	}
 }
 
+- (STRange *)reverse
+{
+	NSRange range = self.rangeValue;
+	return [[STRange alloc] initWithLocation:range.location length:range.length step:-self.step];
+}
+
+#pragma mark - Enumeration
+
+///Returns the range of integers the receiver enumerates, which starts at 0 and ends where the receiver does.
+- (NSRange)enumeratedRange
+{
+	return NSMakeRange(0, NSMaxRange(self.rangeValue));
+}
+
+///The number of integers that are shared between every range enumeration.
+#define CACHED_NUMBER_COUNT	1024
+
+///Returns a number object for a specified integer, sharing objects for small integers.
+ST_INLINE NSNumber *NumberForIndex(NSUInteger index)
+{
+	static NSNumber *cachedNumbers[CACHED_NUMBER_COUNT];
+	static dispatch_once_t predicate;
+	dispatch_once(&predicate, ^{
+		for (NSUInteger cachedIndex = 0; cachedIndex < CACHED_NUMBER_COUNT; cachedIndex++)
+		{
+			cachedNumbers[cachedIndex] = [NSNumber numberWithUnsignedInteger:cachedIndex];
+		}
+	});
+	
+	if(index < CACHED_NUMBER_COUNT)
+		return cachedNumbers[index];
+	
+	return [NSNumber numberWithUnsignedInteger:index];
+}
+
+///Returns the number of integers visited when enumerating a range with a specified step.
+ST_INLINE NSUInteger CountOfStepsInRange(NSRange range, NSInteger step)
+{
+	NSUInteger stride = (step < 0)? -step : step;
+	return (range.length + stride - 1) / stride;
+}
+
+///Returns the integer visited at a specified step when enumerating a range.
+ST_INLINE NSUInteger IndexOfStepInRange(NSRange range, NSInteger step, NSUInteger stepIndex)
+{
+	if(step < 0)
+		return NSMaxRange(range) - 1 - (stepIndex * -step);
+	
+	return range.location + (stepIndex * step);
+}
+
+- (void)enumerateIndexesUsingBlock:(void (^)(NSUInteger index, BOOL *stop))block
+{
+	NSParameterAssert(block);
+	
+	NSRange range = [self enumeratedRange];
+	NSInteger step = self.step;
+	
+	BOOL stop = NO;
+	for (NSUInteger stepIndex = 0, stepCount = CountOfStepsInRange(range, step); stepIndex < stepCount; stepIndex++)
+	{
+		block(IndexOfStepInRange(range, step, stepIndex), &stop);
+		if(stop)
+			break;
+	}
+}
+
 #pragma mark - Implementing <STEnumerable>
 
 - (id)foreach:(id <STFunction>)function
 {
-	for (NSUInteger index = 0, count = mRange.location + mRange.length; index < count; index++)
-	{
-		NSNumber *number = [NSNumber numberWithUnsignedInteger:index];
+	[self enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
 		@try
 		{
-			STFunctionApply(function, [[STList alloc] initWithObject:number]);
+			STFunctionApply(function, [[STList alloc] initWithObject:NumberForIndex(index)]);
 		}
 		@catch (STBreakException *e)
 		{
-			break;
+			*stop = YES;
+			return;
 		}
 		@catch (STContinueException *e)
 		{
-			continue;
+			return;
 		}
-	}
+	}];
 	
 	return self;
 }
 
+///Returns whether or not an object is a number holding a non-negative integer.
+static BOOL IsIndex(id object)
+{
+	if(![object isKindOfClass:[NSNumber class]] || CFGetTypeID((__bridge CFTypeRef)object) == CFBooleanGetTypeID())
+		return NO;
+	
+	double value = [object doubleValue];
+	return (value >= 0.0 && value < (double)NSNotFound && value == floor(value));
+}
+
+- (id)map:(id <STFunction>)function
+{
+	NSMutableArray *results = [NSMutableArray array];
+	[self enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+		@try
+		{
+			id result = STFunctionApply(function, [[STList alloc] initWithObject:NumberForIndex(index)]);
+			if(result && result != STNull)
+				[results addObject:result];
+		}
+		@catch (STBreakException *e)
+		{
+			*stop = YES;
+			return;
+		}
+		@catch (STContinueException *e)
+		{
+			return;
+		}
+	}];
+	
+	return results;
+}
+
+- (NSIndexSet *)indexSetByMapping:(id <STFunction>)function
+{
+	NSParameterAssert(function);
+	
+	NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
+	[self enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+		@try
+		{
+			id result = STFunctionApply(function, [[STList alloc] initWithObject:NumberForIndex(index)]);
+			if(!result || result == STNull)
+				return;
+			
+			if(!IsIndex(result))
+				[NSException raise:NSInvalidArgumentException format:@"Cannot add %@ to an index set.", [result prettyDescription]];
+			
+			[indexSet addIndex:[result unsignedIntegerValue]];
+		}
+		@catch (STBreakException *e)
+		{
+			*stop = YES;
+			return;
+		}
+		@catch (STContinueException *e)
+		{
+			return;
+		}
+	}];
+	
+	return [indexSet copy];
+}
+
+- (id)filter:(id <STFunction>)function
+{
+	NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
+	[self enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+		@try
+		{
+			if(STIsTrue(STFunctionApply(function, [[STList alloc] initWithObject:NumberForIndex(index)])))
+				[indexSet addIndex:index];
+		}
+		@catch (STBreakException *e)
+		{
+			*stop = YES;
+			return;
+		}
+		@catch (STContinueException *e)
+		{
+			return;
+		}
+	}];
+	
+	return [indexSet copy];
+}
+
+#pragma mark -
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	NSParameterAssert(function);
+	NSParameterAssert(initial);
+	
+	__block id result = initial;
+	[self enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+		@try
+		{
+			result = STFunctionApply(function, [[STList alloc] initWithObjects:result, NumberForIndex(index), nil]);
+		}
+		@catch (STBreakException *e)
+		{
+			*stop = YES;
+			return;
+		}
+		@catch (STContinueException *e)
+		{
+			return;
+		}
+	}];
+	
+	return result;
+}
+
+- (id)sum
+{
+	//The integers of a range form an arithmetic sequence, so their sum is known without visiting them.
+	NSRange range = [self enumeratedRange];
+	NSInteger step = self.step;
+	NSUInteger stepCount = CountOfStepsInRange(range, step);
+	if(stepCount == 0)
+		return NumberForIndex(0);
+	
+	double first = IndexOfStepInRange(range, step, 0);
+	double last = IndexOfStepInRange(range, step, stepCount - 1);
+	return [NSNumber numberWithDouble:stepCount * (first + last) / 2.0];
+}
+
+- (id)min
+{
+	NSRange range = [self enumeratedRange];
+	NSInteger step = self.step;
+	NSUInteger stepCount = CountOfStepsInRange(range, step);
+	if(stepCount == 0)
+		return nil;
+	
+	return NumberForIndex(MIN(IndexOfStepInRange(range, step, 0), IndexOfStepInRange(range, step, stepCount - 1)));
+}
+
+- (id)max
+{
+	NSRange range = [self enumeratedRange];
+	NSInteger step = self.step;
+	NSUInteger stepCount = CountOfStepsInRange(range, step);
+	if(stepCount == 0)
+		return nil;
+	
+	return NumberForIndex(MAX(IndexOfStepInRange(range, step, 0), IndexOfStepInRange(range, step, stepCount - 1)));
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	return [[self filter:function] count];
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	NSParameterAssert(function);
+	
+	NSMutableDictionary *groups = [NSMutableDictionary dictionary];
+	[self enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+		@try
+		{
+			id key = STFunctionApply(function, [[STList alloc] initWithObject:NumberForIndex(index)]);
+			if(!key)
+				return;
+			
+			NSMutableIndexSet *group = [groups objectForKey:key];
+			if(!group)
+			{
+				group = [NSMutableIndexSet indexSet];
+				[groups setObject:group forKey:key];
+			}
+			
+			[group addIndex:index];
+		}
+		@catch (STBreakException *e)
+		{
+			*stop = YES;
+			return;
+		}
+		@catch (STContinueException *e)
+		{
+			return;
+		}
+	}];
+	
+	return groups;
+}
+
 #pragma mark - Bridging
 
 - (void)getValue:(void **)buffer forType:(const char *)objcType
@@ -145,6 +431,9 @@ static BOOL _CStringHasPrefix(const char *string, const char *prefix)
 
 - (NSString *)prettyDescription
 {
+	if(mStep != 1)
+		return [NSString stringWithFormat:@"range %ld %ld %ld", mRange.location, mRange.length, mStep];
+	
 	return [NSString stringWithFormat:@"range %ld %ld", mRange.location, mRange.length];
 }
 
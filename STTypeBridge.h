@@ -51,6 +51,11 @@ struct STPrimitiveValueWrapperDescriptor {
 /// \param	wrapper	A wrapper descriptor value. Will be copied in. May not be NULL.
 ST_EXTERN void STTypeBridgeRegisterWrapper(NSString *name, const STPrimitiveValueWrapperDescriptor *wrapper);
 
+///Returns a permanent copy of a specified Objective-C type string that is shared by every equal type string.
+///
+///Interned types may be compared by address. The type bridge resolves wrappers once per interned type.
+ST_EXTERN const char *STTypeBridgeInternType(const char *type);
+
 ///Look up a type wrapper in the Stein type bridge for a specified Objective-C type string.
 ///
 /// \param	type	The Objective-C type of the value the wrapper is to wrap itself around. May not be NULL.
@@ -71,8 +76,15 @@ ST_EXTERN size_t STTypeBridgeGetSizeOfObjCType(const char *objcType);
 /// \result		An object representing the passed in value.
 ///
 ///This function raises an assertion if the value cannot be turned into an object.
+///Pointers are converted into new STPointers holding a copy of the value they point to.
 ST_EXTERN id STTypeBridgeConvertValueOfTypeIntoObject(void *value, const char *objcType);
 
+///Convert a raw primitive value into an object, converting pointers into views of the memory they point to.
+///
+///This function behaves like `STTypeBridgeConvertValueOfTypeIntoObject`, except that pointers are not copied.
+///The caller is responsible for ensuring the memory outlives the returned STPointer.
+ST_EXTERN id STTypeBridgeConvertValueOfTypeIntoObjectBorrowingPointers(void *value, const char *objcType);
+
 ///Convert an object into a primitive value.
 ///
 /// \param	object	The object to convert into a primitive value. May not be nil.
@@ -80,6 +92,17 @@ ST_EXTERN id STTypeBridgeConvertValueOfTypeIntoObject(void *value, const char *o
 /// \param	value	A buffer large enough to hold the primitive representation of the object. May not be NULL.
 ST_EXTERN void STTypeBridgeConvertObjectIntoType(id object, const char *type, void **value);
 
+///Copy the values of a C array that a mutable array was converted into back into the mutable array.
+///
+/// \param	value		The buffer the mutable array was converted into by `STTypeBridgeConvertObjectIntoType`. May not be NULL.
+/// \param	objcType	The pointer or C array type the mutable array was converted into. May not be NULL.
+/// \param	array		The mutable array. Its count determines how many values are copied. May not be nil.
+///
+///This function is used to reflect changes made by native functions to arrays passed to them.
+///Nothing is copied for const types, or when the function did not change the values, so that
+///values which lost precision in conversion are left alone.
+ST_EXTERN void STTypeBridgeCopyConvertedValuesIntoArray(void *value, const char *objcType, NSMutableArray *array);
+
 #pragma mark -
 
 ///Look up the Objective-C type for a specified human-readable type.
@@ -81,6 +81,27 @@ static const char *GetRelevantTypeForObjCType(const char *objcType)
 	return objcType;
 }
 
+///Returns the type of the elements of a specified pointer or C array type. The result is interned.
+static const char *GetElementTypeOfArrayType(const char *type)
+{
+	if(type[0] == kObjectiveCTypePointer)
+		return type + 1;
+	
+	//C array types are of the form [<count><type>].
+	const char *elementType = type + 1;
+	while (isdigit(*elementType))
+		elementType++;
+	
+	const char *endOfElementType = NSGetSizeAndAlignment(elementType, NULL, NULL);
+	char *elementTypeCopy = strndup(elementType, endOfElementType - elementType);
+	NSCAssert((elementTypeCopy != NULL), @"Could not copy element type of %s.", type);
+	
+	const char *internedElementType = STTypeBridgeInternType(elementTypeCopy);
+	free(elementTypeCopy);
+	
+	return internedElementType;
+}
+
 #pragma mark - Size look up
 
 size_t STTypeBridgeGetSizeOfObjCType(const char *objcType)
@@ -93,7 +114,8 @@ size_t STTypeBridgeGetSizeOfObjCType(const char *objcType)
 
 #pragma mark - Converting Values to and from Objects
 
-id STTypeBridgeConvertValueOfTypeIntoObject(void *value, const char *objcType)
+///Convert a raw primitive value into an object, either copying or borrowing the memory pointers point to.
+static id ConvertValueOfTypeIntoObject(void *value, const char *objcType, BOOL borrowsPointers)
 {
 	const char *type = GetRelevantTypeForObjCType(objcType);
 	
@@ -146,10 +168,18 @@ id STTypeBridgeConvertValueOfTypeIntoObject(void *value, const char *objcType)
 			
 		case kObjectiveCTypeCArray:
 		case kObjectiveCTypePointer: {
-			//Skip the initial ^ so the pointer knows what it actually contains.
+			void *bytes = *(void **)value;
+			if(!bytes)
+				return STNull;
+			
+			//Skip the initial ^ so the pointer knows what it actually contains. Borrowed
+			//pointees are not copied, `-[STPointer arrayPointerOfCount:]` can view more of them.
 			const char *pointerType = objcType + 1;
+			if(borrowsPointers)
+				return [STPointer pointerBorrowingBytes:bytes type:pointerType owner:nil];
+			
 			STPointer *pointer = [STPointer pointerWithType:pointerType];
-			memcpy(pointer.bytes, *(void **)value, pointer.length);
+			memcpy(pointer.bytes, bytes, pointer.length);
 			
 			return pointer;
 		}
@@ -178,6 +208,16 @@ id STTypeBridgeConvertValueOfTypeIntoObject(void *value, const char *objcType)
 	return STNull;
 }
 
+id STTypeBridgeConvertValueOfTypeIntoObject(void *value, const char *objcType)
+{
+	return ConvertValueOfTypeIntoObject(value, objcType, NO);
+}
+
+id STTypeBridgeConvertValueOfTypeIntoObjectBorrowingPointers(void *value, const char *objcType)
+{
+	return ConvertValueOfTypeIntoObject(value, objcType, YES);
+}
+
 void STTypeBridgeConvertObjectIntoType(id object, const char *objcType, void **value)
 {
 	const char *type = GetRelevantTypeForObjCType(objcType);
@@ -246,10 +286,24 @@ void STTypeBridgeConvertObjectIntoType(id object, const char *objcType, void **v
 			
 		case kObjectiveCTypeCArray:
 		case kObjectiveCTypePointer:
-			if(object && object != STNull)
+			if(!object || object == STNull)
+			{
+				*(void **)value = NULL;
+			}
+			else if([object respondsToSelector:@selector(bytes)])
+			{
 				*(Byte **)value = (Byte *)([object bytes]);
-            else
+			}
+			else if([object conformsToProtocol:@protocol(NSFastEnumeration)] && [object respondsToSelector:@selector(count)] && [object count] > 0)
+			{
+				//Collections are converted in bulk into a buffer that lives until the enclosing autorelease pool drains.
+				__autoreleasing STPointer *values = [STPointer arrayPointerWithValues:object type:GetElementTypeOfArrayType(type)];
+				*(Byte **)value = (Byte *)(values.bytes);
+			}
+			else
+			{
 				*(void **)value = NULL;
+			}
             
 			break;
 			
@@ -279,13 +333,74 @@ void STTypeBridgeConvertObjectIntoType(id object, const char *objcType, void **v
 	}
 }
 
+#pragma mark - Interned Types
+
+///The lock that guards the interned type table and the wrapper cache.
+static OSSpinLock gStructWrapperLock = OS_SPINLOCK_INIT;
+
+///The permanent copies of every interned type.
+static CFMutableSetRef gInternedTypes = NULL;
+
+///The wrapper descriptors that have been resolved for interned types, keyed by the address of the interned type.
+static CFMutableDictionaryRef gWrappersByInternedType = NULL;
+
+static CFHashCode InternedTypeHashCallBack(const void *value)
+{
+	CFHashCode hash = 5381;
+	for (const char *character = value; *character != '\0'; character++)
+		hash = (hash * 33) ^ (unsigned char)(*character);
+	
+	return hash;
+}
+
+static Boolean InternedTypeEqualCallBack(const void *value1, const void *value2)
+{
+	return (strcmp(value1, value2) == 0);
+}
+
+static CFSetCallBacks const kInternedTypeSetCallbacks = {
+	.version = 0,
+	.retain = NULL,
+	.release = NULL,
+	.copyDescription = NULL,
+	.equal = InternedTypeEqualCallBack,
+	.hash = InternedTypeHashCallBack,
+};
+
+const char *STTypeBridgeInternType(const char *type)
+{
+	NSCParameterAssert(type);
+	
+	OSSpinLockLock(&gStructWrapperLock);
+	
+	if(!gInternedTypes)
+		gInternedTypes = CFSetCreateMutable(kCFAllocatorDefault, 0, &kInternedTypeSetCallbacks);
+	
+	const char *internedType = CFSetGetValue(gInternedTypes, type);
+	if(!internedType)
+	{
+		internedType = strdup(type);
+		CFSetAddValue(gInternedTypes, internedType);
+	}
+	
+	OSSpinLockUnlock(&gStructWrapperLock);
+	
+	return internedType;
+}
+
 #pragma mark - Struct Bridging
 
+///The size of the largest struct that generic struct wrappers hold without a separate allocation.
+#define GENERIC_STRUCT_INLINE_SIZE	64
+
 @interface STTypeBridgeGenericStructWrapper : NSObject < STPrimitiveValueWrapper >
 {
 	void *mValue;
 	size_t mSizeOfValue;
-	char *mObjcType;
+	const char *mObjcType;
+	
+	//Storage for structs that fit, such that wrapping them only allocates the wrapper.
+	Byte mInlineValue[GENERIC_STRUCT_INLINE_SIZE];
 }
 - (id)initWithValue:(void *)value ofType:(const char *)objcType;
 @end
@@ -321,6 +436,12 @@ static STPrimitiveValueWrapperDescriptor const kGenericStructWrapperDescriptor =
 
 #pragma mark Initialization
 
+- (void)dealloc
+{
+	if(mValue != mInlineValue)
+		free(mValue);
+}
+
 - (id)init
 {
 	[self doesNotRecognizeSelector:_cmd];
@@ -337,9 +458,10 @@ static STPrimitiveValueWrapperDescriptor const kGenericStructWrapperDescriptor =
 		mSizeOfValue = STTypeBridgeGetSizeOfObjCType(objcType);
 		NSAssert((mSizeOfValue > 0), @"Could not get size of struct with type %s, oh dear.", objcType);
 		
-		mValue = NSAllocateCollectable(mSizeOfValue, 0);
-		mObjcType = NSAllocateCollectable(strlen(objcType) + 1, 0);
-		strcpy(mObjcType, objcType);
+		mValue = (mSizeOfValue <= GENERIC_STRUCT_INLINE_SIZE)? mInlineValue : malloc(mSizeOfValue);
+		memcpy(mValue, value, mSizeOfValue);
+		
+		mObjcType = STTypeBridgeInternType(objcType);
 		
 		return self;
 	}
@@ -350,12 +472,15 @@ static STPrimitiveValueWrapperDescriptor const kGenericStructWrapperDescriptor =
 
 - (void)getValue:(void **)buffer forType:(const char *)objcType
 {
-	size_t sizeOfBuffer = STTypeBridgeGetSizeOfObjCType(objcType);
-	NSAssert((sizeOfBuffer == mSizeOfValue), 
-			 @"Buffer given to generic struct descriptor is %ld bytes, but the generic struct descriptor's buffer is %ld bytes.", sizeOfBuffer, mSizeOfValue);
+	//Values are passed straight through to the type they were wrapped from without computing its size again.
+	if(objcType != mObjcType && strcmp(objcType, mObjcType) != 0)
+	{
+		size_t sizeOfBuffer = STTypeBridgeGetSizeOfObjCType(objcType);
+		NSAssert((sizeOfBuffer == mSizeOfValue), 
+				 @"Buffer given to generic struct descriptor is %ld bytes, but the generic struct descriptor's buffer is %ld bytes.", sizeOfBuffer, mSizeOfValue);
+	}
 	
-	NSAssert(memcpy(buffer, mValue, mSizeOfValue),
-			 @"Could not copy value into buffer.");
+	memcpy(buffer, mValue, mSizeOfValue);
 }
 
 - (const STPrimitiveValueWrapperDescriptor *)descriptor
@@ -424,9 +549,16 @@ void STTypeBridgeRegisterWrapper(NSString *name, const STPrimitiveValueWrapperDe
 {
 	CFMutableDictionaryRef wrappers = STTypeBridgeGetStructWrappers();
 	CFDictionarySetValue(wrappers, (__bridge CFStringRef)name, wrapper);
+	
+	//The new wrapper may be a better match for types that have already been resolved.
+	OSSpinLockLock(&gStructWrapperLock);
+	if(gWrappersByInternedType)
+		CFDictionaryRemoveAllValues(gWrappersByInternedType);
+	OSSpinLockUnlock(&gStructWrapperLock);
 }
 
-const STPrimitiveValueWrapperDescriptor *STTypeBridgeGetWrapperForType(const char *type)
+///Searches the registered wrappers for the first that can wrap a specified type.
+static const STPrimitiveValueWrapperDescriptor *FindWrapperForType(const char *type)
 {
 	CFMutableDictionaryRef wrappers = STTypeBridgeGetStructWrappers();
 	
@@ -444,6 +576,30 @@ const STPrimitiveValueWrapperDescriptor *STTypeBridgeGetWrapperForType(const cha
 	return &kGenericStructWrapperDescriptor;
 }
 
+const STPrimitiveValueWrapperDescriptor *STTypeBridgeGetWrapperForType(const char *type)
+{
+	//Wrappers are resolved once per type, after which they are looked up by the address of the interned type.
+	const char *internedType = STTypeBridgeInternType(type);
+	
+	OSSpinLockLock(&gStructWrapperLock);
+	const STPrimitiveValueWrapperDescriptor *cachedWrapperDescriptor = gWrappersByInternedType? CFDictionaryGetValue(gWrappersByInternedType, internedType) : NULL;
+	OSSpinLockUnlock(&gStructWrapperLock);
+	
+	if(cachedWrapperDescriptor)
+		return cachedWrapperDescriptor;
+	
+	const STPrimitiveValueWrapperDescriptor *wrapperDescriptor = FindWrapperForType(internedType);
+	
+	OSSpinLockLock(&gStructWrapperLock);
+	if(!gWrappersByInternedType)
+		gWrappersByInternedType = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+	
+	CFDictionarySetValue(gWrappersByInternedType, internedType, wrapperDescriptor);
+	OSSpinLockUnlock(&gStructWrapperLock);
+	
+	return wrapperDescriptor;
+}
+
 #pragma mark - Type system conversions
 
 static const void *CStringRetainCallBack(CFAllocatorRef allocator, const void *value)
@@ -714,6 +870,32 @@ ffi_type *STTypeBridgeConvertObjCTypeToFFIType(const char *objcType)
 	return &ffi_type_void;
 }
 
+void STTypeBridgeCopyConvertedValuesIntoArray(void *value, const char *objcType, NSMutableArray *array)
+{
+	NSCParameterAssert(value);
+	NSCParameterAssert(objcType);
+	NSCParameterAssert(array);
+	
+	//Arrays passed to const parameters cannot have been changed.
+	if(objcType[0] == kObjectiveCTypeModifierConst)
+		return;
+	
+	const char *type = GetRelevantTypeForObjCType(objcType);
+	void *bytes = *(void **)value;
+	if((type[0] != kObjectiveCTypePointer && type[0] != kObjectiveCTypeCArray) || !bytes || [array count] == 0)
+		return;
+	
+	//The array is converted again to recover the bytes that were passed in. The array is only
+	//replaced if the function changed them, as converting values can lose precision.
+	const char *elementType = GetElementTypeOfArrayType(type);
+	STPointer *originalValues = [STPointer arrayPointerWithValues:array type:elementType];
+	if(memcmp(originalValues.bytes, bytes, originalValues.length) == 0)
+		return;
+	
+	STPointer *values = [STPointer arrayPointerBorrowingBytes:bytes count:[array count] type:elementType owner:nil];
+	[array setArray:[values values]];
+}
+
 #pragma mark -
 
 NSString *STTypeBridgeGetObjCTypeForHumanReadableType(NSString *type)
@@ -0,0 +1,133 @@
+//
+//  STVector.h
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <Stein/STEnumerable.h>
+
+@class STVectorNode, STVectorBuilder;
+
+///The STVector class is an immutable, indexed collection that is cheap to derive new vectors from.
+///
+///Vectors are stored as trees with 32 objects per node. Every method that derives a new
+///vector from an existing one, such as `-[STVector vectorByAddingObject:]`, shares all but
+///the nodes along the path it changes with the receiver, and so takes O(log32 n) time
+///instead of copying the receiver. Sub-vectors share the entirety of their receiver.
+///
+///Many objects can be added to a vector at once in amortized constant time each by using an
+///`STVectorBuilder`, which modifies the nodes it creates in place until its vector is requested.
+@interface STVector : NSObject < STEnumerable, NSFastEnumeration, NSCopying >
+{
+	STVectorNode *mRoot;
+	STVectorNode *mTail;
+	NSUInteger mShift;
+	NSUInteger mTreeCount;
+	
+	//The window of the tree visible to the vector.
+	NSUInteger mOffset;
+	NSUInteger mCount;
+	
+	//The hash of the vector's objects, or 0 if it has not been computed yet.
+	NSUInteger mHash;
+}
+
+#pragma mark Creation
+
+///Returns the empty vector.
++ (STVector *)vector;
+
+///Returns a vector containing the objects of a specified array, list, or other enumerable collection.
++ (STVector *)vectorWithObjectsFromCollection:(id <NSFastEnumeration>)collection;
+
+#pragma mark - Accessing Objects
+
+///The number of objects in the receiver.
+@property (readonly) NSUInteger count;
+
+///Returns the object at a specified index in the receiver. Raises an exception if the index is out of bounds.
+- (id)objectAtIndex:(NSUInteger)index;
+
+///Returns the first object in the receiver, or nil if the receiver is empty.
+@property (readonly) id firstObject;
+
+///Returns the last object in the receiver, or nil if the receiver is empty.
+@property (readonly) id lastObject;
+
+///All of the objects in the receiver in the form of an array.
+@property (readonly) NSArray *allObjects;
+
+#pragma mark - Deriving Vectors
+
+///Returns a new vector containing the receiver's objects followed by a specified object. May not be nil.
+- (STVector *)vectorByAddingObject:(id)object;
+
+///Returns a new vector containing the receiver's objects followed by the objects of a specified collection.
+- (STVector *)vectorByAddingObjectsFromCollection:(id <NSFastEnumeration>)collection;
+
+///Returns a new vector where the object at a specified index has been replaced with a specified object.
+- (STVector *)vectorByReplacingObjectAtIndex:(NSUInteger)index withObject:(id)object;
+
+///Returns a new vector containing the objects of the receiver within a specified range.
+///
+///The sub-vector shares the receiver's storage, and is created in constant time. Adding objects
+///to a sub-vector that does not extend to the end of the receiver copies the sub-vector first.
+- (STVector *)subvectorWithRange:(NSRange)range;
+
+#pragma mark - Identity
+
+///Returns whether or not the receiver contains the same objects as a specified vector.
+///
+///Vectors are never equal to arrays or lists, so that equality is symmetric. The hash of
+///a vector is computed from its objects the first time it is needed, and is then cached,
+///so objects in a vector that is used as a key should not be modified.
+- (BOOL)isEqualTo:(id)object;
+
+@end
+
+#pragma mark -
+
+///The STVectorBuilder class is used to efficiently create vectors by adding objects one at a time.
+///
+///A builder may continue to be used after requesting a vector from it. Vectors requested
+///from a builder are never affected by changes made to the builder afterwards.
+@interface STVectorBuilder : NSObject
+{
+	STVectorNode *mRoot;
+	STVectorNode *mTail;
+	NSUInteger mShift;
+	NSUInteger mCount;
+	
+	//Nodes owned by the builder are marked with this token, and may be modified in place.
+	id mEditToken;
+}
+
+///Initialize the receiver with the contents of a specified vector. The vector's storage
+///is shared with the receiver until the receiver modifies it.
+- (id)initWithVector:(STVector *)vector;
+
+#pragma mark - Properties
+
+///The number of objects in the receiver.
+@property (readonly) NSUInteger count;
+
+#pragma mark - Modification
+
+///Add an object to the end of the receiver. May not be nil.
+- (void)addObject:(id)object;
+
+///Add the objects of a specified array, list, or other enumerable collection to the end of the receiver.
+- (void)addObjectsFromCollection:(id <NSFastEnumeration>)collection;
+
+///Replace the object at a specified index in the receiver with a specified object.
+- (void)replaceObjectAtIndex:(NSUInteger)index withObject:(id)object;
+
+#pragma mark - Vectors
+
+///Returns a vector containing the objects that have been added to the receiver.
+- (STVector *)vector;
+
+@end
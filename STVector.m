@@ -0,0 +1,646 @@
+//
+//  STVector.m
+//  stein
+//
+//  Created by the Stein contributors on 2026/10/19.
+//  Copyright 2026 Stein Language. All rights reserved.
+//
+
+#import "STVector.h"
+#import "STList.h"
+#import "NSObject+SteinTools.h"
+#import "STOutput.h"
+
+#define NODE_BITS	5
+#define NODE_WIDTH	(1 << NODE_BITS)
+#define NODE_MASK	(NODE_WIDTH - 1)
+
+#pragma mark Nodes
+
+///The STVectorNode class represents a single node in the tree of a vector.
+@interface STVectorNode : NSObject
+{
+@public
+	id mEditToken;
+	__strong id mSlots[NODE_WIDTH];
+}
+
+@end
+
+@implementation STVectorNode
+
+@end
+
+#pragma mark - Tree Operations
+
+///Returns the index of the first object stored in the tail of a tree with a specified number of objects.
+ST_INLINE NSUInteger TailOffset(NSUInteger count)
+{
+	return (count < NODE_WIDTH)? 0 : ((count - 1) >> NODE_BITS) << NODE_BITS;
+}
+
+///Returns a node that may be modified by the owner of a specified edit token,
+///copying the node if it is not already owned by that token.
+static STVectorNode *EditableNode(STVectorNode *node, id editToken)
+{
+	if(editToken && node && node->mEditToken == editToken)
+		return node;
+	
+	STVectorNode *editableNode = [STVectorNode new];
+	editableNode->mEditToken = editToken;
+	if(node)
+	{
+		for (NSUInteger index = 0; index < NODE_WIDTH; index++)
+			editableNode->mSlots[index] = node->mSlots[index];
+	}
+	
+	return editableNode;
+}
+
+///Returns the leaf node containing the object at a specified index of a tree.
+static STVectorNode *LeafForIndex(STVectorNode *root, STVectorNode *tail, NSUInteger shift, NSUInteger count, NSUInteger index)
+{
+	if(index >= TailOffset(count))
+		return tail;
+	
+	STVectorNode *node = root;
+	for (NSUInteger level = shift; level > 0; level -= NODE_BITS)
+		node = node->mSlots[(index >> level) & NODE_MASK];
+	
+	return node;
+}
+
+///Returns a chain of nodes that leads from a specified level down to a specified leaf.
+static STVectorNode *NewPath(id editToken, NSUInteger level, STVectorNode *leaf)
+{
+	if(level == 0)
+		return leaf;
+	
+	STVectorNode *node = EditableNode(nil, editToken);
+	node->mSlots[0] = NewPath(editToken, level - NODE_BITS, leaf);
+	return node;
+}
+
+///Returns a copy of a specified node with a full tail inserted as the last leaf beneath it.
+static STVectorNode *PushTail(id editToken, NSUInteger count, NSUInteger level, STVectorNode *parent, STVectorNode *tail)
+{
+	STVectorNode *node = EditableNode(parent, editToken);
+	NSUInteger subindex = ((count - 1) >> level) & NODE_MASK;
+	if(level == NODE_BITS)
+	{
+		node->mSlots[subindex] = tail;
+	}
+	else
+	{
+		STVectorNode *child = parent->mSlots[subindex];
+		node->mSlots[subindex] = child? PushTail(editToken, count, level - NODE_BITS, child, tail) : NewPath(editToken, level - NODE_BITS, tail);
+	}
+	
+	return node;
+}
+
+///Returns a copy of a specified node where the object at a specified index has been replaced.
+static STVectorNode *ReplaceInNode(id editToken, NSUInteger level, STVectorNode *node, NSUInteger index, id object)
+{
+	STVectorNode *newNode = EditableNode(node, editToken);
+	if(level == 0)
+	{
+		newNode->mSlots[index & NODE_MASK] = object;
+	}
+	else
+	{
+		NSUInteger subindex = (index >> level) & NODE_MASK;
+		newNode->mSlots[subindex] = ReplaceInNode(editToken, level - NODE_BITS, node->mSlots[subindex], index, object);
+	}
+	
+	return newNode;
+}
+
+///Adds an object to the end of a tree, modifying the nodes owned by a specified edit token in place.
+static void PushObject(id editToken, STVectorNode *__strong *ioRoot, STVectorNode *__strong *ioTail, NSUInteger *ioShift, NSUInteger *ioCount, id object)
+{
+	NSUInteger count = *ioCount;
+	NSUInteger countInTail = count - TailOffset(count);
+	if(countInTail < NODE_WIDTH)
+	{
+		STVectorNode *tail = EditableNode(*ioTail, editToken);
+		tail->mSlots[countInTail] = object;
+		*ioTail = tail;
+	}
+	else
+	{
+		//The tail is full, so it becomes the last leaf of the tree.
+		NSUInteger shift = *ioShift;
+		if((count >> NODE_BITS) > (1 << shift))
+		{
+			STVectorNode *root = EditableNode(nil, editToken);
+			root->mSlots[0] = *ioRoot;
+			root->mSlots[1] = NewPath(editToken, shift, *ioTail);
+			*ioRoot = root;
+			*ioShift = shift + NODE_BITS;
+		}
+		else
+		{
+			*ioRoot = PushTail(editToken, count, shift, *ioRoot, *ioTail);
+		}
+		
+		STVectorNode *tail = EditableNode(nil, editToken);
+		tail->mSlots[0] = object;
+		*ioTail = tail;
+	}
+	
+	*ioCount = count + 1;
+}
+
+///Replaces the object at a specified index of a tree, modifying the nodes owned by a specified edit token in place.
+static void ReplaceObject(id editToken, STVectorNode *__strong *ioRoot, STVectorNode *__strong *ioTail, NSUInteger shift, NSUInteger count, NSUInteger index, id object)
+{
+	if(index >= TailOffset(count))
+	{
+		STVectorNode *tail = EditableNode(*ioTail, editToken);
+		tail->mSlots[index & NODE_MASK] = object;
+		*ioTail = tail;
+	}
+	else
+	{
+		*ioRoot = ReplaceInNode(editToken, shift, *ioRoot, index, object);
+	}
+}
+
+#pragma mark -
+
+@interface STVector ()
+
+///Initialize the receiver with a window onto a specified tree.
+- (id)initWithRoot:(STVectorNode *)root tail:(STVectorNode *)tail shift:(NSUInteger)shift treeCount:(NSUInteger)treeCount offset:(NSUInteger)offset count:(NSUInteger)count;
+
+///Provides the receiver's tree if every object in it is visible to the receiver, returning NO otherwise.
+- (BOOL)getRoot:(STVectorNode *__strong *)outRoot tail:(STVectorNode *__strong *)outTail shift:(NSUInteger *)outShift count:(NSUInteger *)outCount;
+
+@end
+
+@implementation STVector
+
+#pragma mark Creation
+
++ (STVector *)vector
+{
+	static STVector *emptyVector = nil;
+	static dispatch_once_t predicate;
+	dispatch_once(&predicate, ^{
+		emptyVector = [self new];
+	});
+	
+	return emptyVector;
+}
+
++ (STVector *)vectorWithObjectsFromCollection:(id <NSFastEnumeration>)collection
+{
+	NSParameterAssert(collection);
+	
+	if([(id)collection isKindOfClass:[STVector class]])
+		return (STVector *)collection;
+	
+	STVectorBuilder *builder = [STVectorBuilder new];
+	[builder addObjectsFromCollection:collection];
+	return [builder vector];
+}
+
+- (id)init
+{
+	return [self initWithRoot:[STVectorNode new] tail:[STVectorNode new] shift:NODE_BITS treeCount:0 offset:0 count:0];
+}
+
+- (id)initWithRoot:(STVectorNode *)root tail:(STVectorNode *)tail shift:(NSUInteger)shift treeCount:(NSUInteger)treeCount offset:(NSUInteger)offset count:(NSUInteger)count
+{
+	if((self = [super init]))
+	{
+		mRoot = root;
+		mTail = tail;
+		mShift = shift;
+		mTreeCount = treeCount;
+		
+		mOffset = offset;
+		mCount = count;
+	}
+	
+	return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	return self;
+}
+
+#pragma mark - Accessing Objects
+
+@synthesize count = mCount;
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+	if(index >= mCount)
+		[NSException raise:NSRangeException format:@"Index %ld beyond bounds {0, %ld}", index, mCount];
+	
+	NSUInteger treeIndex = mOffset + index;
+	return LeafForIndex(mRoot, mTail, mShift, mTreeCount, treeIndex)->mSlots[treeIndex & NODE_MASK];
+}
+
+- (id)firstObject
+{
+	return (mCount > 0)? [self objectAtIndex:0] : nil;
+}
+
+- (id)lastObject
+{
+	return (mCount > 0)? [self objectAtIndex:mCount - 1] : nil;
+}
+
+- (NSArray *)allObjects
+{
+	NSMutableArray *allObjects = [NSMutableArray arrayWithCapacity:mCount];
+	for (id object in self)
+		[allObjects addObject:object];
+	
+	return [allObjects copy];
+}
+
+- (BOOL)getRoot:(STVectorNode *__strong *)outRoot tail:(STVectorNode *__strong *)outTail shift:(NSUInteger *)outShift count:(NSUInteger *)outCount
+{
+	if(mOffset != 0 || mCount != mTreeCount)
+		return NO;
+	
+	*outRoot = mRoot;
+	*outTail = mTail;
+	*outShift = mShift;
+	*outCount = mTreeCount;
+	
+	return YES;
+}
+
+#pragma mark - Deriving Vectors
+
+///Returns whether or not objects may be added to the receiver by adding them to its tree.
+- (BOOL)windowExtendsToEndOfTree
+{
+	return (mOffset + mCount == mTreeCount);
+}
+
+- (STVector *)vectorByAddingObject:(id)object
+{
+	NSParameterAssert(object);
+	
+	if(![self windowExtendsToEndOfTree])
+	{
+		STVectorBuilder *builder = [[STVectorBuilder alloc] initWithVector:self];
+		[builder addObject:object];
+		return [builder vector];
+	}
+	
+	STVectorNode *root = mRoot, *tail = mTail;
+	NSUInteger shift = mShift, treeCount = mTreeCount;
+	PushObject(nil, &root, &tail, &shift, &treeCount, object);
+	
+	return [[STVector alloc] initWithRoot:root tail:tail shift:shift treeCount:treeCount offset:mOffset count:mCount + 1];
+}
+
+- (STVector *)vectorByAddingObjectsFromCollection:(id <NSFastEnumeration>)collection
+{
+	NSParameterAssert(collection);
+	
+	STVectorBuilder *builder = [[STVectorBuilder alloc] initWithVector:self];
+	[builder addObjectsFromCollection:collection];
+	return [builder vector];
+}
+
+- (STVector *)vectorByReplacingObjectAtIndex:(NSUInteger)index withObject:(id)object
+{
+	NSParameterAssert(object);
+	
+	if(index >= mCount)
+		[NSException raise:NSRangeException format:@"Index %ld beyond bounds {0, %ld}", index, mCount];
+	
+	STVectorNode *root = mRoot, *tail = mTail;
+	ReplaceObject(nil, &root, &tail, mShift, mTreeCount, mOffset + index, object);
+	
+	return [[STVector alloc] initWithRoot:root tail:tail shift:mShift treeCount:mTreeCount offset:mOffset count:mCount];
+}
+
+- (STVector *)subvectorWithRange:(NSRange)range
+{
+	if(NSMaxRange(range) > mCount)
+		[NSException raise:NSRangeException format:@"Range %@ beyond bounds {0, %ld}", NSStringFromRange(range), mCount];
+	
+	if(range.length == mCount)
+		return self;
+	
+	return [[STVector alloc] initWithRoot:mRoot tail:mTail shift:mShift treeCount:mTreeCount offset:mOffset + range.location count:range.length];
+}
+
+#pragma mark - Identity
+
+- (BOOL)isEqualTo:(id)object
+{
+	if(object == self)
+		return YES;
+	
+	//Vectors are only equal to other vectors, as arrays and lists do not consider themselves equal to vectors.
+	if(![object isKindOfClass:[STVector class]])
+		return NO;
+	
+	STVector *vector = object;
+	if(vector->mCount != mCount)
+		return NO;
+	
+	if(mHash != 0 && vector->mHash != 0 && mHash != vector->mHash)
+		return NO;
+	
+	NSUInteger index = 0;
+	for (id otherObject in vector)
+	{
+		if(![[self objectAtIndex:index++] isEqual:otherObject])
+			return NO;
+	}
+	
+	return YES;
+}
+
+- (BOOL)isEqual:(id)object
+{
+	return [self isEqualTo:object];
+}
+
+- (NSUInteger)hash
+{
+	//Vectors are immutable, so their hash is computed from their objects once.
+	//Computing it twice on separate threads is harmless, as both yield the same value.
+	NSUInteger hash = mHash;
+	if(hash == 0)
+	{
+		hash = mCount;
+		for (id object in self)
+			hash = hash * 31 + [object hash];
+		
+		if(hash == 0)
+			hash = 1;
+		
+		mHash = hash;
+	}
+	
+	return hash;
+}
+
+- (NSString *)description
+{
+	return [NSString stringWithFormat:@"<%@#%p %@>", [self className], self, [[self allObjects] componentsJoinedByString:@" "]];
+}
+
+- (NSString *)prettyDescription
+{
+	return [STOutput prettyDescriptionOfObject:self];
+}
+
+- (void)writePrettyDescriptionToOutput:(STOutput *)output
+{
+	[output writeString:@"(vector"];
+	
+	for (id object in self)
+	{
+		[output writeString:@" "];
+		[object writePrettyDescriptionToOutput:output];
+	}
+	
+	[output writeString:@")"];
+}
+
+#pragma mark - Operators
+
+- (STVector *)operatorAdd:(id)rightOperand
+{
+	return [self vectorByAddingObjectsFromCollection:rightOperand];
+}
+
+- (STVector *)operatorSubtract:(id)rightOperand
+{
+	NSMutableSet *objectsToRemove = [NSMutableSet set];
+	for (id object in rightOperand)
+		[objectsToRemove addObject:object];
+	
+	
+	STVectorBuilder *builder = [STVectorBuilder new];
+	for (id object in self)
+	{
+		if(![objectsToRemove containsObject:object])
+			[builder addObject:object];
+	}
+	
+	return [builder vector];
+}
+
+#pragma mark - Enumeration
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)len
+{
+	//Objects are enumerated directly out of each leaf of the tree.
+	NSUInteger position = state->state;
+	if(position >= mCount)
+		return 0;
+	
+	NSUInteger treeIndex = mOffset + position;
+	STVectorNode *leaf = LeafForIndex(mRoot, mTail, mShift, mTreeCount, treeIndex);
+	NSUInteger batchCount = MIN(NODE_WIDTH - (treeIndex & NODE_MASK), mCount - position);
+	
+	state->state = position + batchCount;
+	state->itemsPtr = (__unsafe_unretained id *)(void *)&leaf->mSlots[treeIndex & NODE_MASK];
+	state->mutationsPtr = &state->extra[0];
+	
+	return batchCount;
+}
+
+#pragma mark -
+
+- (id)foreach:(id <STFunction>)function
+{
+	for (id object in self)
+	{
+		@try
+		{
+			STFunctionApply(function, [[STList alloc] initWithObject:object]);
+		}
+		@catch (STBreakException *e)
+		{
+			break;
+		}
+		@catch (STContinueException *e)
+		{
+			continue;
+		}
+	}
+	
+	return self;
+}
+
+- (id)map:(id <STFunction>)function
+{
+	STVectorBuilder *mappedObjects = [STVectorBuilder new];
+	
+	for (id object in self)
+	{
+		@try
+		{
+			id mappedObject = STFunctionApply(function, [[STList alloc] initWithObject:object]);
+			if(!mappedObject)
+				continue;
+			
+			[mappedObjects addObject:mappedObject];
+		}
+		@catch (STBreakException *e)
+		{
+			break;
+		}
+		@catch (STContinueException *e)
+		{
+			continue;
+		}
+	}
+	
+	return [mappedObjects vector];
+}
+
+- (id)filter:(id <STFunction>)function
+{
+	STVectorBuilder *filteredObjects = [STVectorBuilder new];
+	
+	for (id object in self)
+	{
+		@try
+		{
+			if(STIsTrue(STFunctionApply(function, [[STList alloc] initWithObject:object])))
+				[filteredObjects addObject:object];
+		}
+		@catch (STBreakException *e)
+		{
+			break;
+		}
+		@catch (STContinueException *e)
+		{
+			continue;
+		}
+	}
+	
+	return [filteredObjects vector];
+}
+
+#pragma mark - Aggregation
+
+- (id)reduce:(id <STFunction>)function initial:(id)initial
+{
+	return STEnumerableReduce(self, function, initial);
+}
+
+- (id)sum
+{
+	return STEnumerableSum(self);
+}
+
+- (id)min
+{
+	return STEnumerableMinimum(self);
+}
+
+- (id)max
+{
+	return STEnumerableMaximum(self);
+}
+
+- (NSUInteger)count:(id <STFunction>)function
+{
+	return STEnumerableCount(self, function);
+}
+
+- (NSDictionary *)groupBy:(id <STFunction>)function
+{
+	NSMutableDictionary *groups = [NSMutableDictionary dictionary];
+	[STEnumerableGroup(self, function) enumerateKeysAndObjectsUsingBlock:^(id key, NSArray *objects, BOOL *stop) {
+		[groups setObject:[STVector vectorWithObjectsFromCollection:objects] forKey:key];
+	}];
+	
+	return groups;
+}
+
+@end
+
+#pragma mark -
+
+@implementation STVectorBuilder
+
+#pragma mark Initialization
+
+- (id)init
+{
+	if((self = [super init]))
+	{
+		mEditToken = [NSObject new];
+		mRoot = EditableNode(nil, mEditToken);
+		mTail = EditableNode(nil, mEditToken);
+		mShift = NODE_BITS;
+	}
+	
+	return self;
+}
+
+- (id)initWithVector:(STVector *)vector
+{
+	NSParameterAssert(vector);
+	
+	if((self = [self init]))
+	{
+		//Objects outside of the vector's window cannot be shared.
+		if(![vector getRoot:&mRoot tail:&mTail shift:&mShift count:&mCount])
+			[self addObjectsFromCollection:vector];
+	}
+	
+	return self;
+}
+
+#pragma mark - Properties
+
+@synthesize count = mCount;
+
+#pragma mark - Modification
+
+- (void)addObject:(id)object
+{
+	NSParameterAssert(object);
+	
+	PushObject(mEditToken, &mRoot, &mTail, &mShift, &mCount, object);
+}
+
+- (void)addObjectsFromCollection:(id <NSFastEnumeration>)collection
+{
+	NSParameterAssert(collection);
+	
+	for (id object in collection)
+		PushObject(mEditToken, &mRoot, &mTail, &mShift, &mCount, object);
+}
+
+- (void)replaceObjectAtIndex:(NSUInteger)index withObject:(id)object
+{
+	NSParameterAssert(object);
+	
+	if(index >= mCount)
+		[NSException raise:NSRangeException format:@"Index %ld beyond bounds {0, %ld}", index, mCount];
+	
+	ReplaceObject(mEditToken, &mRoot, &mTail, mShift, mCount, index, object);
+}
+
+#pragma mark - Vectors
+
+- (STVector *)vector
+{
+	//The nodes given to the vector must never change, so the receiver gives up its ownership of them.
+	mEditToken = [NSObject new];
+	
+	return [[STVector alloc] initWithRoot:mRoot tail:mTail shift:mShift treeCount:mCount offset:0 count:mCount];
+}
+
+@end
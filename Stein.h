@@ -10,6 +10,18 @@
 #import <Stein/SteinDefines.h>
 #import <Stein/STParser.h>
 #import <Stein/STInterpreter.h>
+#import <Stein/STOptimizer.h>
+#import <Stein/STMemoizedFunction.h>
+#import <Stein/STMacro.h>
 #import <Stein/STBuiltInFunctions.h>
 #import <Stein/STList.h>
+#import <Stein/STVector.h>
+#import <Stein/STHashMap.h>
+#import <Stein/STLazySequence.h>
+#import <Stein/STAppendableCollections.h>
+#import <Stein/STRope.h>
+#import <Stein/STFileSequence.h>
+#import <Stein/STOutput.h>
+#import <Stein/STJSON.h>
+#import <Stein/STSerialization.h>
 #import <Stein/STSymbol.h>
@@ -44,6 +44,14 @@ ST_EXTERN NSString *const kSTSuperclassVariableName;
 ///used side by side in a program. Default value is NO.
 ST_EXTERN BOOL STUseUniqueRuntimeClassNames;
 
+///If set to YES then Stein will cache the results of closures that are pure and call
+///themselves recursively, such as naive implementations of fibonacci. Default value is NO.
+///
+///Purity is determined once, from the functions a closure's free names refer to when it is first
+///called. Scope is dynamic, so this option should only be enabled by programs that do not rebind
+///those names with `set!` afterwards.
+ST_EXTERN BOOL STMemoizePureRecursiveClosures;
+
 #pragma mark - Globals
 
 ///The result of this macro is the value used to represent 'null' in Stein.
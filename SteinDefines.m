@@ -21,6 +21,8 @@ NSString *const kSTSuperclassVariableName = @"$__superclass";
 
 BOOL STUseUniqueRuntimeClassNames = NO;
 
+BOOL STMemoizePureRecursiveClosures = NO;
+
 #pragma mark - Types
 
 @implementation STCreationLocation
@@ -21,6 +21,9 @@ typedef enum ProgramOptions {
     
     ///This field is set when the user has indicated they want to run the REPL loop in a background thread, while the files they specified run in the main thread.
 	kProgramOptionRunREPLInBackground = (1 << 2),
+    
+    ///This field is set when the user has indicated they want each file to be optimized before it is run.
+	kProgramOptionOptimize = (1 << 3),
 } ProgramOptions;
 
 ///Analyze the arguments given to the CLI when it was called from the command prompt, reporting the paths and options that were specified by the user in easily processable forms.
@@ -62,6 +65,11 @@ static void AnalyzeProgramArguments(int argc, const char *argv[], NSArray **outP
 					options |= kProgramOptionRunREPLInBackground;
 					break;
 					
+				case 'O':
+				case 'o':
+					options |= kProgramOptionOptimize;
+					break;
+					
 				default:
 					fprintf(stderr, "Unsupported option %s, ignoring.\n", arg);
 					break;
@@ -82,9 +90,21 @@ static void AnalyzeProgramArguments(int argc, const char *argv[], NSArray **outP
 ///Print the usage information for the Stein command line interface.
 static void Help()
 {
-	fprintf(stdout, "stein [-pr] [paths...]\n\n");
+	fprintf(stdout, "stein [-pro] [paths...]\n\n");
 	fprintf(stdout, "\t-p\tOnly parse the files, printing the compiled structure.\n");
 	fprintf(stdout, "\t-r\tRun the REPL on a background thread while the files are run on the main thread.\n");
+	fprintf(stdout, "\t-O\tOptimize the files before they are run. Combined with -p, prints the optimized structure.\n");
+}
+
+///Print the result of running or parsing a file, streaming its pretty description to standard output.
+static void PrintResultOfFile(NSString *path, id result)
+{
+	STOutput *output = [STOutput standardOutput];
+	[output lock];
+	[output writeFormat:@"%@ => ", path];
+	[output writePrettyDescriptionOfObject:result];
+	[output finishLine];
+	[output unlock];
 }
 
 #pragma mark -
@@ -120,11 +140,13 @@ int main (int argc, const char * argv[])
 		
 		NSError *error = nil;
 		STScope *globalScope = STBuiltInFunctionScope();
+		STOptimizer *optimizer = ST_FLAG_IS_SET(options, kProgramOptionOptimize)? [STOptimizer new] : nil;
 		for (NSString *path in paths)
 		{
 			NSString *fileContents = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:&error];
 			if(!fileContents)
 			{
+				[[STOutput standardOutput] flush];
 				fprintf(stderr, "Could not load file %s, skipping.\n", [path UTF8String]);
 				continue;
 			}
@@ -132,6 +154,8 @@ int main (int argc, const char * argv[])
 			@try
 			{
 				id expressions = STParseString(fileContents, path);
+				if(optimizer)
+					expressions = [optimizer optimizeExpressions:expressions inScope:globalScope];
 				
 				//
 				//	If we're in parse only mode, we simply print the
@@ -139,18 +163,19 @@ int main (int argc, const char * argv[])
 				//
 				if(ST_FLAG_IS_SET(options, kProgramOptionParseOnly))
 				{
-					fprintf(stdout, "%s => %s\n", [path UTF8String], [[expressions prettyDescription] UTF8String]);
+					PrintResultOfFile(path, expressions);
 				}
 				else
 				{
 					[globalScope setValue:path forVariableNamed:@"$file" searchParentScopes:NO];
 					
 					id result = STEvaluate(expressions, [STScope scopeWithParentScope:globalScope]);
-					fprintf(stdout, "%s => %s\n", [path UTF8String], [[result prettyDescription] UTF8String]);
+					PrintResultOfFile(path, result);
 				}
 			}
 			@catch (NSException *e)
 			{
+				[[STOutput standardOutput] flush];
 				fprintf(stderr, "Error in file %s: %s\n", [path UTF8String], [[e reason] UTF8String]);
 			}
 		}